@@ -1388,6 +1388,137 @@ extern DECLSPEC int SDLCALL SDL_LoadWAV_RW(SDL_RWops * src, SDL_bool freesrc,
 extern DECLSPEC int SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec * spec,
                                         Uint8 ** audio_buf, Uint32 * audio_len);
 
+/**
+ * The opaque handle of a WAVE file that is decoded while it is read.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWaveStream
+ */
+typedef struct SDL_WaveStream SDL_WaveStream;
+
+/**
+ * Open a WAVE file for decoding on demand.
+ *
+ * Unlike SDL_LoadWAV_RW(), this only reads the headers of the file. The
+ * audio data is read from `src` and decoded a block at a time as it is
+ * requested with SDL_ReadWaveStream() or by an audio stream that was set up
+ * with SDL_SetAudioStreamWaveSource(), so long files don't have to be kept
+ * in memory.
+ *
+ * The same formats, hints and decoded data formats as with SDL_LoadWAV_RW()
+ * apply. A file that turns out to be truncated while it is decoded ends
+ * early, or reports an error if `SDL_HINT_WAVE_TRUNCATION` is set to one of
+ * the strict modes.
+ *
+ * `src` must support seeking and must not be used by anything else while the
+ * WAVE stream is open.
+ *
+ * \param src The data source for the WAVE data
+ * \param freesrc If SDL_TRUE, calls SDL_RWclose() on `src` when the WAVE
+ *                stream is closed, or before returning if this function
+ *                fails
+ * \param spec A pointer to an SDL_AudioSpec that will be set to the format
+ *             of the decoded data on successful return
+ * \returns a new WAVE stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseWaveStream
+ * \sa SDL_ReadWaveStream
+ * \sa SDL_SeekWaveStream
+ * \sa SDL_SetAudioStreamWaveSource
+ */
+extern DECLSPEC SDL_WaveStream *SDLCALL SDL_OpenWaveStream(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec);
+
+/**
+ * Decode audio data from a WAVE stream.
+ *
+ * The data is in the format that SDL_OpenWaveStream() reported. `len` should
+ * be a multiple of the sample frame size if the WAVE stream is also used
+ * with SDL_SetAudioStreamWaveSource().
+ *
+ * \param wave the WAVE stream to decode from
+ * \param buf a buffer to fill with audio data
+ * \param len the maximum number of bytes to fill
+ * \returns the number of bytes decoded, 0 at the end of the data, or -1 on
+ *          error; call SDL_GetError() for more information.
+ *
+ * \threadsafety Do not use the same WAVE stream from multiple threads at
+ *               once.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWaveStream
+ * \sa SDL_SeekWaveStream
+ */
+extern DECLSPEC int SDLCALL SDL_ReadWaveStream(SDL_WaveStream *wave, void *buf, int len);
+
+/**
+ * Move the decoding position of a WAVE stream.
+ *
+ * ADPCM data can only be decoded from the start of a block, so seeking into
+ * the middle of a block decodes it right away.
+ *
+ * \param wave the WAVE stream to seek in
+ * \param frame the sample frame to continue decoding at, from 0 up to the
+ *              number of sample frames in the file
+ * \returns 0 on success or -1 on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety Do not use the same WAVE stream from multiple threads at
+ *               once.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWaveStream
+ * \sa SDL_ReadWaveStream
+ */
+extern DECLSPEC int SDLCALL SDL_SeekWaveStream(SDL_WaveStream *wave, Sint64 frame);
+
+/**
+ * Feed an audio stream from a WAVE stream on demand.
+ *
+ * This sets the input format of `stream` to the format of the WAVE data and
+ * sets a get callback (see SDL_SetAudioStreamGetCallback()) that decodes
+ * more of the file whenever `stream` runs low, for example when it is bound
+ * to an audio device. When the end of the data is reached, nothing more is
+ * added; use SDL_SeekWaveStream() from the stream's lock to loop.
+ *
+ * The callback runs with the lock of `stream` held, so lock the stream with
+ * SDL_LockAudioStream() before using `wave` from another thread. Set a NULL
+ * WAVE stream or destroy the audio stream before closing `wave`.
+ *
+ * \param stream the audio stream to feed
+ * \param wave the WAVE stream to decode from, or NULL to remove the callback
+ * \returns 0 on success or -1 on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWaveStream
+ * \sa SDL_SetAudioStreamGetCallback
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamWaveSource(SDL_AudioStream *stream, SDL_WaveStream *wave);
+
+/**
+ * Close a WAVE stream.
+ *
+ * \param wave the WAVE stream to close
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWaveStream
+ */
+extern DECLSPEC void SDLCALL SDL_CloseWaveStream(SDL_WaveStream *wave);
+
 
 
 #define SDL_MIX_MAXVOLUME 128
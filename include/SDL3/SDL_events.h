@@ -204,6 +204,9 @@ typedef enum
     SDL_EVENT_PEN_BUTTON_DOWN,            /**< Pressure-sensitive pen button pressed */
     SDL_EVENT_PEN_BUTTON_UP,              /**< Pressure-sensitive pen button released */
 
+    /* Asynchronous I/O events */
+    SDL_EVENT_ASYNC_IO_COMPLETE = 0x1400, /**< An asynchronous I/O request without a callback has finished */
+
     /* Render events */
     SDL_EVENT_RENDER_TARGETS_RESET = 0x2000, /**< The render targets have been reset and their contents need to be updated */
     SDL_EVENT_RENDER_DEVICE_RESET, /**< The device has been reset and all textures need to be recreated */
@@ -620,6 +623,19 @@ typedef struct SDL_SensorEvent
     Uint64 sensor_timestamp; /**< The timestamp of the sensor reading in nanoseconds, not necessarily synchronized with the system clock */
 } SDL_SensorEvent;
 
+/**
+ *  Asynchronous I/O event structure (event.asyncio.*)
+ *
+ *  The result of the request can be retrieved with SDL_GetAsyncIOResult().
+ */
+typedef struct SDL_AsyncIOEvent
+{
+    Uint32 type;        /**< ::SDL_EVENT_ASYNC_IO_COMPLETE */
+    Uint64 timestamp;   /**< In nanoseconds, populated using SDL_GetTicksNS() */
+    struct SDL_AsyncIOQueue *queue; /**< The queue the request was submitted to */
+    void *userdata;     /**< The userdata passed with the request */
+} SDL_AsyncIOEvent;
+
 /**
  *  The "quit requested" event
  */
@@ -670,6 +686,7 @@ typedef union SDL_Event
     SDL_GamepadSensorEvent gsensor;         /**< Gamepad sensor event data */
     SDL_AudioDeviceEvent adevice;           /**< Audio device event data */
     SDL_SensorEvent sensor;                 /**< Sensor event data */
+    SDL_AsyncIOEvent asyncio;               /**< Asynchronous I/O event data */
     SDL_QuitEvent quit;                     /**< Quit request event data */
     SDL_UserEvent user;                     /**< Custom event data */
     SDL_TouchFingerEvent tfinger;           /**< Touch finger event data */
@@ -901,6 +918,47 @@ extern DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_PollEvent(SDL_Event *event);
 
+/**
+ * Poll for several currently pending events at once.
+ *
+ * This pumps the event loop at most once and then removes up to `numevents`
+ * events from the queue in a single pass, storing them in the array pointed
+ * to by `events`. It returns the same events, in the same order, as calling
+ * SDL_PollEvent() repeatedly, but is much cheaper when a lot of input is
+ * arriving, e.g. from high rate mice, pens or gamepad sensors.
+ *
+ * Like SDL_PollEvent(), this stops at the end of the current poll cycle, so
+ * a loop calling this until it returns 0 will not spin forever on events
+ * that are continuously being added:
+ *
+ * ```c
+ * SDL_Event events[64];
+ * int i, count;
+ *
+ * while ((count = SDL_PollEvents(events, SDL_arraysize(events))) > 0) {
+ *     for (i = 0; i < count; ++i) {
+ *         // decide what to do with this event.
+ *     }
+ * }
+ * ```
+ *
+ * As this function may implicitly call SDL_PumpEvents(), you can only call
+ * this function in the thread that set the video mode.
+ *
+ * \param events an array of SDL_Event structures to be filled with events
+ *               from the queue
+ * \param numevents the maximum number of events to retrieve
+ * \returns the number of events stored in `events`, which is 0 if there are
+ *          none available, or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_PollEvent
+ */
+extern DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event *events, int numevents);
+
 /**
  * Wait indefinitely for the next available event.
  *
@@ -985,6 +1043,23 @@ extern DECLSPEC SDL_bool SDLCALL SDL_WaitEventTimeout(SDL_Event *event, Sint32 t
  */
 extern DECLSPEC int SDLCALL SDL_PushEvent(SDL_Event *event);
 
+/**
+ * Get the number of events that have been merged into queued events.
+ *
+ * When SDL_HINT_EVENT_COALESCING is enabled, high frequency motion, axis and
+ * sensor events may be merged into an unread event instead of being added to
+ * the queue. This returns the total number of events that have been merged
+ * that way, so applications can tell how much input history was dropped. Use
+ * SDL_AddEventWatch() to see every event as it is added.
+ *
+ * \returns the number of merged events.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCING
+ */
+extern DECLSPEC int SDLCALL SDL_GetNumCoalescedEvents(void);
+
 /**
  * A function pointer used for callbacks that watch the event queue.
  *
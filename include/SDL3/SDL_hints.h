@@ -409,6 +409,25 @@ extern "C" {
  */
 #define SDL_HINT_ENABLE_SCREEN_KEYBOARD "SDL_ENABLE_SCREEN_KEYBOARD"
 
+/**
+ *  A variable controlling whether high frequency events are merged in the event queue.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every event gets its own entry in the queue (the default)
+ *    "1"       - Motion, axis and sensor events are merged into unread ones
+ *
+ *  When enabled, an SDL_EVENT_MOUSE_MOTION, SDL_EVENT_PEN_MOTION,
+ *  SDL_EVENT_GAMEPAD_SENSOR_UPDATE or SDL_EVENT_JOYSTICK_AXIS_MOTION event is
+ *  merged into the most recent unread event of the same type from the same
+ *  device (and axis or sensor), if no other kind of event was queued after it.
+ *  Relative mouse motion is summed, all other values and the timestamp are
+ *  taken from the newest event.
+ *
+ *  Event watchers still see every event, and the number of merged events is
+ *  available with SDL_GetNumCoalescedEvents().
+ */
+#define SDL_HINT_EVENT_COALESCING   "SDL_EVENT_COALESCING"
+
 /**
  *  A variable controlling verbosity of the logging of SDL events pushed onto the internal queue.
  *
@@ -1282,6 +1301,33 @@ extern "C" {
   */
 #define SDL_HINT_LINUX_JOYSTICK_DEADZONES "SDL_LINUX_JOYSTICK_DEADZONES"
 
+/**
+ *  A variable controlling whether SDL records contention statistics for locks.
+ *
+ *  When enabled, mutexes, read/write locks and spinlocks record how often
+ *  they are taken, how often a thread had to wait, how long threads waited
+ *  and the longest time they were held. See SDL_GetLockStats().
+ *
+ *  Mutexes and read/write locks are currently only profiled on platforms
+ *  using pthreads.
+ *
+ *  Locks created inside SDL are named after the source file and line that
+ *  creates them. The application's mutexes and read/write locks are grouped
+ *  by the code that calls SDL_CreateMutex() or SDL_CreateRWLock(), and
+ *  spinlocks by the code that calls SDL_AtomicLock(). When SDL is built
+ *  without optimizations, calls from the application go through the dynamic
+ *  API trampoline, so all the application's locks of one kind share a site,
+ *  named after the trampoline (for example "SDL_CreateMutex+0xd").
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Don't profile locks (the default)
+ *    "1"       - Profile locks
+ *
+ *  This hint is checked when SDL creates its first lock, so it should be set
+ *  in the environment before the application starts.
+ */
+#define SDL_HINT_LOCK_PROFILING "SDL_LOCK_PROFILING"
+
 /**
 *  When set don't force the SDL app to become a foreground process
 *
@@ -1748,6 +1794,37 @@ extern "C" {
  */
 #define SDL_HINT_SCREENSAVER_INHIBIT_ACTIVITY_NAME "SDL_SCREENSAVER_INHIBIT_ACTIVITY_NAME"
 
+/**
+ *  A variable controlling whether large software blits are split across threads.
+ *
+ *  Blits that cover at least a few hundred thousand pixels without scaling are
+ *  split into horizontal bands, which are run in parallel on the default job
+ *  pool (see SDL_ParallelFor()), with the calling thread taking one band.
+ *  The call still doesn't return until the whole blit is done.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use one band per CPU core, as reported by SDL_GetCPUCount(), at most 16
+ *    "1"       - Run all blits on the calling thread (the default)
+ *    "N"       - Use up to N bands, at most 16, each of which can run on its own thread
+ *
+ *  This uses the same values as SDL_HINT_WAVE_DECODE_THREADS.
+ */
+#define SDL_HINT_SURFACE_BLIT_THREADS "SDL_SURFACE_BLIT_THREADS"
+
+/**
+ *  A variable controlling whether SDL_FillSurfaceRects() merges overlapping rectangles.
+ *
+ *  When enabled, the rectangles passed to a single SDL_FillSurfaceRects() call
+ *  are split into horizontal bands and merged, so every covered pixel is written
+ *  exactly once. This helps with many heavily overlapping rectangles, but needs
+ *  temporary memory and sorting, so it's slower for small or disjoint sets.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Fill each rectangle in turn (the default)
+ *    "1"       - Merge the rectangles before filling them
+ */
+#define SDL_HINT_SURFACE_FILL_COALESCING "SDL_SURFACE_FILL_COALESCING"
+
 /**
  *  Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as realtime.
  *
@@ -1814,6 +1891,20 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ *  A variable that controls how early timers may fire, in microseconds.
+ *
+ *  When the timer thread wakes up to dispatch a timer, any other timers that
+ *  are due within this window are dispatched along with it instead of waking
+ *  up again for each of them. A timer fires at most once per wakeup. This
+ *  reduces the number of wakeups when many timers are active, at the cost of
+ *  timers firing up to this much earlier than scheduled.
+ *
+ *  The default value is "0", timers are never dispatched early. This hint
+ *  may be set at any time.
+ */
+#define SDL_HINT_TIMER_SLACK "SDL_TIMER_SLACK"
+
 /**
  *  A variable controlling whether touch events should generate synthetic mouse events
  *
@@ -2097,6 +2188,24 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_X11_XRANDR           "SDL_VIDEO_X11_XRANDR"
 
+/**
+ *  Controls how many threads decode a big ADPCM WAVE file.
+ *
+ *  The blocks of a Microsoft or IMA ADPCM file are independent, so
+ *  SDL_LoadWAV_RW() splits files with many blocks into runs that are decoded
+ *  in parallel on the default job pool (see SDL_ParallelFor()). Small files
+ *  are always decoded on the calling thread.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "0"  - Use up to one thread per CPU core, as reported by SDL_GetCPUCount(), at most 8 (default)
+ *    "1"  - Decode on the calling thread only
+ *    "N"  - Use up to N threads, at most 8
+ *
+ *  This uses the same values as SDL_HINT_SURFACE_BLIT_THREADS.
+ */
+#define SDL_HINT_WAVE_DECODE_THREADS   "SDL_WAVE_DECODE_THREADS"
+
 /**
  *  Controls how the fact chunk affects the loading of a WAVE file.
  *
@@ -769,6 +769,91 @@ extern DECLSPEC int SDLCALL SDL_WaitConditionTimeout(SDL_Condition *cond,
 /* @} *//* Condition variable functions */
 
 
+/**
+ *  \name Lock profiling functions
+ *
+ *  These report contention statistics collected when SDL_HINT_LOCK_PROFILING
+ *  is enabled.
+ */
+/* @{ */
+
+/**
+ * The kinds of lock that can be profiled.
+ *
+ * \since This enum is available since SDL 3.0.0.
+ */
+typedef enum
+{
+    SDL_LOCK_TYPE_MUTEX,
+    SDL_LOCK_TYPE_RWLOCK,
+    SDL_LOCK_TYPE_SPINLOCK
+} SDL_LockType;
+
+/**
+ * Statistics recorded for a lock, or for all the locks created at one place.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetLockStats
+ */
+typedef struct SDL_LockStats
+{
+    SDL_LockType type;      /**< The kind of lock */
+    const char *name;       /**< Where mutexes and read/write locks were created, or where spinlocks were taken */
+    Uint64 acquisitions;    /**< The number of times the lock was taken */
+    Uint64 contended;       /**< The number of times a thread had to wait for the lock */
+    Uint64 wait_ns;         /**< The total time threads spent waiting for the lock, in nanoseconds */
+    Uint64 max_hold_ns;     /**< The longest time the lock was held, in nanoseconds. Read locks aren't timed. */
+} SDL_LockStats;
+
+/**
+ * Get the contention statistics recorded for locks.
+ *
+ * Mutexes and read/write locks are grouped by the code that created them,
+ * and spinlocks by the code that takes them with SDL_AtomicLock(). Locks
+ * created inside SDL are named after their source file and line. Other sites
+ * are named after their symbol if it's exported, otherwise a module name and
+ * an offset that can be looked up with tools like addr2line.
+ *
+ * At most 1024 sites are recorded, SDL_LogLockStats() warns when locks were
+ * left out because of this.
+ *
+ * \param stats an array to fill in, may be NULL
+ * \param count the number of entries in `stats`
+ * \returns the total number of locks that have statistics, which may be more
+ *          than `count`.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LogLockStats
+ * \sa SDL_ResetLockStats
+ */
+extern DECLSPEC int SDLCALL SDL_GetLockStats(SDL_LockStats *stats, int count);
+
+/**
+ * Log the contention statistics recorded for locks.
+ *
+ * The most contended locks are logged first, in the SDL_LOG_CATEGORY_SYSTEM
+ * category.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetLockStats
+ */
+extern DECLSPEC void SDLCALL SDL_LogLockStats(void);
+
+/**
+ * Reset the contention statistics recorded for locks.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetLockStats
+ */
+extern DECLSPEC void SDLCALL SDL_ResetLockStats(void);
+
+/* @} *//* Lock profiling functions */
+
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
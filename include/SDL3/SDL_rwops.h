@@ -46,6 +46,7 @@ extern "C" {
 #define SDL_RWOPS_JNIFILE   3   /**< Android asset */
 #define SDL_RWOPS_MEMORY    4   /**< Memory stream */
 #define SDL_RWOPS_MEMORY_RO 5   /**< Read-Only memory stream */
+#define SDL_RWOPS_MAPPED    6   /**< Read-Only memory-mapped file */
 
 /* RWops status, set by a read or write operation */
 #define SDL_RWOPS_STATUS_READY          0   /**< Everything is ready */
@@ -55,6 +56,17 @@ extern "C" {
 #define SDL_RWOPS_STATUS_READONLY       4   /**< Tried to write a read-only buffer */
 #define SDL_RWOPS_STATUS_WRITEONLY      5   /**< Tried to read a write-only buffer */
 
+/**
+ * A buffer for vectored I/O with SDL_RWreadv() and SDL_RWwritev().
+ *
+ * \since This struct is available since SDL 3.0.0.
+ */
+typedef struct SDL_RWvec
+{
+    void *data;     /**< The start of the buffer */
+    size_t size;    /**< The size of the buffer in bytes */
+} SDL_RWvec;
+
 /**
  * This is the read/write operation structure -- very basic.
  */
@@ -91,6 +103,22 @@ typedef struct SDL_RWops
      */
     size_t (SDLCALL *write)(struct SDL_RWops *context, const void *ptr, size_t size);
 
+    /**
+     *  Read into each of the \c count buffers in \c vec in turn, stopping
+     *  at the end of the data stream. This is optional.
+     *
+     *  \return the total number of bytes read
+     */
+    size_t (SDLCALL *readv)(struct SDL_RWops *context, const SDL_RWvec *vec, int count);
+
+    /**
+     *  Write all \c count buffers in \c vec to the data stream in order.
+     *  This is optional.
+     *
+     *  \return the total number of bytes written
+     */
+    size_t (SDLCALL *writev)(struct SDL_RWops *context, const SDL_RWvec *vec, int count);
+
     /**
      *  Close and free an allocated SDL_RWops structure.
      *
@@ -101,6 +129,12 @@ typedef struct SDL_RWops
     Uint32 type;
     Uint32 status;
     SDL_PropertiesID props;
+
+    /**
+     *  Private read-ahead buffer, see SDL_SetRWBufferSize()
+     */
+    struct SDL_RWBuffer *buffer;
+
     union
     {
 #ifdef __ANDROID__
@@ -189,6 +223,12 @@ typedef struct SDL_RWops
  * effect. For example, "t" is sometimes appended to make explicit the file is
  * a text file.
  *
+ * An "m" character in a read-only mode, like "rbm", asks for the file to be
+ * memory-mapped where the platform supports it. Reads from a mapped file are
+ * a copy out of the page cache, and SDL_GetRWRange() can be used to access
+ * the file contents without copying them at all. If the file can't be
+ * mapped, it is opened normally.
+ *
  * This function supports Unicode filenames, but they must be encoded in UTF-8
  * format, regardless of the underlying operating system.
  *
@@ -347,6 +387,60 @@ extern DECLSPEC void SDLCALL SDL_DestroyRW(SDL_RWops *context);
  */
 extern DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRWProperties(SDL_RWops *context);
 
+/**
+ * Get a pointer to a range of bytes in a memory-backed SDL_RWops.
+ *
+ * This works for streams created with SDL_RWFromMem(), SDL_RWFromConstMem()
+ * and memory-mapped files opened with SDL_RWFromFile(), and lets parsers
+ * work on the data in place instead of reading a copy of it.
+ *
+ * The current read/write offset of the stream is not changed. The returned
+ * pointer is valid until the stream is closed, and must not be written to.
+ *
+ * \param context the SDL_RWops to access
+ * \param offset the offset of the first byte in the stream
+ * \param size the number of bytes that will be accessed
+ * \returns a pointer to the data at `offset`, or NULL if the stream isn't
+ *          backed by memory or the range is outside of it; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWFromConstMem
+ * \sa SDL_RWFromFile
+ * \sa SDL_RWFromMem
+ */
+extern DECLSPEC const void *SDLCALL SDL_GetRWRange(SDL_RWops *context, Sint64 offset, size_t size);
+
+/**
+ * Set the size of the read-ahead buffer for an SDL_RWops.
+ *
+ * When an SDL_RWops has a read-ahead buffer, SDL_RWread() fills it with
+ * large reads from the underlying stream, and small reads, like the ones
+ * made by SDL_ReadU16LE() and friends, are copied straight out of it without
+ * calling the stream's **read** method. This is useful for parsers that make
+ * many small reads from a stream that is slow to read from.
+ *
+ * SDL_RWseek() and SDL_RWtell() take the buffer into account, and seeks
+ * within the buffered data don't touch the underlying stream. Writing to the
+ * stream or changing the buffer size first seeks the underlying stream back
+ * to the logical read position.
+ *
+ * Streams start out without a read-ahead buffer. The buffer is freed when
+ * the stream is closed.
+ *
+ * \param context the SDL_RWops to change
+ * \param size the size of the buffer in bytes, or 0 to remove it
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWread
+ * \sa SDL_RWseek
+ */
+extern DECLSPEC int SDLCALL SDL_SetRWBufferSize(SDL_RWops *context, size_t size);
+
 #define SDL_RW_SEEK_SET 0       /**< Seek from the beginning of data */
 #define SDL_RW_SEEK_CUR 1       /**< Seek relative to current read point */
 #define SDL_RW_SEEK_END 2       /**< Seek relative to the end of data */
@@ -496,6 +590,49 @@ extern DECLSPEC size_t SDLCALL SDL_RWread(SDL_RWops *context, void *ptr, size_t
  */
 extern DECLSPEC size_t SDLCALL SDL_RWwrite(SDL_RWops *context, const void *ptr, size_t size);
 
+/**
+ * Read from a data source into several buffers.
+ *
+ * This reads into each buffer in `vec` in turn, as if SDL_RWread() were
+ * called for each of them, stopping at the end of the data. Streams with a
+ * **readv** method, like files on some platforms, can do this with a single
+ * system call.
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param vec an array of buffers to read into
+ * \param count the number of buffers in `vec`
+ * \returns the total number of bytes read, or 0 on end of file or other
+ *          error.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWread
+ * \sa SDL_RWwritev
+ */
+extern DECLSPEC size_t SDLCALL SDL_RWreadv(SDL_RWops *context, const SDL_RWvec *vec, int count);
+
+/**
+ * Write several buffers to an SDL_RWops data stream.
+ *
+ * This writes each buffer in `vec` in turn, as if SDL_RWwrite() were called
+ * for each of them. Streams with a **writev** method, like files on some
+ * platforms, can do this with a single system call, for example to write a
+ * header and its payload without copying them together first.
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param vec an array of buffers to write
+ * \param count the number of buffers in `vec`
+ * \returns the total number of bytes written, which is less than the total
+ *          size of the buffers on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWreadv
+ * \sa SDL_RWwrite
+ */
+extern DECLSPEC size_t SDLCALL SDL_RWwritev(SDL_RWops *context, const SDL_RWvec *vec, int count);
+
 /**
  * Print to an SDL_RWops data stream.
  *
@@ -588,6 +725,33 @@ extern DECLSPEC int SDLCALL SDL_RWclose(SDL_RWops *context);
  */
 extern DECLSPEC void *SDLCALL SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc);
 
+/**
+ * Load all the data from an SDL data stream into memory provided by the
+ * caller.
+ *
+ * This is like SDL_LoadFile_RW(), but doesn't allocate any memory, so the
+ * data can be loaded into an arena or a buffer that is reused. The data is
+ * not null terminated.
+ *
+ * If the stream has more data than fits in `buffer`, this function fails.
+ * When the size of the stream is known in advance, nothing is read and
+ * `datasize` is set to the size of the buffer that would be needed.
+ *
+ * \param src the SDL_RWops to read all available data from
+ * \param buffer the memory to read the data into
+ * \param buffersize the size of `buffer` in bytes
+ * \param datasize if not NULL, will store the number of bytes read
+ * \param freesrc if SDL_TRUE, calls SDL_RWclose() on `src` before returning,
+ *                even in the case of an error
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LoadFile_RW
+ */
+extern DECLSPEC int SDLCALL SDL_LoadFileInto_RW(SDL_RWops *src, void *buffer, size_t buffersize, size_t *datasize, SDL_bool freesrc);
+
 /**
  * Load all the data from a file path.
  *
@@ -1036,6 +1200,163 @@ extern DECLSPEC SDL_bool SDLCALL SDL_WriteS64BE(SDL_RWops *dst, Sint64 value);
 
 /* @} *//* Write endian functions */
 
+/**
+ *  \name Asynchronous I/O functions
+ *
+ *  Read requests are serviced by a pool of I/O threads, so many reads can
+ *  be in flight at once while the application does other work.
+ */
+/* @{ */
+
+/**
+ * An asynchronous I/O queue, created with SDL_CreateAsyncIOQueue().
+ */
+typedef struct SDL_AsyncIOQueue SDL_AsyncIOQueue;
+
+/**
+ * The outcome of an asynchronous I/O request.
+ */
+typedef enum
+{
+    SDL_ASYNCIO_COMPLETE,   /**< The request finished, `bytes` may be less than `requested` at the end of the stream */
+    SDL_ASYNCIO_FAILURE     /**< The request failed */
+} SDL_AsyncIOStatus;
+
+/**
+ * Information about a finished asynchronous I/O request.
+ */
+typedef struct SDL_AsyncIOResult
+{
+    SDL_AsyncIOStatus status;   /**< Whether the request succeeded */
+    SDL_RWops *src;             /**< The stream that was read */
+    Sint64 offset;              /**< The offset in the stream that was read from */
+    void *buffer;               /**< The memory that was read into */
+    size_t requested;           /**< The number of bytes that were requested */
+    size_t bytes;               /**< The number of bytes that were read */
+    void *userdata;             /**< The userdata passed with the request */
+} SDL_AsyncIOResult;
+
+/**
+ * The prototype for asynchronous I/O completion callbacks.
+ *
+ * This is called on an I/O thread as soon as a request finishes, so it
+ * should hand the result off quickly, for example by starting a job that
+ * decodes the data.
+ *
+ * \param result the result of the request, only valid during the callback
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_ReadAsync
+ */
+typedef void (SDLCALL *SDL_AsyncIOCallback)(const SDL_AsyncIOResult *result);
+
+/**
+ * Create a queue for asynchronous I/O requests.
+ *
+ * \param num_threads the number of I/O threads servicing the queue, or 0
+ *                    for a reasonable default
+ * \returns a new queue, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyAsyncIOQueue
+ * \sa SDL_ReadAsync
+ */
+extern DECLSPEC SDL_AsyncIOQueue *SDLCALL SDL_CreateAsyncIOQueue(int num_threads);
+
+/**
+ * Start reading a range of a stream in the background.
+ *
+ * Reads from files opened with SDL_RWFromFile(), memory streams and mapped
+ * files are made at the offset directly, and any number of them can be in
+ * flight for the same stream. They don't change the stream's read position,
+ * except on Windows, where a file should be seeked with SDL_RW_SEEK_SET
+ * before it is read directly again. Other streams are read with SDL_RWseek()
+ * and SDL_RWread(), one request at a time per stream, and must not be used
+ * by the application until their requests have finished.
+ *
+ * When the request finishes, `callback` is called on the I/O thread if it
+ * isn't NULL. Otherwise the result is kept for SDL_GetAsyncIOResult() or
+ * SDL_WaitAsyncIOResult(), and an SDL_EVENT_ASYNC_IO_COMPLETE event is sent
+ * if the event subsystem is running.
+ *
+ * `src` and `buffer` must stay valid until the request has finished.
+ *
+ * \param queue the queue to submit the request to
+ * \param src the stream to read from
+ * \param offset the offset in the stream to read from
+ * \param buffer the memory to read into
+ * \param size the number of bytes to read
+ * \param callback a function to call when the request finishes, may be NULL
+ * \param userdata a pointer that is passed back with the result
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_WaitAsyncIOResult
+ */
+extern DECLSPEC int SDLCALL SDL_ReadAsync(SDL_AsyncIOQueue *queue, SDL_RWops *src, Sint64 offset, void *buffer, size_t size, SDL_AsyncIOCallback callback, void *userdata);
+
+/**
+ * Get the result of a finished request without waiting.
+ *
+ * Only requests submitted without a callback have results here. Results are
+ * returned in the order the requests finished.
+ *
+ * \param queue the queue to check
+ * \param result filled in with the result of a finished request
+ * \returns SDL_TRUE if a result was returned, SDL_FALSE if none are ready.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ReadAsync
+ * \sa SDL_WaitAsyncIOResult
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOResult *result);
+
+/**
+ * Wait for the result of a request to be available.
+ *
+ * \param queue the queue to wait on
+ * \param result filled in with the result of a finished request
+ * \param timeoutMS the maximum number of milliseconds to wait, or -1 to wait
+ *                  as long as there are requests in flight
+ * \returns SDL_TRUE if a result was returned, or SDL_FALSE if the wait timed
+ *          out or no requests are in flight.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_ReadAsync
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOResult *result, Sint32 timeoutMS);
+
+/**
+ * Destroy an asynchronous I/O queue.
+ *
+ * This waits for all requests in flight to finish. Results that haven't
+ * been retrieved are discarded.
+ *
+ * \param queue the queue to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateAsyncIOQueue
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue);
+
+/* @} *//* Asynchronous I/O functions */
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -439,6 +439,163 @@ extern DECLSPEC int SDLCALL SDL_SetTLS(SDL_TLSID id, const void *value, void (SD
  */
 extern DECLSPEC void SDLCALL SDL_CleanupTLS(void);
 
+/**
+ *  \name Job pool functions
+ *
+ *  A job pool runs small pieces of work on a set of worker threads. Each
+ *  worker has its own queue of jobs, and idle workers steal jobs from busy
+ *  ones, so jobs that submit more jobs spread across the pool on their own.
+ */
+/* @{ */
+
+struct SDL_JobPool;
+typedef struct SDL_JobPool SDL_JobPool;
+
+/**
+ * The function run by a job.
+ *
+ * \param userdata what was passed as `userdata` to SDL_SubmitJob()
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ */
+typedef void (SDLCALL *SDL_JobFunction)(void *userdata);
+
+/**
+ * The function run for each range of a parallel loop.
+ *
+ * \param userdata what was passed as `userdata` to SDL_ParallelFor()
+ * \param start the first index of the range
+ * \param end one past the last index of the range
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ */
+typedef void (SDLCALL *SDL_ParallelForFunction)(void *userdata, int start, int end);
+
+/**
+ * A callback that is called after each job in a pool finishes.
+ *
+ * \param userdata what was passed as `userdata` to
+ *                 SDL_SetJobPoolProfileCallback()
+ * \param func the function run by the job
+ * \param jobdata the `userdata` the job was submitted with
+ * \param worker the index of the worker thread that ran the job, or -1 if it
+ *               was run by a thread outside the pool
+ * \param start the time the job started, from SDL_GetTicksNS()
+ * \param end the time the job finished, from SDL_GetTicksNS()
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ */
+typedef void (SDLCALL *SDL_JobProfileCallback)(void *userdata, SDL_JobFunction func, void *jobdata, int worker, Uint64 start, Uint64 end);
+
+/**
+ * Create a pool of worker threads to run jobs.
+ *
+ * Most code can pass NULL to the job functions instead, which uses a pool
+ * shared by SDL and the application that is created the first time it is
+ * needed and destroyed by SDL_Quit().
+ *
+ * \param num_threads the number of worker threads, or 0 to use one less than
+ *                    the number of CPU cores, since the thread waiting for
+ *                    jobs also runs them
+ * \returns a new job pool or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyJobPool
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC SDL_JobPool *SDLCALL SDL_CreateJobPool(int num_threads);
+
+/**
+ * Submit a job to a pool.
+ *
+ * If `counter` is not NULL, it is incremented now and decremented when the
+ * job has finished, so it can be passed to SDL_WaitJobs() to wait for a
+ * group of jobs. Jobs can submit other jobs and wait for them.
+ *
+ * If the pool has no worker threads the job is run before this function
+ * returns.
+ *
+ * \param pool the job pool, or NULL for the shared pool
+ * \param func the function to run
+ * \param userdata a pointer that is passed to `func`
+ * \param counter an optional counter tracking unfinished jobs
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_WaitJobs
+ */
+extern DECLSPEC int SDLCALL SDL_SubmitJob(SDL_JobPool *pool, SDL_JobFunction func, void *userdata, SDL_AtomicInt *counter);
+
+/**
+ * Wait for a group of jobs to finish.
+ *
+ * While waiting, the calling thread runs jobs from the pool.
+ *
+ * \param pool the job pool, or NULL for the shared pool
+ * \param counter the counter passed to SDL_SubmitJob()
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC int SDLCALL SDL_WaitJobs(SDL_JobPool *pool, SDL_AtomicInt *counter);
+
+/**
+ * Run a loop in parallel on a job pool.
+ *
+ * The indices from 0 to `count` - 1 are split into ranges of `grain`
+ * indices, and `func` is called once for each range. The calling thread
+ * takes part, and this function doesn't return until every range is done.
+ *
+ * \param pool the job pool, or NULL for the shared pool
+ * \param count the number of indices
+ * \param grain the number of indices in each range, or 0 to pick a size
+ *              based on the number of worker threads
+ * \param func the function to call for each range
+ * \param userdata a pointer that is passed to `func`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern DECLSPEC int SDLCALL SDL_ParallelFor(SDL_JobPool *pool, int count, int grain, SDL_ParallelForFunction func, void *userdata);
+
+/**
+ * Set a callback that is called after each job in a pool finishes.
+ *
+ * This should be set while no jobs are running in the pool.
+ *
+ * \param pool the job pool, or NULL for the shared pool
+ * \param callback the function to call, or NULL to stop profiling
+ * \param userdata a pointer that is passed to `callback`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern DECLSPEC int SDLCALL SDL_SetJobPoolProfileCallback(SDL_JobPool *pool, SDL_JobProfileCallback callback, void *userdata);
+
+/**
+ * Destroy a job pool.
+ *
+ * Jobs that were already submitted are run before the worker threads exit.
+ *
+ * \param pool the job pool to destroy
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateJobPool
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyJobPool(SDL_JobPool *pool);
+
+/* @} *//* Job pool functions */
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -169,6 +169,7 @@ typedef int SDL_TimerID;
  *
  * \since This function is available since SDL 3.0.0.
  *
+ * \sa SDL_AddTimerNS
  * \sa SDL_RemoveTimer
  */
 extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
@@ -176,7 +177,7 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
                                                  void *param);
 
 /**
- * Remove a timer created with SDL_AddTimer().
+ * Remove a timer created with SDL_AddTimer() or SDL_AddTimerNS().
  *
  * \param id the ID of the timer to remove
  * \returns SDL_TRUE if the timer is removed or SDL_FALSE if the timer wasn't
@@ -185,9 +186,68 @@ extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimer(Uint32 interval,
  * \since This function is available since SDL 3.0.0.
  *
  * \sa SDL_AddTimer
+ * \sa SDL_AddTimerNS
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
+/**
+ * Function prototype for the nanosecond timer callback function.
+ *
+ * The callback function is passed the current timer interval and returns
+ * the next timer interval, in nanoseconds. If the returned value is the same
+ * as the one passed in, the periodic alarm continues, otherwise a new alarm
+ * is scheduled. If the callback returns 0, the periodic alarm is cancelled.
+ *
+ * \param userdata an arbitrary pointer provided by the app through
+ *                 SDL_AddTimerNS, for its own use.
+ * \param timerID the current timer being processed
+ * \param interval the current callback time interval, in nanoseconds
+ * \returns the new callback time interval, or 0 to disable further runs of
+ *          the callback.
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddTimerNS
+ */
+typedef Uint64 (SDLCALL *SDL_NSTimerCallback)(void *userdata, SDL_TimerID timerID, Uint64 interval);
+
+/**
+ * Call a callback function at a future time, with nanosecond precision.
+ *
+ * If you use this function, you must pass `SDL_INIT_TIMER` to SDL_Init().
+ *
+ * The callback function is passed the user supplied parameter, the timer ID
+ * and the current timer interval, and should return the next timer interval.
+ * If the value returned from the callback is 0, the timer is canceled.
+ *
+ * The callback is run on a separate thread.
+ *
+ * Periodic timers are rescheduled relative to the time they were due rather
+ * than the time the callback ran, so a fixed interval does not drift. If the
+ * callback falls behind by more than a whole interval, the missed iterations
+ * are skipped rather than run back to back.
+ *
+ * Timing may be inexact due to OS scheduling, and timers may fire slightly
+ * early if SDL_HINT_TIMER_SLACK is set. Be sure to note the current time with
+ * SDL_GetTicksNS() or SDL_GetPerformanceCounter() in case your callback needs
+ * to adjust for variances.
+ *
+ * \param interval the timer delay, in nanoseconds, passed to `callback`
+ * \param callback the SDL_NSTimerCallback function to call when the
+ *                 specified `interval` elapses
+ * \param userdata a pointer that is passed to `callback`
+ * \returns a timer ID or 0 if an error occurs; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_RemoveTimer
+ */
+extern DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval,
+                                                   SDL_NSTimerCallback callback,
+                                                   void *userdata);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -333,9 +333,9 @@ SDL_AssertState SDL_ReportAssertion(SDL_AssertData *data, const char *func, cons
 
 #ifndef SDL_THREADS_DISABLED
     static SDL_SpinLock spinlock = 0;
-    SDL_AtomicLock(&spinlock);
+    SDL_AtomicLockNamed(&spinlock, SDL_LOCK_NAME);
     if (!assertion_mutex) { /* never called SDL_Init()? */
-        assertion_mutex = SDL_CreateMutex();
+        assertion_mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         if (!assertion_mutex) {
             SDL_AtomicUnlock(&spinlock);
             return SDL_ASSERTION_IGNORE; /* oh well, I guess. */
@@ -21,17 +21,32 @@
 #include "SDL_internal.h"
 #include "SDL_hashtable.h"
 
+// This is an open addressing table using Robin Hood hashing: an item being
+// inserted takes the slot of any item that is closer to its ideal slot, which
+// keeps probe sequences short and lets lookups stop as soon as they reach an
+// item closer to home than the key being searched for. Removal shifts the
+// following items back a slot, so there are no tombstones.
+
 typedef struct SDL_HashItem
 {
     const void *key;
     const void *value;
-    struct SDL_HashItem *next;
+    Uint32 hash;
+    Uint32 probe_len : 31;  // distance from the slot the hash maps to
+    Uint32 live : 1;
 } SDL_HashItem;
 
+// The table is grown when it would be more than 7/8ths full
+#define SDL_HASHTABLE_MAX_LOAD(len) ((len) - ((len) >> 3))
+
+// This keeps the table size (and probe lengths) in range of the bitfield above
+#define SDL_HASHTABLE_MAX_SIZE 0x40000000u
+
 struct SDL_HashTable
 {
-    SDL_HashItem **table;
-    Uint32 table_len;
+    SDL_HashItem *table;
+    Uint32 hash_mask;
+    Uint32 num_occupied_slots;
     SDL_bool stackable;
     void *data;
     SDL_HashTable_HashFn hash;
@@ -47,7 +62,8 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
     SDL_HashTable *table;
 
     // num_buckets must be a power of two so we get a solid block of bits to mask hash values against.
-    if ((num_buckets == 0) || ((num_buckets & (num_buckets - 1)) != 0)) {
+    // It's only the initial size now, the table grows as needed.
+    if ((num_buckets == 0) || ((num_buckets & (num_buckets - 1)) != 0) || (num_buckets > SDL_HASHTABLE_MAX_SIZE)) {
         SDL_SetError("num_buckets must be a power of two");
         return NULL;
     }
@@ -57,13 +73,13 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
         return NULL;
     }
 
-    table->table = (SDL_HashItem **) SDL_calloc(num_buckets, sizeof (SDL_HashItem *));
+    table->table = (SDL_HashItem *) SDL_calloc(num_buckets, sizeof (SDL_HashItem));
     if (!table->table) {
         SDL_free(table);
         return NULL;
     }
 
-    table->table_len = num_buckets;
+    table->hash_mask = num_buckets - 1;
     table->stackable = stackable;
     table->data = data;
     table->hash = hashfn;
@@ -74,88 +90,195 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
 
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    return table->hash(key, table->data) & (table->table_len - 1);
+    return table->hash(key, table->data);
 }
 
+// Find the next item matching key, starting at slot *i which is probe_len slots from where hash maps to.
+static SDL_HashItem *find_item(const SDL_HashTable *table, const void *key, const Uint32 hash, Uint32 *i, Uint32 probe_len)
+{
+    const Uint32 hash_mask = table->hash_mask;
+    SDL_HashItem *items = table->table;
 
-SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
+    for (;;) {
+        SDL_HashItem *item = &items[*i];
+
+        // An empty slot, or an item closer to its own slot than this key would be, ends the search.
+        if (!item->live || probe_len > item->probe_len) {
+            return NULL;
+        }
+
+        if (item->hash == hash && table->keymatch(key, item->key, table->data)) {
+            return item;
+        }
+
+        *i = (*i + 1) & hash_mask;
+        ++probe_len;
+    }
+}
+
+static void insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *items, const Uint32 hash_mask)
 {
-    SDL_HashItem *item;
-    const Uint32 hash = calc_hash(table, key);
+    SDL_HashItem item = *item_to_insert;
+    Uint32 i = item.hash & hash_mask;
 
-    if ( (!table->stackable) && (SDL_FindInHashTable(table, key, NULL)) ) {
-        return SDL_FALSE;
+    item.probe_len = 0;
+    item.live = 1;
+
+    for (;;) {
+        SDL_HashItem *target = &items[i];
+
+        if (!target->live) {
+            *target = item;
+            return;
+        }
+
+        // Take the slot from an item that is closer to home, and keep going with that one instead.
+        if (item.probe_len > target->probe_len) {
+            const SDL_HashItem displaced = *target;
+            *target = item;
+            item = displaced;
+        }
+
+        i = (i + 1) & hash_mask;
+        ++item.probe_len;
     }
+}
 
-    // !!! FIXME: grow and rehash table if it gets too saturated.
-    item = (SDL_HashItem *) SDL_malloc(sizeof (SDL_HashItem));
-    if (!item) {
+static SDL_bool resize(SDL_HashTable *table, const Uint32 new_size)
+{
+    const Uint32 old_size = table->hash_mask + 1;
+    SDL_HashItem *old_items = table->table;
+    SDL_HashItem *new_items;
+    Uint32 i;
+
+    new_items = (SDL_HashItem *) SDL_calloc(new_size, sizeof (SDL_HashItem));
+    if (!new_items) {
         return SDL_FALSE;
     }
 
-    item->key = key;
-    item->value = value;
-    item->next = table->table[hash];
-    table->table[hash] = item;
+    // The stored hashes mean nothing needs to be rehashed.
+    for (i = 0; i < old_size; i++) {
+        if (old_items[i].live) {
+            insert_item(&old_items[i], new_items, new_size - 1);
+        }
+    }
 
+    table->table = new_items;
+    table->hash_mask = new_size - 1;
+    SDL_free(old_items);
     return SDL_TRUE;
 }
 
-SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value)
+SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
 {
+    SDL_HashItem item;
     const Uint32 hash = calc_hash(table, key);
-    void *data = table->data;
-    SDL_HashItem *i;
+    const Uint32 table_len = table->hash_mask + 1;
 
-    for (i = table->table[hash]; i; i = i->next) {
-        if (table->keymatch(key, i->key, data)) {
-            if (_value) {
-                *_value = i->value;
-            }
-            return SDL_TRUE;
+    if (!table->stackable) {
+        Uint32 i = hash & table->hash_mask;
+        if (find_item(table, key, hash, &i, 0)) {
+            return SDL_FALSE;
         }
     }
 
-    return SDL_FALSE;
+    if (table->num_occupied_slots >= SDL_HASHTABLE_MAX_LOAD(table_len)) {
+        if (table_len >= SDL_HASHTABLE_MAX_SIZE) {
+            SDL_SetError("Hash table is full");
+            return SDL_FALSE;
+        }
+        if (!resize(table, table_len * 2)) {
+            return SDL_FALSE;
+        }
+    }
+
+    SDL_zero(item);
+    item.key = key;
+    item.value = value;
+    item.hash = hash;
+    insert_item(&item, table->table, table->hash_mask);
+    ++table->num_occupied_slots;
+
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value)
+{
+    const Uint32 hash = calc_hash(table, key);
+    Uint32 i = hash & table->hash_mask;
+    const SDL_HashItem *item = find_item(table, key, hash, &i, 0);
+
+    if (!item) {
+        return SDL_FALSE;
+    }
+    if (_value) {
+        *_value = item->value;
+    }
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = NULL;
-    SDL_HashItem *prev = NULL;
-    void *data = table->data;
-
-    for (item = table->table[hash]; item; item = item->next) {
-        if (table->keymatch(key, item->key, data)) {
-            if (prev) {
-                prev->next = item->next;
-            } else {
-                table->table[hash] = item->next;
-            }
+    const Uint32 hash_mask = table->hash_mask;
+    SDL_HashItem *items = table->table;
+    Uint32 i = hash & hash_mask;
+    SDL_HashItem *item = find_item(table, key, hash, &i, 0);
+    const void *removed_key;
+    const void *removed_value;
 
-            table->nuke(item->key, item->value, data);
-            SDL_free(item);
-            return SDL_TRUE;
+    if (!item) {
+        return SDL_FALSE;
+    }
+
+    removed_key = item->key;
+    removed_value = item->value;
+
+    // Shift the following items back a slot, until one is already in its own slot.
+    for (;;) {
+        const Uint32 next = (i + 1) & hash_mask;
+        SDL_HashItem *next_item = &items[next];
+
+        if (!next_item->live || next_item->probe_len == 0) {
+            SDL_zero(items[i]);
+            break;
         }
 
-        prev = item;
+        items[i] = *next_item;
+        --items[i].probe_len;
+        i = next;
     }
+    --table->num_occupied_slots;
 
-    return SDL_FALSE;
+    table->nuke(removed_key, removed_value, table->data);
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = *iter ? ((SDL_HashItem *) *iter)->next : table->table[calc_hash(table, key)];
+    const Uint32 hash = calc_hash(table, key);
+    const Uint32 hash_mask = table->hash_mask;
+    const SDL_HashItem *item = (const SDL_HashItem *) *iter;
+    Uint32 i, probe_len;
 
-    while (item) {
-        if (table->keymatch(key, item->key, table->data)) {
+    if (item) {
+        // continue after the previous match
+        i = (Uint32)(item - table->table);
+        probe_len = ((i - hash) & hash_mask) + 1;
+        i = (i + 1) & hash_mask;
+    } else {
+        i = hash & hash_mask;
+        probe_len = 0;
+    }
+
+    // a full lap around the table means everything has been seen.
+    if (probe_len <= hash_mask) {
+        item = find_item(table, key, hash, &i, probe_len);
+        if (item) {
             *_value = item->value;
-            *iter = item;
+            *iter = (void *) item;
             return SDL_TRUE;
         }
-        item = item->next;
     }
 
     // no more matches.
@@ -166,22 +289,16 @@ SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, co
 
 SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = (SDL_HashItem *) *iter;
-    Uint32 idx = 0;
+    const SDL_HashItem *item = (const SDL_HashItem *) *iter;
+    const SDL_HashItem *end = table->table + (table->hash_mask + 1);
 
-    if (item) {
-        const SDL_HashItem *orig = item;
-        item = item->next;
-        if (!item) {
-            idx = calc_hash(table, orig->key) + 1;  // !!! FIXME: we probably shouldn't rehash each time.
-        }
-    }
+    item = item ? item + 1 : table->table;
 
-    while (!item && (idx < table->table_len)) {
-        item = table->table[idx++];  // skip empty buckets...
+    while (item < end && !item->live) {
+        item++;  // skip empty slots...
     }
 
-    if (!item) {  // no more matches?
+    if (item == end) {  // no more matches?
         *_key = NULL;
         *iter = NULL;
         return SDL_FALSE;
@@ -189,24 +306,14 @@ SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, con
 
     *_key = item->key;
     *_value = item->value;
-    *iter = item;
+    *iter = (void *) item;
 
     return SDL_TRUE;
 }
 
 SDL_bool SDL_HashTableEmpty(SDL_HashTable *table)
 {
-    if (table) {
-        Uint32 i;
-
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            if (item) {
-                return SDL_FALSE;
-            }
-        }
-    }
-    return SDL_TRUE;
+    return !(table && table->num_occupied_slots);
 }
 
 void SDL_DestroyHashTable(SDL_HashTable *table)
@@ -215,13 +322,10 @@ void SDL_DestroyHashTable(SDL_HashTable *table)
         void *data = table->data;
         Uint32 i;
 
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            while (item) {
-                SDL_HashItem *next = item->next;
+        for (i = 0; i <= table->hash_mask; i++) {
+            SDL_HashItem *item = &table->table[i];
+            if (item->live) {
                 table->nuke(item->key, item->value, data);
-                SDL_free(item);
-                item = next;
             }
         }
 
@@ -256,6 +360,17 @@ SDL_bool SDL_KeyMatchString(const void *a, const void *b, void *data)
     return (SDL_strcmp((const char *)a, (const char *)b) == 0);  // Check against actual string contents.
 }
 
+Uint32 SDL_HashPointer(const void *key, void *unused)
+{
+    // Fibonacci hashing, so the low bits (which are mostly zero because of allocation alignment) don't matter
+    return (Uint32)(((Uint64)(uintptr_t)key * (Uint64)0x9E3779B97F4A7C15ull) >> 32);
+}
+
+SDL_bool SDL_KeyMatchPointer(const void *a, const void *b, void *unused)
+{
+    return (a == b) ? SDL_TRUE : SDL_FALSE;
+}
+
 // We assume we can fit the ID in the key directly
 SDL_COMPILE_TIME_ASSERT(SDL_HashID_KeySize, sizeof(Uint32) <= sizeof(const void *));
 
@@ -51,6 +51,9 @@ SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, con
 Uint32 SDL_HashString(const void *key, void *unused);
 SDL_bool SDL_KeyMatchString(const void *a, const void *b, void *unused);
 
+Uint32 SDL_HashPointer(const void *key, void *unused);
+SDL_bool SDL_KeyMatchPointer(const void *a, const void *b, void *unused);
+
 Uint32 SDL_HashID(const void *key, void *unused);
 SDL_bool SDL_KeyMatchID(const void *a, const void *b, void *unused);
 
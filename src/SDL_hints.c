@@ -21,9 +21,12 @@
 #include "SDL_internal.h"
 
 #include "SDL_hints_c.h"
+#include "SDL_hashtable.h"
 
-/* Assuming there aren't many hints set and they aren't being queried in
-   critical performance paths, we'll just use linked lists here.
+/* Hints are kept in a list, in the order they were added, with a hash table
+   to look them up by name. Entries are only created for hints that are set or
+   watched; the environment variable for each of those is read once and cached
+   until SDL_setenv() changes the environment.
  */
 typedef struct SDL_HintWatch
 {
@@ -38,10 +41,157 @@ typedef struct SDL_Hint
     char *value;
     SDL_HintPriority priority;
     SDL_HintWatch *callbacks;
+    char *env;
+    int env_generation;
     struct SDL_Hint *next;
 } SDL_Hint;
 
+/* Cached environment values that have been replaced, since SDL_GetHint() may
+   have returned them. They are freed in SDL_ClearHints().
+ */
+typedef struct SDL_HintEnvironment
+{
+    char *value;
+    struct SDL_HintEnvironment *next;
+} SDL_HintEnvironment;
+
+/* Protects the list, table and cached environment values, but not the hint values or callbacks */
+static SDL_SpinLock SDL_hint_lock;
 static SDL_Hint *SDL_hints;
+static SDL_HashTable *SDL_hint_table;
+static SDL_HintEnvironment *SDL_hint_stale_env;
+
+/* Incremented when the environment changes */
+static SDL_AtomicInt SDL_env_generation;
+
+/* Incremented when any hint value might have changed, including through the environment */
+static SDL_AtomicInt SDL_hint_generation;
+
+static void SDL_NukeHintTableEntry(const void *key, const void *value, void *data)
+{
+    /* The hints themselves are owned by the SDL_hints list */
+}
+
+/* Find a hint by name, optionally adding it if it doesn't exist yet */
+static SDL_Hint *SDL_FindHint(const char *name, SDL_bool create)
+{
+    SDL_HashTable *table = NULL;
+    SDL_Hint *hint = NULL;
+    SDL_Hint *added = NULL;
+
+    SDL_AtomicLockNamed(&SDL_hint_lock, SDL_LOCK_NAME);
+    if (SDL_hint_table) {
+        SDL_FindInHashTable(SDL_hint_table, name, (const void **)&hint);
+    }
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    if (hint || !create) {
+        return hint;
+    }
+
+    /* Allocate the new entry without holding the lock, another thread may add it meanwhile */
+    added = (SDL_Hint *)SDL_calloc(1, sizeof(*added));
+    if (!added) {
+        return NULL;
+    }
+    added->name = SDL_strdup(name);
+    if (!added->name) {
+        SDL_free(added);
+        return NULL;
+    }
+    added->priority = SDL_HINT_DEFAULT;
+    added->env_generation = SDL_AtomicGet(&SDL_env_generation) - 1;
+
+    if (!SDL_hint_table) {
+        table = SDL_CreateHashTable(NULL, 32, SDL_HashString, SDL_KeyMatchString, SDL_NukeHintTableEntry, SDL_FALSE);
+    }
+
+    SDL_AtomicLockNamed(&SDL_hint_lock, SDL_LOCK_NAME);
+    {
+        if (!SDL_hint_table) {
+            SDL_hint_table = table;
+            table = NULL;
+        }
+        if (SDL_hint_table) {
+            if (!SDL_FindInHashTable(SDL_hint_table, name, (const void **)&hint) &&
+                SDL_InsertIntoHashTable(SDL_hint_table, added->name, added)) {
+                added->next = SDL_hints;
+                SDL_hints = added;
+                hint = added;
+                added = NULL;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    if (table) {
+        SDL_DestroyHashTable(table);
+    }
+    if (added) {
+        SDL_free(added->name);
+        SDL_free(added);
+    }
+    return hint;
+}
+
+/* Get the environment variable for a hint, reading it again only if the environment has changed */
+static const char *SDL_GetHintEnvironment(SDL_Hint *hint)
+{
+    const int generation = SDL_AtomicGet(&SDL_env_generation);
+    const char *value;
+    const char *env;
+    char *copy = NULL;
+    SDL_HintEnvironment *stale;
+
+    SDL_AtomicLockNamed(&SDL_hint_lock, SDL_LOCK_NAME);
+    if (hint->env_generation == generation) {
+        env = hint->env;
+        SDL_AtomicUnlock(&SDL_hint_lock);
+        return env;
+    }
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    value = SDL_getenv(hint->name);
+    if (value) {
+        copy = SDL_strdup(value);
+        if (!copy) {
+            return value;
+        }
+    }
+    stale = (SDL_HintEnvironment *)SDL_malloc(sizeof(*stale));
+    if (!stale) {
+        SDL_free(copy);
+        return value;
+    }
+
+    SDL_AtomicLockNamed(&SDL_hint_lock, SDL_LOCK_NAME);
+    {
+        if (hint->env_generation != generation) {
+            /* The old value may still be in use by a caller of SDL_GetHint() */
+            if (hint->env) {
+                stale->value = hint->env;
+                stale->next = SDL_hint_stale_env;
+                SDL_hint_stale_env = stale;
+                stale = NULL;
+            }
+            hint->env = copy;
+            hint->env_generation = generation;
+            copy = NULL;
+        }
+        env = hint->env;
+    }
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    SDL_free(copy);
+    SDL_free(stale);
+    return env;
+}
+
+void SDL_OnEnvironmentChanged(void)
+{
+    SDL_AtomicIncRef(&SDL_env_generation);
+    SDL_AtomicIncRef(&SDL_hint_generation);
+}
 
 SDL_bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriority priority)
 {
@@ -53,103 +203,85 @@ SDL_bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPr
         return SDL_FALSE;
     }
 
-    env = SDL_getenv(name);
-    if (env && priority < SDL_HINT_OVERRIDE) {
+    hint = SDL_FindHint(name, SDL_TRUE);
+    if (!hint) {
         return SDL_FALSE;
     }
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (priority < hint->priority) {
-                return SDL_FALSE;
-            }
-            if (hint->value != value &&
-                (!value || !hint->value || SDL_strcmp(hint->value, value) != 0)) {
-                char *old_value = hint->value;
-
-                hint->value = value ? SDL_strdup(value) : NULL;
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, old_value, value);
-                    entry = next;
-                }
-                if (old_value) {
-                    SDL_free(old_value);
-                }
-            }
-            hint->priority = priority;
-            return SDL_TRUE;
-        }
+    env = SDL_GetHintEnvironment(hint);
+    if (env && priority < SDL_HINT_OVERRIDE) {
+        return SDL_FALSE;
     }
 
-    /* Couldn't find the hint, add a new one */
-    hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
-    if (!hint) {
+    if (priority < hint->priority) {
         return SDL_FALSE;
     }
-    hint->name = SDL_strdup(name);
-    hint->value = value ? SDL_strdup(value) : NULL;
-    hint->priority = priority;
-    hint->callbacks = NULL;
-    hint->next = SDL_hints;
-    SDL_hints = hint;
+    if (hint->value != value &&
+        (!value || !hint->value || SDL_strcmp(hint->value, value) != 0)) {
+        char *old_value = hint->value;
+
+        hint->value = value ? SDL_strdup(value) : NULL;
+        SDL_AtomicIncRef(&SDL_hint_generation);
+        for (entry = hint->callbacks; entry;) {
+            /* Save the next entry in case this one is deleted */
+            SDL_HintWatch *next = entry->next;
+            entry->callback(entry->userdata, name, old_value, value);
+            entry = next;
+        }
+        if (old_value) {
+            SDL_free(old_value);
+        }
+    }
+    if (hint->priority != priority) {
+        hint->priority = priority;
+        SDL_AtomicIncRef(&SDL_hint_generation);
+    }
     return SDL_TRUE;
 }
 
+static void SDL_ResetHintEntry(SDL_Hint *hint)
+{
+    const char *env = SDL_GetHintEnvironment(hint);
+    SDL_HintWatch *entry;
+
+    SDL_AtomicIncRef(&SDL_hint_generation);
+    if ((!env && hint->value) ||
+        (env && !hint->value) ||
+        (env && SDL_strcmp(env, hint->value) != 0)) {
+        for (entry = hint->callbacks; entry;) {
+            /* Save the next entry in case this one is deleted */
+            SDL_HintWatch *next = entry->next;
+            entry->callback(entry->userdata, hint->name, hint->value, env);
+            entry = next;
+        }
+    }
+    SDL_free(hint->value);
+    hint->value = NULL;
+    hint->priority = SDL_HINT_DEFAULT;
+}
+
 SDL_bool SDL_ResetHint(const char *name)
 {
-    const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
 
     if (!name) {
         return SDL_FALSE;
     }
 
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if ((!env && hint->value) ||
-                (env && !hint->value) ||
-                (env && SDL_strcmp(env, hint->value) != 0)) {
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, hint->value, env);
-                    entry = next;
-                }
-            }
-            SDL_free(hint->value);
-            hint->value = NULL;
-            hint->priority = SDL_HINT_DEFAULT;
-            return SDL_TRUE;
-        }
+    hint = SDL_FindHint(name, SDL_FALSE);
+    if (!hint) {
+        return SDL_FALSE;
     }
-    return SDL_FALSE;
+    SDL_ResetHintEntry(hint);
+    return SDL_TRUE;
 }
 
 void SDL_ResetHints(void)
 {
-    const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
 
     for (hint = SDL_hints; hint; hint = hint->next) {
-        env = SDL_getenv(hint->name);
-        if ((!env && hint->value) ||
-            (env && !hint->value) ||
-            (env && SDL_strcmp(env, hint->value) != 0)) {
-            for (entry = hint->callbacks; entry;) {
-                /* Save the next entry in case this one is deleted */
-                SDL_HintWatch *next = entry->next;
-                entry->callback(entry->userdata, hint->name, hint->value, env);
-                entry = next;
-            }
-        }
-        SDL_free(hint->value);
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
+        SDL_ResetHintEntry(hint);
     }
 }
 
@@ -163,18 +295,37 @@ const char *SDL_GetHint(const char *name)
     const char *env;
     SDL_Hint *hint;
 
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (!env || hint->priority == SDL_HINT_OVERRIDE) {
-                return hint->value;
-            }
-            break;
-        }
+    if (!name) {
+        return NULL;
+    }
+
+    /* Hints that aren't set get an entry too, so their environment variable is cached */
+    hint = SDL_FindHint(name, SDL_TRUE);
+    if (!hint) {
+        return SDL_getenv(name);
+    }
+
+    env = SDL_GetHintEnvironment(hint);
+    if (!env || hint->priority == SDL_HINT_OVERRIDE) {
+        return hint->value;
     }
     return env;
 }
 
+int SDL_GetCachedHint(SDL_HintCache *cache)
+{
+    const int generation = SDL_AtomicGet(&SDL_hint_generation);
+
+    if (cache->generation != generation) {
+        cache->value = cache->parse(SDL_GetHint(cache->name), cache->default_value);
+        SDL_MemoryBarrierRelease();
+        cache->generation = generation;
+    } else {
+        SDL_MemoryBarrierAcquire();
+    }
+    return cache->value;
+}
+
 int SDL_GetStringInteger(const char *value, int default_value)
 {
     if (!value || !*value) {
@@ -231,29 +382,11 @@ int SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userd
     entry->callback = callback;
     entry->userdata = userdata;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            break;
-        }
-    }
+    /* Need a hint entry for this watcher, even if the hint isn't set */
+    hint = SDL_FindHint(name, SDL_TRUE);
     if (!hint) {
-        /* Need to add a hint entry for this watcher */
-        hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
-        if (!hint) {
-            SDL_free(entry);
-            return -1;
-        }
-        hint->name = SDL_strdup(name);
-        if (!hint->name) {
-            SDL_free(entry);
-            SDL_free(hint);
-            return -1;
-        }
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
-        hint->callbacks = NULL;
-        hint->next = SDL_hints;
-        SDL_hints = hint;
+        SDL_free(entry);
+        return -1;
     }
 
     /* Add it to the callbacks for this hint */
@@ -271,22 +404,24 @@ void SDL_DelHintCallback(const char *name, SDL_HintCallback callback, void *user
     SDL_Hint *hint;
     SDL_HintWatch *entry, *prev;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            prev = NULL;
-            for (entry = hint->callbacks; entry; entry = entry->next) {
-                if (callback == entry->callback && userdata == entry->userdata) {
-                    if (prev) {
-                        prev->next = entry->next;
-                    } else {
-                        hint->callbacks = entry->next;
-                    }
-                    SDL_free(entry);
-                    break;
+    if (!name) {
+        return;
+    }
+
+    hint = SDL_FindHint(name, SDL_FALSE);
+    if (hint) {
+        prev = NULL;
+        for (entry = hint->callbacks; entry; entry = entry->next) {
+            if (callback == entry->callback && userdata == entry->userdata) {
+                if (prev) {
+                    prev->next = entry->next;
+                } else {
+                    hint->callbacks = entry->next;
                 }
-                prev = entry;
+                SDL_free(entry);
+                break;
             }
-            return;
+            prev = entry;
         }
     }
 }
@@ -295,6 +430,25 @@ void SDL_ClearHints(void)
 {
     SDL_Hint *hint;
     SDL_HintWatch *entry;
+    SDL_HintEnvironment *stale;
+
+    SDL_AtomicLockNamed(&SDL_hint_lock, SDL_LOCK_NAME);
+    if (SDL_hint_table) {
+        SDL_DestroyHashTable(SDL_hint_table);
+        SDL_hint_table = NULL;
+    }
+    stale = SDL_hint_stale_env;
+    SDL_hint_stale_env = NULL;
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    while (stale) {
+        SDL_HintEnvironment *freeable = stale;
+        stale = stale->next;
+        SDL_free(freeable->value);
+        SDL_free(freeable);
+    }
+
+    SDL_AtomicIncRef(&SDL_hint_generation);
 
     while (SDL_hints) {
         hint = SDL_hints;
@@ -302,6 +456,7 @@ void SDL_ClearHints(void)
 
         SDL_free(hint->name);
         SDL_free(hint->value);
+        SDL_free(hint->env);
         for (entry = hint->callbacks; entry;) {
             SDL_HintWatch *freeable = entry;
             entry = entry->next;
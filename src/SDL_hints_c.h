@@ -28,4 +28,26 @@
 extern SDL_bool SDL_GetStringBoolean(const char *value, SDL_bool default_value);
 extern int SDL_GetStringInteger(const char *value, int default_value);
 
+/* A hint that is read in performance sensitive code. The parsed value is
+   cached, so reading it costs a single atomic load until a hint or the
+   environment changes. Declare it static with SDL_HINT_CACHE_INIT().
+ */
+typedef int (*SDL_HintParseFunc)(const char *value, int default_value);
+
+typedef struct SDL_HintCache
+{
+    const char *name;
+    SDL_HintParseFunc parse;
+    int default_value;
+    int generation;
+    int value;
+} SDL_HintCache;
+
+#define SDL_HINT_CACHE_INIT(name, parse, default_value) { name, parse, default_value, -1, default_value }
+
+extern int SDL_GetCachedHint(SDL_HintCache *cache);
+
+/* Called by SDL_setenv() so cached environment variables are read again */
+extern void SDL_OnEnvironmentChanged(void);
+
 #endif /* SDL_hints_c_h_ */
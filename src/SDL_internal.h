@@ -213,6 +213,16 @@ extern DECLSPEC int SDLCALL SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint6
 extern DECLSPEC int SDLCALL SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS);
 extern DECLSPEC SDL_bool SDLCALL SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS);
 
+/* Locks inside SDL are named after the source line that creates them, or that
+   takes them for spinlocks, so they can be told apart when SDL_HINT_LOCK_PROFILING
+   is enabled.
+*/
+#define SDL_LOCK_NAME_LINE(line) SDL_STRINGIFY_ARG(line)
+#define SDL_LOCK_NAME SDL_FILE ":" SDL_LOCK_NAME_LINE(SDL_LINE)
+extern SDL_Mutex *SDL_CreateMutexNamed(const char *name);
+extern SDL_RWLock *SDL_CreateRWLockNamed(const char *name);
+extern void SDL_AtomicLockNamed(SDL_SpinLock *lock, const char *name);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
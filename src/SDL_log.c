@@ -114,7 +114,7 @@ void SDL_InitLog(void)
 {
     if (!log_function_mutex) {
         /* if this fails we'll try to continue without it. */
-        log_function_mutex = SDL_CreateMutex();
+        log_function_mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     }
 }
 
@@ -307,7 +307,7 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_S
 
     if (!log_function_mutex) {
         /* this mutex creation can race if you log from two threads at startup. You should have called SDL_Init first! */
-        log_function_mutex = SDL_CreateMutex();
+        log_function_mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     }
 
     /* Render into stack buffer */
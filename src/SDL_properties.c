@@ -22,6 +22,7 @@
 #include "SDL_hashtable.h"
 #include "SDL_hints_c.h"
 #include "SDL_properties_c.h"
+#include "thread/SDL_systhread.h"
 
 
 typedef struct
@@ -48,11 +49,20 @@ typedef struct
     SDL_Mutex *lock;
 } SDL_Properties;
 
+/* The table of property groups is read far more often than it changes, so
+ * it's protected by a read/write lock. Property names are interned in a
+ * table protected by the same lock, so each group is keyed by the interned
+ * name pointers and a name that has never been set can't be in any group.
+ */
 static SDL_HashTable *SDL_properties;
-static SDL_Mutex *SDL_properties_lock;
+static SDL_HashTable *SDL_property_names;
+static SDL_RWLock *SDL_properties_lock;
 static SDL_PropertiesID SDL_last_properties_id;
 static SDL_PropertiesID SDL_global_properties;
 
+/* Incremented when the interned names are freed, so SDL_PropertyKey looks them up again */
+static SDL_AtomicInt SDL_property_names_generation;
+
 
 static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, SDL_bool cleanup)
 {
@@ -74,7 +84,7 @@ static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void
             SDL_free(property->string_storage);
         }
     }
-    SDL_free((void *)key);
+    /* The key is an interned name, which is freed with SDL_property_names */
     SDL_free((void *)value);
 }
 
@@ -99,10 +109,15 @@ static void SDL_FreeProperties(const void *key, const void *value, void *data)
     }
 }
 
+static void SDL_FreePropertyName(const void *key, const void *value, void *data)
+{
+    SDL_free((void *)key);
+}
+
 int SDL_InitProperties(void)
 {
     if (!SDL_properties_lock) {
-        SDL_properties_lock = SDL_CreateMutex();
+        SDL_properties_lock = SDL_CreateRWLockNamed(SDL_LOCK_NAME);
         if (!SDL_properties_lock) {
             return -1;
         }
@@ -113,6 +128,12 @@ int SDL_InitProperties(void)
             return -1;
         }
     }
+    if (!SDL_property_names) {
+        SDL_property_names = SDL_CreateHashTable(NULL, 64, SDL_HashString, SDL_KeyMatchString, SDL_FreePropertyName, SDL_FALSE);
+        if (!SDL_property_names) {
+            return -1;
+        }
+    }
     return 0;
 }
 
@@ -126,12 +147,153 @@ void SDL_QuitProperties(void)
         SDL_DestroyHashTable(SDL_properties);
         SDL_properties = NULL;
     }
+    if (SDL_property_names) {
+        SDL_DestroyHashTable(SDL_property_names);
+        SDL_property_names = NULL;
+        SDL_AtomicIncRef(&SDL_property_names_generation);
+    }
     if (SDL_properties_lock) {
-        SDL_DestroyMutex(SDL_properties_lock);
+        SDL_DestroyRWLock(SDL_properties_lock);
         SDL_properties_lock = NULL;
     }
 }
 
+/* Find a group of properties and, optionally, the interned copy of a property name.
+ * The name is set to NULL if no property has ever been set with that name.
+ */
+static SDL_Properties *SDL_FindProperties(SDL_PropertiesID props, const char *name, const char **interned_name)
+{
+    SDL_Properties *properties = NULL;
+
+    SDL_LockRWLockForReading(SDL_properties_lock);
+    {
+        SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+        if (interned_name) {
+            *interned_name = NULL;
+            SDL_FindInHashTable(SDL_property_names, name, (const void **)interned_name);
+        }
+    }
+    SDL_UnlockRWLock(SDL_properties_lock);
+
+    return properties;
+}
+
+static const char *SDL_InternPropertyName(const char *name)
+{
+    const char *interned_name = NULL;
+
+    SDL_LockRWLockForWriting(SDL_properties_lock);
+    {
+        if (!SDL_FindInHashTable(SDL_property_names, name, (const void **)&interned_name)) {
+            char *copy = SDL_strdup(name);
+            if (copy) {
+                if (SDL_InsertIntoHashTable(SDL_property_names, copy, copy)) {
+                    interned_name = copy;
+                } else {
+                    SDL_free(copy);
+                }
+            }
+        }
+    }
+    SDL_UnlockRWLock(SDL_properties_lock);
+
+    return interned_name;
+}
+
+/* Find a property by its interned name and lock its group. If this returns a
+ * property, the caller has to unlock the group when it's done with it.
+ */
+static SDL_Property *SDL_LockInternedProperty(SDL_Properties *properties, const char *interned_name)
+{
+    SDL_Property *property = NULL;
+
+    SDL_LockMutex(properties->lock);
+    if (!SDL_FindInHashTable(properties->props, interned_name, (const void **)&property)) {
+        SDL_UnlockMutex(properties->lock);
+        return NULL;
+    }
+    return property;
+}
+
+/* Find a property and lock its group. If this returns a property, the caller
+ * has to unlock the group when it's done with it.
+ */
+static SDL_Property *SDL_LockProperty(SDL_PropertiesID props, const char *name, SDL_Properties **_properties)
+{
+    const char *interned_name;
+    SDL_Properties *properties = SDL_FindProperties(props, name, &interned_name);
+    SDL_Property *property = NULL;
+
+    if (!properties) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+    if (interned_name) {
+        property = SDL_LockInternedProperty(properties, interned_name);
+    }
+    if (!property) {
+        SDL_SetError("Couldn't find property named %s", name);
+        return NULL;
+    }
+    *_properties = properties;
+    return property;
+}
+
+/* Get the interned name for a key, looking it up only the first time it's
+ * used. This is NULL if nothing has been set with that name yet.
+ */
+static const char *SDL_GetPropertyKeyName(SDL_PropertyKey *key)
+{
+    const int generation = SDL_AtomicGet(&SDL_property_names_generation);
+    const char *interned_name = NULL;
+
+    if (key->generation == generation) {
+        SDL_MemoryBarrierAcquire();
+        return key->interned_name;
+    }
+
+    SDL_LockRWLockForReading(SDL_properties_lock);
+    SDL_FindInHashTable(SDL_property_names, key->name, (const void **)&interned_name);
+    SDL_UnlockRWLock(SDL_properties_lock);
+
+    if (interned_name) {
+        key->interned_name = interned_name;
+        SDL_MemoryBarrierRelease();
+        key->generation = generation;
+    }
+    return interned_name;
+}
+
+/* Find a property by key and lock its group, without setting an error if it isn't set */
+static SDL_Property *SDL_LockPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, SDL_Properties **_properties)
+{
+    const char *interned_name;
+    SDL_Properties *properties;
+    SDL_Property *property;
+
+    if (!props) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+
+    properties = SDL_FindProperties(props, NULL, NULL);
+    if (!properties) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+
+    interned_name = SDL_GetPropertyKeyName(key);
+    if (!interned_name) {
+        return NULL;
+    }
+
+    property = SDL_LockInternedProperty(properties, interned_name);
+    if (property) {
+        *_properties = properties;
+    }
+    return property;
+}
+
 SDL_PropertiesID SDL_GetGlobalProperties(void)
 {
     if (!SDL_global_properties) {
@@ -154,11 +316,11 @@ SDL_PropertiesID SDL_CreateProperties(void)
     if (!properties) {
         goto error;
     }
-    properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, SDL_FALSE);
+    properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashPointer, SDL_KeyMatchPointer, SDL_FreeProperty, SDL_FALSE);
     if (!properties->props) {
         goto error;
     }
-    properties->lock = SDL_CreateMutex();
+    properties->lock = SDL_CreateAdaptiveMutex(SDL_LOCK_NAME);
     if (!properties->lock) {
         goto error;
     }
@@ -167,7 +329,7 @@ SDL_PropertiesID SDL_CreateProperties(void)
         goto error;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
+    SDL_LockRWLockForWriting(SDL_properties_lock);
     ++SDL_last_properties_id;
     if (SDL_last_properties_id == 0) {
         ++SDL_last_properties_id;
@@ -176,7 +338,7 @@ SDL_PropertiesID SDL_CreateProperties(void)
     if (SDL_InsertIntoHashTable(SDL_properties, (const void *)(uintptr_t)props, properties)) {
         inserted = SDL_TRUE;
     }
-    SDL_UnlockMutex(SDL_properties_lock);
+    SDL_UnlockRWLock(SDL_properties_lock);
 
     if (inserted) {
         /* All done! */
@@ -196,10 +358,7 @@ int SDL_LockProperties(SDL_PropertiesID props)
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, NULL, NULL);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
@@ -216,10 +375,7 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, NULL, NULL);
     if (!properties) {
         return;
     }
@@ -230,6 +386,7 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
 static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
 {
     SDL_Properties *properties = NULL;
+    const char *interned_name = NULL;
     int result = 0;
 
     if (!props) {
@@ -241,22 +398,30 @@ static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_
         return SDL_InvalidParamError("name");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, name, &interned_name);
     if (!properties) {
         SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
         return SDL_InvalidParamError("props");
     }
 
+    if (!interned_name) {
+        if (!property) {
+            /* Nothing has ever been set with this name, there's nothing to clear */
+            return 0;
+        }
+        interned_name = SDL_InternPropertyName(name);
+        if (!interned_name) {
+            SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
+            return -1;
+        }
+    }
+
     SDL_LockMutex(properties->lock);
     {
-        SDL_RemoveFromHashTable(properties->props, name);
+        SDL_RemoveFromHashTable(properties->props, interned_name);
         if (property) {
-            char *key = SDL_strdup(name);
-            if (!SDL_InsertIntoHashTable(properties->props, key, property)) {
-                SDL_FreePropertyWithCleanup(key, property, NULL, SDL_FALSE);
+            if (!SDL_InsertIntoHashTable(properties->props, interned_name, property)) {
+                SDL_FreePropertyWithCleanup(interned_name, property, NULL, SDL_FALSE);
                 result = -1;
             }
         }
@@ -360,6 +525,7 @@ int SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool va
 SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
     SDL_Properties *properties = NULL;
+    SDL_Property *property;
     SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
 
     if (!props) {
@@ -371,32 +537,130 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    property = SDL_LockProperty(props, name, &properties);
+    if (property) {
+        type = property->type;
+        SDL_UnlockMutex(properties->lock);
+    }
 
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return SDL_PROPERTY_TYPE_INVALID;
+    return type;
+}
+
+/* Convert a property to each type. These leave the value alone and return
+ * SDL_FALSE if the property can't be converted, the callers set the error.
+ */
+static SDL_bool SDL_GetPointerPropertyValue(SDL_Property *property, void **value)
+{
+    if (property->type == SDL_PROPERTY_TYPE_POINTER) {
+        *value = property->value.pointer_value;
+        return SDL_TRUE;
     }
+    return SDL_FALSE;
+}
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            type = property->type;
+static SDL_bool SDL_GetStringPropertyValue(SDL_Property *property, const char **value)
+{
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = property->value.string_value;
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        if (property->string_storage) {
+            *value = property->string_storage;
         } else {
-            SDL_SetError("Couldn't find property named %s", name);
+            SDL_asprintf(&property->string_storage, "%" SDL_PRIs64 "", property->value.number_value);
+            if (property->string_storage) {
+                *value = property->string_storage;
+            }
         }
-    }
-    SDL_UnlockMutex(properties->lock);
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        if (property->string_storage) {
+            *value = property->string_storage;
+        } else {
+            SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
+            if (property->string_storage) {
+                *value = property->string_storage;
+            }
+        }
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = property->value.boolean_value ? "true" : "false";
+        break;
+    default:
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
 
-    return type;
+static SDL_bool SDL_GetNumberPropertyValue(SDL_Property *property, Sint64 *value)
+{
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = SDL_strtoll(property->value.string_value, NULL, 0);
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        *value = property->value.number_value;
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        *value = (Sint64)SDL_round((double)property->value.float_value);
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = property->value.boolean_value;
+        break;
+    default:
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool SDL_GetFloatPropertyValue(SDL_Property *property, float *value)
+{
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = (float)SDL_atof(property->value.string_value);
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        *value = (float)property->value.number_value;
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        *value = property->value.float_value;
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = (float)property->value.boolean_value;
+        break;
+    default:
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+/* The value passed in is the default, used for strings that aren't a boolean */
+static SDL_bool SDL_GetBooleanPropertyValue(SDL_Property *property, SDL_bool *value)
+{
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_STRING:
+        *value = SDL_GetStringBoolean(property->value.string_value, *value);
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        *value = (property->value.number_value != 0);
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        *value = (property->value.float_value != 0.0f);
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        *value = property->value.boolean_value;
+        break;
+    default:
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
 }
 
 void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_value)
 {
     SDL_Properties *properties = NULL;
+    SDL_Property *property;
     void *value = default_value;
 
     if (!props) {
@@ -408,33 +672,17 @@ void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_va
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-
     /* Note that taking the lock here only guarantees that we won't read the
      * hashtable while it's being modified. The value itself can easily be
      * freed from another thread after it is returned here.
      */
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            if (property->type == SDL_PROPERTY_TYPE_POINTER) {
-                value = property->value.pointer_value;
-            } else {
-                SDL_SetError("Property %s isn't a pointer value", name);
-            }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
+    property = SDL_LockProperty(props, name, &properties);
+    if (property) {
+        if (!SDL_GetPointerPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a pointer value", name);
         }
+        SDL_UnlockMutex(properties->lock);
     }
-    SDL_UnlockMutex(properties->lock);
 
     return value;
 }
@@ -442,6 +690,7 @@ void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_va
 const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
 {
     SDL_Properties *properties = NULL;
+    SDL_Property *property;
     const char *value = default_value;
 
     if (!props) {
@@ -453,61 +702,19 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-
     /* Note that taking the lock here only guarantees that we won't read the
      * hashtable while it's being modified. The value itself can easily be
      * freed from another thread after it is returned here.
      *
      * FIXME: Should we SDL_strdup() the return value to avoid this?
      */
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = property->value.string_value;
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%" SDL_PRIs64 "", property->value.number_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
-                }
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
-                }
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value ? "true" : "false";
-                break;
-            default:
-                SDL_SetError("Property %s isn't a string value", name);
-                break;
-            }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
+    property = SDL_LockProperty(props, name, &properties);
+    if (property) {
+        if (!SDL_GetStringPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a string value", name);
         }
+        SDL_UnlockMutex(properties->lock);
     }
-    SDL_UnlockMutex(properties->lock);
 
     return value;
 }
@@ -515,6 +722,7 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
 Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
 {
     SDL_Properties *properties = NULL;
+    SDL_Property *property;
     Sint64 value = default_value;
 
     if (!props) {
@@ -526,41 +734,13 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = SDL_strtoll(property->value.string_value, NULL, 0);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = property->value.number_value;
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = (Sint64)SDL_round((double)property->value.float_value);
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value;
-                break;
-            default:
-                SDL_SetError("Property %s isn't a number value", name);
-                break;
-            }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
+    property = SDL_LockProperty(props, name, &properties);
+    if (property) {
+        if (!SDL_GetNumberPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a number value", name);
         }
+        SDL_UnlockMutex(properties->lock);
     }
-    SDL_UnlockMutex(properties->lock);
 
     return value;
 }
@@ -568,6 +748,7 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
 float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
 {
     SDL_Properties *properties = NULL;
+    SDL_Property *property;
     float value = default_value;
 
     if (!props) {
@@ -579,41 +760,13 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = (float)SDL_atof(property->value.string_value);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = (float)property->value.number_value;
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = property->value.float_value;
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = (float)property->value.boolean_value;
-                break;
-            default:
-                SDL_SetError("Property %s isn't a float value", name);
-                break;
-            }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
+    property = SDL_LockProperty(props, name, &properties);
+    if (property) {
+        if (!SDL_GetFloatPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a float value", name);
         }
+        SDL_UnlockMutex(properties->lock);
     }
-    SDL_UnlockMutex(properties->lock);
 
     return value;
 }
@@ -621,6 +774,7 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
 SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value)
 {
     SDL_Properties *properties = NULL;
+    SDL_Property *property;
     SDL_bool value = default_value;
 
     if (!props) {
@@ -632,42 +786,89 @@ SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bo
         return value;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    property = SDL_LockProperty(props, name, &properties);
+    if (property) {
+        if (!SDL_GetBooleanPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a boolean value", name);
+        }
+        SDL_UnlockMutex(properties->lock);
+    }
+
+    return value;
+}
 
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
+void *SDL_GetPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *default_value)
+{
+    SDL_Properties *properties = NULL;
+    SDL_Property *property = SDL_LockPropertyByKey(props, key, &properties);
+    void *value = default_value;
+
+    if (property) {
+        if (!SDL_GetPointerPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a pointer value", key->name);
+        }
+        SDL_UnlockMutex(properties->lock);
     }
+    return value;
+}
 
-    SDL_LockMutex(properties->lock);
-    {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
-            switch (property->type) {
-            case SDL_PROPERTY_TYPE_STRING:
-                value = SDL_GetStringBoolean(property->value.string_value, default_value);
-                break;
-            case SDL_PROPERTY_TYPE_NUMBER:
-                value = (property->value.number_value != 0);
-                break;
-            case SDL_PROPERTY_TYPE_FLOAT:
-                value = (property->value.float_value != 0.0f);
-                break;
-            case SDL_PROPERTY_TYPE_BOOLEAN:
-                value = property->value.boolean_value;
-                break;
-            default:
-                SDL_SetError("Property %s isn't a boolean value", name);
-                break;
-            }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
+const char *SDL_GetStringPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, const char *default_value)
+{
+    SDL_Properties *properties = NULL;
+    SDL_Property *property = SDL_LockPropertyByKey(props, key, &properties);
+    const char *value = default_value;
+
+    if (property) {
+        if (!SDL_GetStringPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a string value", key->name);
         }
+        SDL_UnlockMutex(properties->lock);
     }
-    SDL_UnlockMutex(properties->lock);
+    return value;
+}
 
+Sint64 SDL_GetNumberPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, Sint64 default_value)
+{
+    SDL_Properties *properties = NULL;
+    SDL_Property *property = SDL_LockPropertyByKey(props, key, &properties);
+    Sint64 value = default_value;
+
+    if (property) {
+        if (!SDL_GetNumberPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a number value", key->name);
+        }
+        SDL_UnlockMutex(properties->lock);
+    }
+    return value;
+}
+
+float SDL_GetFloatPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, float default_value)
+{
+    SDL_Properties *properties = NULL;
+    SDL_Property *property = SDL_LockPropertyByKey(props, key, &properties);
+    float value = default_value;
+
+    if (property) {
+        if (!SDL_GetFloatPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a float value", key->name);
+        }
+        SDL_UnlockMutex(properties->lock);
+    }
+    return value;
+}
+
+SDL_bool SDL_GetBooleanPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, SDL_bool default_value)
+{
+    SDL_Properties *properties = NULL;
+    SDL_Property *property = SDL_LockPropertyByKey(props, key, &properties);
+    SDL_bool value = default_value;
+
+    if (property) {
+        if (!SDL_GetBooleanPropertyValue(property, &value)) {
+            SDL_SetError("Property %s isn't a boolean value", key->name);
+        }
+        SDL_UnlockMutex(properties->lock);
+    }
     return value;
 }
 
@@ -687,10 +888,7 @@ int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallb
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, NULL, NULL);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
@@ -716,7 +914,7 @@ void SDL_DestroyProperties(SDL_PropertiesID props)
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
+    SDL_LockRWLockForWriting(SDL_properties_lock);
     SDL_RemoveFromHashTable(SDL_properties, (const void *)(uintptr_t)props);
-    SDL_UnlockMutex(SDL_properties_lock);
+    SDL_UnlockRWLock(SDL_properties_lock);
 }
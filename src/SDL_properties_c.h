@@ -21,3 +21,23 @@
 
 extern int SDL_InitProperties(void);
 extern void SDL_QuitProperties(void);
+
+/* A property name that is read in performance sensitive code. The interned
+   name is cached in the key, so a lookup doesn't hash or compare the string,
+   and the getters below don't set an error when the property isn't set.
+   Declare it static with SDL_PROPERTY_KEY_INIT().
+ */
+typedef struct SDL_PropertyKey
+{
+    const char *name;
+    const char *interned_name;
+    int generation;
+} SDL_PropertyKey;
+
+#define SDL_PROPERTY_KEY_INIT(name) { name, NULL, -1 }
+
+extern void *SDL_GetPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *default_value);
+extern const char *SDL_GetStringPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, const char *default_value);
+extern Sint64 SDL_GetNumberPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, Sint64 default_value);
+extern float SDL_GetFloatPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, float default_value);
+extern SDL_bool SDL_GetBooleanPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, SDL_bool default_value);
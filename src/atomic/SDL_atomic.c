@@ -111,7 +111,7 @@ static SDL_INLINE void enterLock(void *a)
 {
     uintptr_t index = ((((uintptr_t)a) >> 3) & 0x1f);
 
-    SDL_AtomicLock(&locks[index]);
+    SDL_AtomicLockNamed(&locks[index], SDL_LOCK_NAME);
 }
 
 static SDL_INLINE void leaveLock(void *a)
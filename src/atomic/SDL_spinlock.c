@@ -44,6 +44,8 @@
 #include <libkern/OSAtomic.h>
 #endif
 
+#include "../thread/SDL_lockprof_c.h"
+
 /* *INDENT-OFF* */ /* clang-format off */
 #if defined(__WATCOMC__) && defined(__386__)
 SDL_COMPILE_TIME_ASSERT(locksize, 4==sizeof(SDL_SpinLock));
@@ -65,7 +67,7 @@ SDL_bool SDL_AtomicTryLock(SDL_SpinLock *lock)
 
     if (!_spinlock_mutex) {
         /* Race condition on first lock... */
-        _spinlock_mutex = SDL_CreateMutex();
+        _spinlock_mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     }
     SDL_LockMutex(_spinlock_mutex);
     if (*lock == 0) {
@@ -165,23 +167,63 @@ SDL_bool SDL_AtomicTryLock(SDL_SpinLock *lock)
 #endif
 }
 
-void SDL_AtomicLock(SDL_SpinLock *lock)
+/* The most pause instructions to wait between checks of a contended lock */
+#define SDL_SPINLOCK_MAX_BACKOFF 64
+
+static void SDL_AtomicLockAt(SDL_SpinLock *lock, const void *site, const char *name)
 {
-    int iterations = 0;
+    Uint64 wait_start = 0;
+    SDL_bool contended = SDL_FALSE;
+    int backoff = 1;
+    int i;
+
     /* FIXME: Should we have an eventual timeout? */
     while (!SDL_AtomicTryLock(lock)) {
-        if (iterations < 32) {
-            iterations++;
-            SDL_CPUPauseInstruction();
-        } else {
-            /* !!! FIXME: this doesn't definitely give up the current timeslice, it does different things on various platforms. */
-            SDL_Delay(0);
+        if (!contended) {
+            contended = SDL_TRUE;
+            if (SDL_lock_profiling > 0) {
+                wait_start = SDL_GetPerformanceCounter();
+            }
         }
+
+        /* Wait until the lock looks free before trying again, so waiters
+           only read the cache line instead of all writing to it, and back
+           off exponentially so they don't all try again at the same time.
+         */
+        do {
+            if (backoff <= SDL_SPINLOCK_MAX_BACKOFF) {
+                for (i = 0; i < backoff; ++i) {
+                    SDL_CPUPauseInstruction();
+                }
+                backoff *= 2;
+            } else {
+                /* !!! FIXME: this doesn't definitely give up the current timeslice, it does different things on various platforms. */
+                SDL_Delay(0);
+            }
+        } while (*(volatile SDL_SpinLock *)lock != 0);
+    }
+
+    if (SDL_lock_profiling > 0) {
+        SDL_RecordSpinLockAcquired(lock, site, name, contended, wait_start);
     }
 }
 
+void SDL_AtomicLock(SDL_SpinLock *lock)
+{
+    SDL_AtomicLockAt(lock, SDL_LOCK_CALL_SITE(), NULL);
+}
+
+void SDL_AtomicLockNamed(SDL_SpinLock *lock, const char *name)
+{
+    SDL_AtomicLockAt(lock, name, name);
+}
+
 void SDL_AtomicUnlock(SDL_SpinLock *lock)
 {
+    if (SDL_lock_profiling > 0) {
+        SDL_RecordSpinLockReleased(lock);
+    }
+
 #if defined(HAVE_GCC_ATOMICS) || defined(HAVE_GCC_SYNC_LOCK_TEST_AND_SET)
     __sync_lock_release(lock);
 
@@ -521,7 +521,7 @@ static SDL_AudioDevice *CreatePhysicalAudioDevice(const char *name, SDL_bool isc
         return NULL;
     }
 
-    device->lock = SDL_CreateMutex();
+    device->lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (!device->lock) {
         SDL_free(device->name);
         SDL_free(device);
@@ -814,7 +814,7 @@ int SDL_InitAudio(const char *driver_name)
     SDL_ChooseAudioConverters();
     SDL_SetupAudioResampler();
 
-    SDL_RWLock *device_hash_lock = SDL_CreateRWLock();  // create this early, so if it fails we don't have to tear down the whole audio subsystem.
+    SDL_RWLock *device_hash_lock = SDL_CreateRWLockNamed(SDL_LOCK_NAME);  // create this early, so if it fails we don't have to tear down the whole audio subsystem.
     if (!device_hash_lock) {
         return -1;
     }
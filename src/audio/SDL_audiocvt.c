@@ -420,7 +420,7 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
         return NULL;
     }
 
-    retval->lock = SDL_CreateMutex();
+    retval->lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (!retval->lock) {
         SDL_free(retval->queue);
         SDL_free(retval);
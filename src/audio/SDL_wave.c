@@ -35,6 +35,7 @@
 
 #include "SDL_wave.h"
 #include "SDL_sysaudio.h"
+#include "../SDL_hints_c.h"
 
 /* Reads the value stored at the location of the f1 pointer, multiplies it
  * with the second argument and then stores the result to f1.
@@ -333,6 +334,127 @@ static Sint64 WaveAdjustToFactValue(WaveFile *file, Sint64 sampleframes)
     return sampleframes;
 }
 
+/* Big ADPCM files are split into runs of whole blocks that are decoded in
+ * parallel on the default job pool. Every block starts with a fresh decoder
+ * state, so the blocks don't depend on each other.
+ */
+#define ADPCM_THREAD_MIN_BLOCKS 256
+#define ADPCM_MAX_THREADS       8
+
+typedef int (*ADPCM_DecodeBlockFunc)(ADPCM_DecoderState *state);
+
+typedef struct ADPCM_ParallelDecoder
+{
+    const ADPCM_DecoderState *state; /* The caller's state, positioned at the first block. */
+    ADPCM_DecodeBlockFunc decodeblock;
+    Uint8 *cstates; /* The channel states for each run. */
+    size_t cstatesize;
+    int blocksperrun;
+    SDL_AtomicInt failed;
+    char error[256]; /* The error of the first failed run, which may have been on another thread. */
+} ADPCM_ParallelDecoder;
+
+static void SDLCALL ADPCM_DecodeBlocks(void *data, int start, int end)
+{
+    ADPCM_ParallelDecoder *decoder = (ADPCM_ParallelDecoder *)data;
+    ADPCM_DecoderState state = *decoder->state;
+    size_t i;
+
+    state.input.data += state.input.pos;
+    state.cstate = decoder->cstates + (start / decoder->blocksperrun) * decoder->cstatesize;
+
+    for (i = (size_t)start; i < (size_t)end; i++) {
+        state.block.data = state.input.data + i * state.blocksize;
+        state.block.size = state.blocksize;
+        state.block.pos = 0;
+        state.output.pos = decoder->state->output.pos + i * state.samplesperblock * state.channels;
+        state.framesleft = decoder->state->framesleft - (Sint64)(i * state.samplesperblock);
+        if (decoder->decodeblock(&state) < 0) {
+            if (SDL_AtomicCAS(&decoder->failed, 0, 1)) {
+                SDL_strlcpy(decoder->error, SDL_GetError(), sizeof(decoder->error));
+            }
+            break;
+        }
+    }
+}
+
+static int ADPCM_ParseDecodeThreads(const char *value, int default_value)
+{
+    int count = (value && *value) ? SDL_atoi(value) : default_value;
+
+    if (count <= 0) {
+        count = SDL_GetCPUCount();
+    }
+    if (count > ADPCM_MAX_THREADS) {
+        count = ADPCM_MAX_THREADS;
+    }
+    return count;
+}
+
+static int ADPCM_GetDecodeThreadCount(size_t numblocks)
+{
+    static SDL_HintCache hint = SDL_HINT_CACHE_INIT(SDL_HINT_WAVE_DECODE_THREADS, ADPCM_ParseDecodeThreads, 0);
+    int count = SDL_GetCachedHint(&hint);
+
+    if ((size_t)count > numblocks / ADPCM_THREAD_MIN_BLOCKS) {
+        count = (int)(numblocks / ADPCM_THREAD_MIN_BLOCKS);
+    }
+    return count;
+}
+
+/* Decodes the whole blocks at the start of the input in parallel if there are
+ * enough of them, and moves the state past these blocks. The caller decodes
+ * the rest, which includes any truncated block.
+ */
+static int ADPCM_DecodeThreaded(ADPCM_DecoderState *state, size_t cstatesize, ADPCM_DecodeBlockFunc decodeblock)
+{
+    ADPCM_ParallelDecoder decoder;
+    size_t numblocks;
+    int numthreads, numruns;
+
+    /* Leave the block that gets cut short by the sample frame count to the caller. */
+    numblocks = (state->input.size - state->input.pos) / state->blocksize;
+    if ((Uint64)state->framesleft / state->samplesperblock < numblocks) {
+        numblocks = (size_t)((Uint64)state->framesleft / state->samplesperblock);
+    }
+    if (numblocks > SDL_MAX_SINT32) {
+        numblocks = SDL_MAX_SINT32;
+    }
+
+    numthreads = ADPCM_GetDecodeThreadCount(numblocks);
+    if (numthreads < 2) {
+        return 0;
+    }
+
+    SDL_zero(decoder);
+    decoder.state = state;
+    decoder.decodeblock = decodeblock;
+    decoder.cstatesize = cstatesize;
+    decoder.blocksperrun = (int)(numblocks / numthreads);
+    numruns = (int)((numblocks + decoder.blocksperrun - 1) / decoder.blocksperrun);
+
+    decoder.cstates = (Uint8 *)SDL_calloc(numruns, cstatesize);
+    if (!decoder.cstates) {
+        return -1;
+    }
+
+    if (SDL_ParallelFor(NULL, (int)numblocks, decoder.blocksperrun, ADPCM_DecodeBlocks, &decoder) < 0) {
+        SDL_free(decoder.cstates);
+        return -1;
+    }
+    SDL_free(decoder.cstates);
+
+    if (SDL_AtomicGet(&decoder.failed)) {
+        return SDL_SetError("%s", decoder.error);
+    }
+
+    state->input.pos += numblocks * state->blocksize;
+    state->output.pos += numblocks * state->samplesperblock * state->channels;
+    state->framesleft -= (Sint64)(numblocks * state->samplesperblock);
+
+    return 0;
+}
+
 static int MS_ADPCM_CalculateSampleFrames(WaveFile *file, size_t datalength)
 {
     WaveFormat *format = &file->format;
@@ -495,7 +617,7 @@ static Sint16 MS_ADPCM_ProcessNibble(MS_ADPCM_ChannelState *cstate, Sint32 sampl
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
     const Uint16 max_deltaval = 65535;
-    const Uint16 adaptive[] = {
+    static const Uint16 adaptive[] = {
         230, 230, 230, 230, 307, 409, 512, 614,
         768, 614, 512, 409, 307, 230, 230, 230
     };
@@ -633,6 +755,14 @@ static int MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
     return 0;
 }
 
+static int MS_ADPCM_DecodeBlock(ADPCM_DecoderState *state)
+{
+    if (MS_ADPCM_DecodeBlockHeader(state) < 0) {
+        return -1;
+    }
+    return MS_ADPCM_DecodeBlockData(state);
+}
+
 static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     int result;
@@ -688,6 +818,11 @@ static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 
     state.cstate = cstate;
 
+    if (ADPCM_DecodeThreaded(&state, sizeof(cstate), MS_ADPCM_DecodeBlock) < 0) {
+        SDL_free(state.output.data);
+        return -1;
+    }
+
     /* Decode block by block. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -854,13 +989,13 @@ static Sint16 IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 ny
 {
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
-    const Sint8 index_table_4b[16] = {
+    static const Sint8 index_table_4b[16] = {
         -1, -1, -1, -1,
         2, 4, 6, 8,
         -1, -1, -1, -1,
         2, 4, 6, 8
     };
-    const Uint16 step_table[89] = {
+    static const Uint16 step_table[89] = {
         7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
         34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
         143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
@@ -1027,6 +1162,12 @@ static int IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
     return retval;
 }
 
+static int IMA_ADPCM_DecodeBlock(ADPCM_DecoderState *state)
+{
+    IMA_ADPCM_DecodeBlockHeader(state);
+    return IMA_ADPCM_DecodeBlockData(state);
+}
+
 static int IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     int result;
@@ -1084,6 +1225,12 @@ static int IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len
     }
     state.cstate = cstate;
 
+    if (ADPCM_DecodeThreaded(&state, state.channels, IMA_ADPCM_DecodeBlock) < 0) {
+        SDL_free(state.output.data);
+        SDL_free(cstate);
+        return -1;
+    }
+
     /* Decode block by block. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -1158,108 +1305,153 @@ static int LAW_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
-{
 #ifdef SDL_WAVE_LAW_LUT
-    const Sint16 alaw_lut[256] = {
-        -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
-        -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
-        -20992, -24064, -23040, -17920, -16896, -19968, -18944, -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136, -11008,
-        -10496, -12032, -11520, -8960, -8448, -9984, -9472, -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568, -344,
-        -328, -376, -360, -280, -264, -312, -296, -472, -456, -504, -488, -408, -392, -440, -424, -88,
-        -72, -120, -104, -24, -8, -56, -40, -216, -200, -248, -232, -152, -136, -184, -168, -1376,
-        -1312, -1504, -1440, -1120, -1056, -1248, -1184, -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696, -688,
-        -656, -752, -720, -560, -528, -624, -592, -944, -912, -1008, -976, -816, -784, -880, -848, 5504,
-        5248, 6016, 5760, 4480, 4224, 4992, 4736, 7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784, 2752,
-        2624, 3008, 2880, 2240, 2112, 2496, 2368, 3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392, 22016,
-        20992, 24064, 23040, 17920, 16896, 19968, 18944, 30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136, 11008,
-        10496, 12032, 11520, 8960, 8448, 9984, 9472, 15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568, 344,
-        328, 376, 360, 280, 264, 312, 296, 472, 456, 504, 488, 408, 392, 440, 424, 88,
-        72, 120, 104, 24, 8, 56, 40, 216, 200, 248, 232, 152, 136, 184, 168, 1376,
-        1312, 1504, 1440, 1120, 1056, 1248, 1184, 1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696, 688,
-        656, 752, 720, 560, 528, 624, 592, 944, 912, 1008, 976, 816, 784, 880, 848
-    };
-    const Sint16 mulaw_lut[256] = {
-        -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956, -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764, -15996,
-        -15484, -14972, -14460, -13948, -13436, -12924, -12412, -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316, -7932,
-        -7676, -7420, -7164, -6908, -6652, -6396, -6140, -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092, -3900,
-        -3772, -3644, -3516, -3388, -3260, -3132, -3004, -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980, -1884,
-        -1820, -1756, -1692, -1628, -1564, -1500, -1436, -1372, -1308, -1244, -1180, -1116, -1052, -988, -924, -876,
-        -844, -812, -780, -748, -716, -684, -652, -620, -588, -556, -524, -492, -460, -428, -396, -372,
-        -356, -340, -324, -308, -292, -276, -260, -244, -228, -212, -196, -180, -164, -148, -132, -120,
-        -112, -104, -96, -88, -80, -72, -64, -56, -48, -40, -32, -24, -16, -8, 0, 32124,
-        31100, 30076, 29052, 28028, 27004, 25980, 24956, 23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764, 15996,
-        15484, 14972, 14460, 13948, 13436, 12924, 12412, 11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316, 7932,
-        7676, 7420, 7164, 6908, 6652, 6396, 6140, 5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092, 3900,
-        3772, 3644, 3516, 3388, 3260, 3132, 3004, 2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980, 1884,
-        1820, 1756, 1692, 1628, 1564, 1500, 1436, 1372, 1308, 1244, 1180, 1116, 1052, 988, 924, 876,
-        844, 812, 780, 748, 716, 684, 652, 620, 588, 556, 524, 492, 460, 428, 396, 372,
-        356, 340, 324, 308, 292, 276, 260, 244, 228, 212, 196, 180, 164, 148, 132, 120,
-        112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
-    };
+static const Sint16 alaw_lut[256] = {
+    -5504, -5248, -6016, -5760, -4480, -4224, -4992, -4736, -7552, -7296, -8064, -7808, -6528, -6272, -7040, -6784, -2752,
+    -2624, -3008, -2880, -2240, -2112, -2496, -2368, -3776, -3648, -4032, -3904, -3264, -3136, -3520, -3392, -22016,
+    -20992, -24064, -23040, -17920, -16896, -19968, -18944, -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136, -11008,
+    -10496, -12032, -11520, -8960, -8448, -9984, -9472, -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568, -344,
+    -328, -376, -360, -280, -264, -312, -296, -472, -456, -504, -488, -408, -392, -440, -424, -88,
+    -72, -120, -104, -24, -8, -56, -40, -216, -200, -248, -232, -152, -136, -184, -168, -1376,
+    -1312, -1504, -1440, -1120, -1056, -1248, -1184, -1888, -1824, -2016, -1952, -1632, -1568, -1760, -1696, -688,
+    -656, -752, -720, -560, -528, -624, -592, -944, -912, -1008, -976, -816, -784, -880, -848, 5504,
+    5248, 6016, 5760, 4480, 4224, 4992, 4736, 7552, 7296, 8064, 7808, 6528, 6272, 7040, 6784, 2752,
+    2624, 3008, 2880, 2240, 2112, 2496, 2368, 3776, 3648, 4032, 3904, 3264, 3136, 3520, 3392, 22016,
+    20992, 24064, 23040, 17920, 16896, 19968, 18944, 30208, 29184, 32256, 31232, 26112, 25088, 28160, 27136, 11008,
+    10496, 12032, 11520, 8960, 8448, 9984, 9472, 15104, 14592, 16128, 15616, 13056, 12544, 14080, 13568, 344,
+    328, 376, 360, 280, 264, 312, 296, 472, 456, 504, 488, 408, 392, 440, 424, 88,
+    72, 120, 104, 24, 8, 56, 40, 216, 200, 248, 232, 152, 136, 184, 168, 1376,
+    1312, 1504, 1440, 1120, 1056, 1248, 1184, 1888, 1824, 2016, 1952, 1632, 1568, 1760, 1696, 688,
+    656, 752, 720, 560, 528, 624, 592, 944, 912, 1008, 976, 816, 784, 880, 848
+};
+static const Sint16 mulaw_lut[256] = {
+    -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956, -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764, -15996,
+    -15484, -14972, -14460, -13948, -13436, -12924, -12412, -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316, -7932,
+    -7676, -7420, -7164, -6908, -6652, -6396, -6140, -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092, -3900,
+    -3772, -3644, -3516, -3388, -3260, -3132, -3004, -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980, -1884,
+    -1820, -1756, -1692, -1628, -1564, -1500, -1436, -1372, -1308, -1244, -1180, -1116, -1052, -988, -924, -876,
+    -844, -812, -780, -748, -716, -684, -652, -620, -588, -556, -524, -492, -460, -428, -396, -372,
+    -356, -340, -324, -308, -292, -276, -260, -244, -228, -212, -196, -180, -164, -148, -132, -120,
+    -112, -104, -96, -88, -80, -72, -64, -56, -48, -40, -32, -24, -16, -8, 0, 32124,
+    31100, 30076, 29052, 28028, 27004, 25980, 24956, 23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764, 15996,
+    15484, 14972, 14460, 13948, 13436, 12924, 12412, 11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316, 7932,
+    7676, 7420, 7164, 6908, 6652, 6396, 6140, 5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092, 3900,
+    3772, 3644, 3516, 3388, 3260, 3132, 3004, 2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980, 1884,
+    1820, 1756, 1692, 1628, 1564, 1500, 1436, 1372, 1308, 1244, 1180, 1116, 1052, 988, 924, 876,
+    844, 812, 780, 748, 716, 684, 652, 620, 588, 556, 524, 492, 460, 428, 396, 372,
+    356, 340, 324, 308, 292, 276, 260, 244, 228, 212, 196, 180, 164, 148, 132, 120,
+    112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
+};
 #endif
 
-    WaveFormat *format = &file->format;
-    WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
-    Uint8 *src;
-    Sint16 *dst;
+#ifdef SDL_SSE2_INTRINSICS
+/* Shifts each 16-bit lane of x left by the matching lane of shift (0 to 7). */
+static __m128i SDL_TARGETING("sse2") LAW_ShiftLeft_SSE2(__m128i x, __m128i shift)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i two = _mm_set1_epi16(2);
+    const __m128i four = _mm_set1_epi16(4);
+    __m128i mask;
+
+    mask = _mm_cmpeq_epi16(_mm_and_si128(shift, one), one);
+    x = _mm_or_si128(_mm_and_si128(mask, _mm_slli_epi16(x, 1)), _mm_andnot_si128(mask, x));
+    mask = _mm_cmpeq_epi16(_mm_and_si128(shift, two), two);
+    x = _mm_or_si128(_mm_and_si128(mask, _mm_slli_epi16(x, 2)), _mm_andnot_si128(mask, x));
+    mask = _mm_cmpeq_epi16(_mm_and_si128(shift, four), four);
+    x = _mm_or_si128(_mm_and_si128(mask, _mm_slli_epi16(x, 4)), _mm_andnot_si128(mask, x));
+    return x;
+}
 
-    if (chunk->length != chunk->size) {
-        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
-        if (file->sampleframes < 0) {
-            return -1;
-        }
-    }
+/* The same calculations as the scalar A-law and mu-law code, on 8 samples
+ * that were zero-extended to 16 bits.
+ */
+static __m128i SDL_TARGETING("sse2") LAW_DecodeAlaw_SSE2(__m128i x)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i value = _mm_xor_si128(_mm_and_si128(x, _mm_set1_epi16(0x7f)), _mm_set1_epi16(0x55));
+    const __m128i exponent = _mm_srli_epi16(value, 4);
+    const __m128i negative = _mm_cmpeq_epi16(_mm_and_si128(x, _mm_set1_epi16(0x80)), zero);
+    __m128i mantissa = _mm_and_si128(value, _mm_set1_epi16(0x0f));
+
+    mantissa = _mm_or_si128(mantissa, _mm_andnot_si128(_mm_cmpeq_epi16(exponent, zero), _mm_set1_epi16(0x10)));
+    mantissa = _mm_or_si128(_mm_slli_epi16(mantissa, 4), _mm_set1_epi16(0x08));
+    mantissa = LAW_ShiftLeft_SSE2(mantissa, _mm_subs_epu16(exponent, _mm_set1_epi16(1)));
+    return _mm_sub_epi16(_mm_xor_si128(mantissa, negative), negative);
+}
 
-    /* Nothing to decode, nothing to return. */
-    if (file->sampleframes == 0) {
-        *audio_buf = NULL;
-        *audio_len = 0;
-        return 0;
-    }
+static __m128i SDL_TARGETING("sse2") LAW_DecodeMulaw_SSE2(__m128i x)
+{
+    const __m128i value = _mm_xor_si128(x, _mm_set1_epi16(0xff));
+    const __m128i exponent = _mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi16(0x07));
+    const __m128i negative = _mm_cmpeq_epi16(_mm_and_si128(value, _mm_set1_epi16(0x80)), _mm_set1_epi16(0x80));
+    __m128i mantissa = _mm_and_si128(value, _mm_set1_epi16(0x0f));
+
+    /* (0x80 << exponent) + step * mantissa + step / 2 - 132, with step = 8 << exponent */
+    mantissa = _mm_add_epi16(_mm_slli_epi16(mantissa, 3), _mm_set1_epi16(0x84));
+    mantissa = _mm_sub_epi16(LAW_ShiftLeft_SSE2(mantissa, exponent), _mm_set1_epi16(0x84));
+    return _mm_sub_epi16(_mm_xor_si128(mantissa, negative), negative);
+}
 
-    sample_count = (size_t)file->sampleframes;
-    if (SafeMult(&sample_count, format->channels)) {
-        return SDL_SetError("WAVE file too big");
+/* Expands a multiple of 16 samples. Like the scalar code, this works
+ * backwards. Each group of 16 samples is loaded before its output is
+ * stored, and that output never reaches the samples before the group.
+ */
+static void SDL_TARGETING("sse2") LAW_Convert_SSE2(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = count;
+
+    while (i > 0) {
+        __m128i bytes, lo, hi;
+
+        i -= 16;
+        bytes = _mm_loadu_si128((const __m128i *)(src + i));
+        lo = _mm_unpacklo_epi8(bytes, zero);
+        hi = _mm_unpackhi_epi8(bytes, zero);
+        if (encoding == ALAW_CODE) {
+            lo = LAW_DecodeAlaw_SSE2(lo);
+            hi = LAW_DecodeAlaw_SSE2(hi);
+        } else {
+            lo = LAW_DecodeMulaw_SSE2(lo);
+            hi = LAW_DecodeMulaw_SSE2(hi);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), lo);
+        _mm_storeu_si128((__m128i *)(dst + i + 8), hi);
     }
+}
+#endif
 
-    expanded_len = sample_count;
-    if (SafeMult(&expanded_len, sizeof(Sint16))) {
-        return SDL_SetError("WAVE file too big");
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
-        return SDL_SetError("WAVE file too big");
-    }
+/* Expands count companded samples from src to 16-bit samples in dst. The
+ * buffers may start at the same address.
+ */
+static int LAW_Convert(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t count)
+{
+    size_t i, first = 0;
 
-    /* 1 to avoid allocating zero bytes, to keep static analysis happy. */
-    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
-    if (!src) {
-        return -1;
+#ifdef SDL_SSE2_INTRINSICS
+    if ((encoding == ALAW_CODE || encoding == MULAW_CODE) && SDL_HasSSE2()) {
+        /* The scalar code below only does the trailing samples. */
+        first = count - count % 16;
     }
-    chunk->data = NULL;
-    chunk->size = 0;
-
-    dst = (Sint16 *)src;
+#endif
 
-    /* Work backwards, since we're expanding in-place. `format` will
-     * inform the caller about the byte order.
-     */
-    i = sample_count;
-    switch (file->format.encoding) {
+    /* Work backwards, since the samples may be expanded in-place. */
+    i = count;
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
     case ALAW_CODE:
-        while (i--) {
+        while (i-- > first) {
             dst[i] = alaw_lut[src[i]];
         }
         break;
     case MULAW_CODE:
-        while (i--) {
+        while (i-- > first) {
             dst[i] = mulaw_lut[src[i]];
         }
         break;
 #else
     case ALAW_CODE:
-        while (i--) {
+        while (i-- > first) {
             Uint8 nibble = src[i];
             Uint8 exponent = (nibble & 0x7f) ^ 0x55;
             Sint16 mantissa = exponent & 0xf;
@@ -1277,7 +1469,7 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         }
         break;
     case MULAW_CODE:
-        while (i--) {
+        while (i-- > first) {
             Uint8 nibble = ~src[i];
             Sint16 mantissa = nibble & 0xf;
             Uint8 exponent = (nibble >> 4) & 0x7;
@@ -1290,10 +1482,68 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         break;
 #endif
     default:
-        SDL_free(src);
         return SDL_SetError("Unknown companded encoding");
     }
 
+#ifdef SDL_SSE2_INTRINSICS
+    if (first > 0) {
+        LAW_Convert_SSE2(encoding, src, dst, first);
+    }
+#endif
+
+    return 0;
+}
+
+static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    size_t sample_count, expanded_len;
+    Uint8 *src;
+    Sint16 *dst;
+
+    if (chunk->length != chunk->size) {
+        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
+        if (file->sampleframes < 0) {
+            return -1;
+        }
+    }
+
+    /* Nothing to decode, nothing to return. */
+    if (file->sampleframes == 0) {
+        *audio_buf = NULL;
+        *audio_len = 0;
+        return 0;
+    }
+
+    sample_count = (size_t)file->sampleframes;
+    if (SafeMult(&sample_count, format->channels)) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    expanded_len = sample_count;
+    if (SafeMult(&expanded_len, sizeof(Sint16))) {
+        return SDL_SetError("WAVE file too big");
+    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    /* 1 to avoid allocating zero bytes, to keep static analysis happy. */
+    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
+    if (!src) {
+        return -1;
+    }
+    chunk->data = NULL;
+    chunk->size = 0;
+
+    dst = (Sint16 *)src;
+
+    /* `format` will inform the caller about the byte order. */
+    if (LAW_Convert(file->format.encoding, src, dst, sample_count) < 0) {
+        SDL_free(src);
+        return -1;
+    }
+
     *audio_buf = src;
     *audio_len = (Uint32)expanded_len;
 
@@ -1343,11 +1593,35 @@ static int PCM_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
+/* Shifts sample_count 24-bit samples in ptr to 32 bits. The buffer must be
+ * big enough for the expanded samples.
+ */
+static void PCM_ExpandSint24ToSint32(Uint8 *ptr, size_t sample_count)
+{
+    size_t i;
+
+    /* work from end to start, since we're expanding in-place. */
+    for (i = sample_count; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = ptr[o * 3];
+        b[2] = ptr[o * 3 + 1];
+        b[3] = ptr[o * 3 + 2];
+
+        ptr[o * 4 + 0] = b[0];
+        ptr[o * 4 + 1] = b[1];
+        ptr[o * 4 + 2] = b[2];
+        ptr[o * 4 + 3] = b[3];
+    }
+}
+
 static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1375,21 +1649,7 @@ static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    /* work from end to start, since we're expanding in-place. */
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24ToSint32(ptr, sample_count);
 
     return 0;
 }
@@ -1769,7 +2029,11 @@ static int WaveCheckFormat(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Finds the fmt and data chunks and checks the format. On success, the chunk
+ * in file describes the data chunk and endposition is set to the end of the
+ * WAVE data in the stream.
+ */
+static int WaveLoadHeaders(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1980,9 +2244,68 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
 
     WaveFreeChunkData(chunk);
 
-    /* Process data chunk. */
+    /* The caller reads or streams the data chunk. */
     *chunk = datachunk;
 
+    /* Setting up the specs. All unsupported formats were filtered out
+     * by the checks above.
+     */
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = 0;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        /* These can be easily stored in the byte order of the system. */
+        spec->format = SDL_AUDIO_S16;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LE;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LE;
+            break;
+        case 24: /* Has been shifted to 32 bits. */
+        case 32:
+            spec->format = SDL_AUDIO_S32LE;
+            break;
+        default:
+            /* Just in case something unexpected happened in the checks. */
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return 0;
+}
+
+static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+
+    if (WaveLoadHeaders(src, file, spec, &endposition) < 0) {
+        return -1;
+    }
+
     if (chunk->length > 0) {
         result = WaveReadChunkData(src, chunk);
         if (result == -1) {
@@ -2026,51 +2349,8 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = 0;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        /* These can be easily stored in the byte order of the system. */
-        spec->format = SDL_AUDIO_S16;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LE;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LE;
-            break;
-        case 24: /* Has been shifted to 32 bits. */
-        case 32:
-            spec->format = SDL_AUDIO_S32LE;
-            break;
-        default:
-            /* Just in case something unexpected happened in the checks. */
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
-    }
-
     /* Report the end position back to the cleanup code. */
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return 0;
 }
@@ -2127,3 +2407,386 @@ int SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32
     return SDL_LoadWAV_RW(SDL_RWFromFile(path, "rb"), 1, spec, audio_buf, audio_len);
 }
 
+
+/* Number of sample frames decoded at a time from PCM and companded data. */
+#define WAVE_STREAM_FRAMES 4096
+
+struct SDL_WaveStream
+{
+    SDL_RWops *src;
+    SDL_bool freesrc;
+    WaveFile file;        /* The chunk describes the data chunk, its data is never loaded. */
+    SDL_AudioSpec spec;
+    size_t framesize;     /* Size of a decoded sample frame in bytes. */
+    size_t blockframes;   /* Maximum number of sample frames in a decoded block. */
+    Sint64 frame;         /* First sample frame of the next block. */
+    Sint64 position;      /* Position of src after the last read, or -1 if unknown. */
+    Uint8 *input;         /* One ADPCM block and the channel states. NULL for other formats. */
+    Uint8 *output;        /* The decoded block. */
+    size_t outputpos;
+    size_t outputlen;
+    ADPCM_DecoderState state;
+    MS_ADPCM_ChannelState mscstate[2];
+};
+
+/* Recalculates the number of sample frames for a truncated data chunk. */
+static int WaveCalculateSampleFrames(WaveFile *file, size_t datalength)
+{
+    switch (file->format.encoding) {
+    case MS_ADPCM_CODE:
+        return MS_ADPCM_CalculateSampleFrames(file, datalength);
+    case IMA_ADPCM_CODE:
+        return IMA_ADPCM_CalculateSampleFrames(file, datalength);
+    default:
+        file->sampleframes = WaveAdjustToFactValue(file, datalength / file->format.blockalign);
+        if (file->sampleframes < 0) {
+            return -1;
+        }
+        return 0;
+    }
+}
+
+/* Decodes the block starting at wave->frame into the output buffer. The
+ * output buffer stays empty once all sample frames have been decoded.
+ */
+static int WaveStreamDecodeBlock(SDL_WaveStream *wave)
+{
+    WaveFile *file = &wave->file;
+    WaveFormat *format = &file->format;
+    ADPCM_DecoderState *state = &wave->state;
+    const SDL_bool strict = (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict);
+    Sint64 frames = file->sampleframes - wave->frame;
+    Sint64 decoded, offset;
+    size_t length, bytes;
+    int result;
+
+    wave->outputpos = 0;
+    wave->outputlen = 0;
+
+    if (frames <= 0) {
+        return 0;
+    } else if (frames > (Sint64)wave->blockframes) {
+        frames = (Sint64)wave->blockframes;
+    }
+
+    if (wave->input) {
+        /* ADPCM data is only decoded in whole blocks, wave->frame is always at a block start. */
+        offset = wave->frame / (Sint64)wave->blockframes * format->blockalign;
+        length = format->blockalign;
+        if ((Sint64)length > (Sint64)file->chunk.length - offset) {
+            length = (size_t)((Sint64)file->chunk.length - offset);
+        }
+    } else {
+        offset = wave->frame * format->blockalign;
+        length = (size_t)frames * format->blockalign;
+    }
+
+    if (wave->position != file->chunk.position + offset) {
+        if (SDL_RWseek(wave->src, file->chunk.position + offset, SDL_RW_SEEK_SET) != file->chunk.position + offset) {
+            wave->position = -1;
+            return SDL_SetError("Could not seek data of WAVE data chunk");
+        }
+    }
+    bytes = SDL_RWread(wave->src, wave->input ? wave->input : wave->output, length);
+    wave->position = file->chunk.position + offset + bytes;
+    if (bytes < length && wave->src->status == SDL_RWOPS_STATUS_ERROR) {
+        return -1;
+    }
+
+    if (wave->input) {
+        state->block.data = wave->input;
+        state->block.size = bytes;
+        state->block.pos = 0;
+        state->output.data = (Sint16 *)wave->output;
+        state->output.pos = 0;
+        state->framesleft = file->sampleframes - wave->frame;
+
+        /* A truncated block will stop the decoding, like in the whole file decoders. */
+        result = -1;
+        if (bytes >= state->blockheadersize) {
+            if (format->encoding == MS_ADPCM_CODE) {
+                if (MS_ADPCM_DecodeBlockHeader(state) < 0) {
+                    return -1;
+                }
+                result = MS_ADPCM_DecodeBlockData(state);
+            } else {
+                IMA_ADPCM_DecodeBlockHeader(state);
+                result = IMA_ADPCM_DecodeBlockData(state);
+            }
+        }
+        if (result == -1) {
+            if (strict) {
+                return SDL_SetError("Truncated data chunk");
+            } else if (file->trunchint != TruncDropFrame) {
+                state->output.pos = 0;
+            }
+        }
+
+        decoded = (Sint64)(state->output.pos / state->channels);
+        if (decoded > frames) {
+            decoded = frames;
+        }
+        if (result == -1) {
+            file->sampleframes = wave->frame + decoded;
+        }
+        wave->outputlen = (size_t)decoded * wave->framesize;
+    } else {
+        decoded = (Sint64)(bytes / format->blockalign);
+        if (decoded < frames) {
+            if (strict) {
+                return SDL_SetError("Could not read data of WAVE data chunk");
+            }
+            file->sampleframes = wave->frame + decoded;
+        }
+
+        bytes = (size_t)decoded * format->blockalign;
+        switch (format->encoding) {
+        case ALAW_CODE:
+        case MULAW_CODE:
+            if (LAW_Convert(format->encoding, wave->output, (Sint16 *)wave->output, bytes) < 0) {
+                return -1;
+            }
+            wave->outputlen = bytes * sizeof(Sint16);
+            break;
+        case PCM_CODE:
+            if (format->bitspersample == 24) {
+                PCM_ExpandSint24ToSint32(wave->output, bytes / 3);
+                wave->outputlen = bytes / 3 * sizeof(Sint32);
+                break;
+            }
+            SDL_FALLTHROUGH;
+        default:
+            wave->outputlen = bytes;
+            break;
+        }
+    }
+
+    wave->frame += decoded;
+
+    return 0;
+}
+
+SDL_WaveStream *SDL_OpenWaveStream(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec)
+{
+    SDL_WaveStream *wave = NULL;
+    WaveFile *file;
+    WaveChunk *chunk;
+    Sint64 endposition, size;
+    size_t outputsize;
+
+    /* Make sure we are passed a valid data source */
+    if (!src) {
+        goto done;  /* Error may come from RWops. */
+    } else if (!spec) {
+        SDL_InvalidParamError("spec");
+        goto done;
+    }
+
+    wave = (SDL_WaveStream *)SDL_calloc(1, sizeof(*wave));
+    if (!wave) {
+        goto done;
+    }
+    wave->src = src;
+    wave->freesrc = freesrc;
+    wave->position = -1;
+
+    file = &wave->file;
+    chunk = &file->chunk;
+    file->riffhint = WaveGetRiffSizeHint();
+    file->trunchint = WaveGetTruncationHint();
+    file->facthint = WaveGetFactChunkHint();
+
+    if (WaveLoadHeaders(src, file, &wave->spec, &endposition) < 0) {
+        goto failed;
+    }
+
+    /* The data chunk is read as the stream is decoded, so catch a truncated
+     * file now if the size of the stream is known.
+     */
+    size = SDL_RWsize(src);
+    if (size >= 0 && (Sint64)chunk->length > size - chunk->position) {
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            SDL_SetError("Could not read data of WAVE data chunk");
+            goto failed;
+        }
+        if (WaveCalculateSampleFrames(file, size > chunk->position ? (size_t)(size - chunk->position) : 0) < 0) {
+            goto failed;
+        }
+        chunk->length = size > chunk->position ? (Uint32)(size - chunk->position) : 0;
+    }
+
+    wave->framesize = SDL_AUDIO_FRAMESIZE(wave->spec);
+    switch (file->format.encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        wave->blockframes = file->format.samplesperblock;
+        wave->state.channels = file->format.channels;
+        wave->state.blocksize = file->format.blockalign;
+        wave->state.samplesperblock = file->format.samplesperblock;
+        wave->state.framesize = wave->state.channels * sizeof(Sint16);
+        wave->state.ddata = file->decoderdata;
+        wave->state.framestotal = file->sampleframes;
+        wave->state.output.size = wave->blockframes * wave->state.channels;
+
+        /* The IMA ADPCM channel states are stored after the block. */
+        wave->input = (Uint8 *)SDL_malloc((size_t)file->format.blockalign + wave->state.channels);
+        if (!wave->input) {
+            goto failed;
+        }
+        if (file->format.encoding == MS_ADPCM_CODE) {
+            wave->state.blockheadersize = (size_t)wave->state.channels * 7;
+            wave->state.cstate = wave->mscstate;
+        } else {
+            wave->state.blockheadersize = (size_t)wave->state.channels * 4;
+            wave->state.cstate = wave->input + file->format.blockalign;
+        }
+        break;
+    default:
+        wave->blockframes = WAVE_STREAM_FRAMES;
+        break;
+    }
+
+    /* The output buffer also holds the undecoded PCM and companded data,
+     * which is never bigger than the decoded data.
+     */
+    outputsize = wave->blockframes;
+    if (SafeMult(&outputsize, wave->framesize)) {
+        SDL_SetError("WAVE file too big");
+        goto failed;
+    }
+    wave->output = (Uint8 *)SDL_malloc(outputsize);
+    if (!wave->output) {
+        goto failed;
+    }
+
+    *spec = wave->spec;
+    return wave;
+
+failed:
+    wave->freesrc = SDL_FALSE;
+    SDL_CloseWaveStream(wave);
+    wave = NULL;
+done:
+    if (freesrc && src) {
+        SDL_RWclose(src);
+    }
+    return wave;
+}
+
+int SDL_ReadWaveStream(SDL_WaveStream *wave, void *buf, int len)
+{
+    int total = 0;
+
+    if (!wave) {
+        return SDL_InvalidParamError("wave");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    while (total < len) {
+        size_t amount = wave->outputlen - wave->outputpos;
+        if (amount == 0) {
+            if (WaveStreamDecodeBlock(wave) < 0) {
+                return total > 0 ? total : -1;
+            } else if (wave->outputlen == 0) {
+                break;  /* All of the data was decoded. */
+            }
+            amount = wave->outputlen;
+        }
+        if (amount > (size_t)(len - total)) {
+            amount = (size_t)(len - total);
+        }
+        SDL_memcpy((Uint8 *)buf + total, wave->output + wave->outputpos, amount);
+        wave->outputpos += amount;
+        total += (int)amount;
+    }
+
+    return total;
+}
+
+int SDL_SeekWaveStream(SDL_WaveStream *wave, Sint64 frame)
+{
+    Sint64 skip = 0;
+
+    if (!wave) {
+        return SDL_InvalidParamError("wave");
+    } else if (frame < 0 || frame > wave->file.sampleframes) {
+        return SDL_InvalidParamError("frame");
+    }
+
+    wave->outputpos = 0;
+    wave->outputlen = 0;
+
+    /* ADPCM blocks have to be decoded from the start. */
+    if (wave->input) {
+        skip = frame % (Sint64)wave->blockframes;
+        frame -= skip;
+    }
+    wave->frame = frame;
+
+    if (skip > 0) {
+        if (WaveStreamDecodeBlock(wave) < 0) {
+            return -1;
+        }
+        wave->outputpos = SDL_min(wave->outputlen, (size_t)skip * wave->framesize);
+    }
+
+    return 0;
+}
+
+static void SDLCALL WaveStreamGetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    SDL_WaveStream *wave = (SDL_WaveStream *)userdata;
+
+    (void)total_amount;
+
+    /* Hand over whole decoded blocks, the audio stream keeps what isn't needed yet. */
+    while (additional_amount > 0) {
+        int amount;
+
+        if (wave->outputpos == wave->outputlen) {
+            if (WaveStreamDecodeBlock(wave) < 0 || wave->outputlen == 0) {
+                break;
+            }
+        }
+
+        amount = (int)(wave->outputlen - wave->outputpos);
+        if (SDL_PutAudioStreamData(stream, wave->output + wave->outputpos, amount) < 0) {
+            break;
+        }
+        wave->outputpos = wave->outputlen;
+        additional_amount -= amount;
+    }
+}
+
+int SDL_SetAudioStreamWaveSource(SDL_AudioStream *stream, SDL_WaveStream *wave)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!wave) {
+        return SDL_SetAudioStreamGetCallback(stream, NULL, NULL);
+    }
+
+    if (SDL_SetAudioStreamFormat(stream, &wave->spec, NULL) < 0) {
+        return -1;
+    }
+    return SDL_SetAudioStreamGetCallback(stream, WaveStreamGetCallback, wave);
+}
+
+void SDL_CloseWaveStream(SDL_WaveStream *wave)
+{
+    if (!wave) {
+        return;
+    }
+
+    if (wave->freesrc) {
+        SDL_RWclose(wave->src);
+    }
+    WaveFreeChunkData(&wave->file.chunk);
+    SDL_free(wave->file.decoderdata);
+    SDL_free(wave->input);
+    SDL_free(wave->output);
+    SDL_free(wave);
+}
@@ -158,7 +158,7 @@ static int ManagementThreadPrepare(void)
         return -1;
     }
 
-    ManagementThreadLock = SDL_CreateMutex();
+    ManagementThreadLock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (!ManagementThreadLock) {
         WASAPI_PlatformDeinit();
         return -1;
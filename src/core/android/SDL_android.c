@@ -593,7 +593,7 @@ JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(nativeSetupJNI)(JNIEnv *env, jclass cl
      * (Eg. Java sending Touch events, while native code is destroying the main SDL_Window. )
      */
     if (!Android_ActivityMutex) {
-        Android_ActivityMutex = SDL_CreateMutex(); /* Could this be created twice if onCreate() is called a second time ? */
+        Android_ActivityMutex = SDL_CreateMutexNamed(SDL_LOCK_NAME); /* Could this be created twice if onCreate() is called a second time ? */
     }
 
     if (!Android_ActivityMutex) {
@@ -988,3 +988,30 @@
 #define SDL_wcsnstr SDL_wcsnstr_REAL
 #define SDL_SyncWindow SDL_SyncWindow_REAL
 #define SDL_GetGamepadSteamHandle SDL_GetGamepadSteamHandle_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_GetNumCoalescedEvents SDL_GetNumCoalescedEvents_REAL
+#define SDL_AddTimerNS SDL_AddTimerNS_REAL
+#define SDL_CreateJobPool SDL_CreateJobPool_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_WaitJobs SDL_WaitJobs_REAL
+#define SDL_ParallelFor SDL_ParallelFor_REAL
+#define SDL_SetJobPoolProfileCallback SDL_SetJobPoolProfileCallback_REAL
+#define SDL_DestroyJobPool SDL_DestroyJobPool_REAL
+#define SDL_GetLockStats SDL_GetLockStats_REAL
+#define SDL_LogLockStats SDL_LogLockStats_REAL
+#define SDL_ResetLockStats SDL_ResetLockStats_REAL
+#define SDL_SetRWBufferSize SDL_SetRWBufferSize_REAL
+#define SDL_GetRWRange SDL_GetRWRange_REAL
+#define SDL_LoadFileInto_RW SDL_LoadFileInto_RW_REAL
+#define SDL_CreateAsyncIOQueue SDL_CreateAsyncIOQueue_REAL
+#define SDL_ReadAsync SDL_ReadAsync_REAL
+#define SDL_GetAsyncIOResult SDL_GetAsyncIOResult_REAL
+#define SDL_WaitAsyncIOResult SDL_WaitAsyncIOResult_REAL
+#define SDL_DestroyAsyncIOQueue SDL_DestroyAsyncIOQueue_REAL
+#define SDL_RWreadv SDL_RWreadv_REAL
+#define SDL_RWwritev SDL_RWwritev_REAL
+#define SDL_OpenWaveStream SDL_OpenWaveStream_REAL
+#define SDL_ReadWaveStream SDL_ReadWaveStream_REAL
+#define SDL_SeekWaveStream SDL_SeekWaveStream_REAL
+#define SDL_SetAudioStreamWaveSource SDL_SetAudioStreamWaveSource_REAL
+#define SDL_CloseWaveStream SDL_CloseWaveStream_REAL
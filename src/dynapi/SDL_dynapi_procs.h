@@ -1013,3 +1013,30 @@ SDL_DYNAPI_PROC(char*,SDL_strnstr,(const char *a, const char *b, size_t c),(a,b,
 SDL_DYNAPI_PROC(wchar_t*,SDL_wcsnstr,(const wchar_t *a, const wchar_t *b, size_t c),(a,b,c),return)
 SDL_DYNAPI_PROC(int,SDL_SyncWindow,(SDL_Window *a),(a),return)
 SDL_DYNAPI_PROC(Uint64,SDL_GetGamepadSteamHandle,(SDL_Gamepad *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetNumCoalescedEvents,(void),(),return)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerNS,(Uint64 a, SDL_NSTimerCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_JobPool*,SDL_CreateJobPool,(int a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SubmitJob,(SDL_JobPool *a, SDL_JobFunction b, void *c, SDL_AtomicInt *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_WaitJobs,(SDL_JobPool *a, SDL_AtomicInt *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_ParallelFor,(SDL_JobPool *a, int b, int c, SDL_ParallelForFunction d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(int,SDL_SetJobPoolProfileCallback,(SDL_JobPool *a, SDL_JobProfileCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyJobPool,(SDL_JobPool *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetLockStats,(SDL_LockStats *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_LogLockStats,(void),(),)
+SDL_DYNAPI_PROC(void,SDL_ResetLockStats,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_SetRWBufferSize,(SDL_RWops *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(const void*,SDL_GetRWRange,(SDL_RWops *a, Sint64 b, size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_LoadFileInto_RW,(SDL_RWops *a, void *b, size_t c, size_t *d, SDL_bool e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOQueue*,SDL_CreateAsyncIOQueue,(int a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_ReadAsync,(SDL_AsyncIOQueue *a, SDL_RWops *b, Sint64 c, void *d, size_t e, SDL_AsyncIOCallback f, void *g),(a,b,c,d,e,f,g),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOResult *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_WaitAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOResult *b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
+SDL_DYNAPI_PROC(size_t,SDL_RWreadv,(SDL_RWops *a, const SDL_RWvec *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(size_t,SDL_RWwritev,(SDL_RWops *a, const SDL_RWvec *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_WaveStream*,SDL_OpenWaveStream,(SDL_RWops *a, SDL_bool b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_ReadWaveStream,(SDL_WaveStream *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SeekWaveStream,(SDL_WaveStream *a, Sint64 b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamWaveSource,(SDL_AudioStream *a, SDL_WaveStream *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_CloseWaveStream,(SDL_WaveStream *a),(a),)
@@ -32,6 +32,7 @@
 #ifndef SDL_SENSOR_DISABLED
 #include "../sensor/SDL_sensor_c.h"
 #endif
+#include "../thread/SDL_systhread.h"
 #include "../video/SDL_sysvideo.h"
 
 #undef SDL_PRIs64
@@ -61,7 +62,7 @@ static int SDL_event_watchers_count = 0;
 static SDL_bool SDL_event_watchers_dispatching = SDL_FALSE;
 static SDL_bool SDL_event_watchers_removed = SDL_FALSE;
 static SDL_AtomicInt SDL_sentinel_pending;
-static Uint32 SDL_last_event_id = 0;
+static SDL_AtomicInt SDL_last_event_id;
 
 typedef struct
 {
@@ -90,41 +91,86 @@ static struct
     SDL_EventEntry *free;
 } SDL_EventQ = { NULL, SDL_FALSE, { 0 }, 0, NULL, NULL, NULL };
 
-typedef struct SDL_EventMemory
+/* Events that are added without any filtering go into a lock-free ring, so
+   threads pushing events don't wait on each other or on the thread that's
+   polling for them. The ring is only read with SDL_EventQ.lock held, and
+   anything that needs to look at arbitrary events first moves the ring
+   contents to the end of the list, so everything in the list is older than
+   everything in the ring.
+ */
+#define SDL_EVENT_RING_SIZE 1024 /* must be a power of two */
+
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicInt sequence;
+    SDL_Event event;
+} SDL_EventRingSlot;
+
+static struct
+{
+    SDL_EventRingSlot *slots;
+    SDL_AtomicInt active;
+    SDL_AtomicInt producers; /* pushes in progress, so the ring isn't freed under them */
+    SDL_AtomicInt tail;      /* next slot to be claimed by a producer */
+    Uint32 head;             /* next slot to be read, protected by SDL_EventQ.lock */
+} SDL_EventRing;
+
+/* Event memory is carved out of blocks with a simple pointer bump. Each block
+   remembers the newest event it has memory for, so once the event queue has
+   moved past that event, the whole block can be released at once. */
+#define SDL_EVENT_MEMORY_BLOCK_SIZE 4096
+#define SDL_EVENT_MEMORY_ALIGNMENT  16
+
+typedef struct SDL_EventMemoryBlock
 {
     Uint32 eventID;
-    void *memory;
-    struct SDL_EventMemory *next;
-} SDL_EventMemory;
+    size_t size;
+    size_t used;
+    struct SDL_EventMemoryBlock *next;
+} SDL_EventMemoryBlock;
+
+/* The header is padded so the block data is aligned */
+#define SDL_EVENT_MEMORY_HEADER_SIZE ((sizeof(SDL_EventMemoryBlock) + (SDL_EVENT_MEMORY_ALIGNMENT - 1)) & ~(size_t)(SDL_EVENT_MEMORY_ALIGNMENT - 1))
 
 static SDL_Mutex *SDL_event_memory_lock;
-static SDL_EventMemory *SDL_event_memory_head;
-static SDL_EventMemory *SDL_event_memory_tail;
+static SDL_EventMemoryBlock *SDL_event_memory_head;
+static SDL_EventMemoryBlock *SDL_event_memory_tail;
 
 void *SDL_AllocateEventMemory(size_t size)
 {
-    void *memory = SDL_malloc(size);
-    if (!memory) {
+    SDL_EventMemoryBlock *block;
+    void *memory = NULL;
+
+    if (size > SDL_SIZE_MAX - SDL_EVENT_MEMORY_HEADER_SIZE - SDL_EVENT_MEMORY_ALIGNMENT) {
+        SDL_OutOfMemory();
         return NULL;
     }
+    size = (size + (SDL_EVENT_MEMORY_ALIGNMENT - 1)) & ~(size_t)(SDL_EVENT_MEMORY_ALIGNMENT - 1);
 
     SDL_LockMutex(SDL_event_memory_lock);
     {
-        SDL_EventMemory *entry = (SDL_EventMemory *)SDL_malloc(sizeof(*entry));
-        if (entry) {
-            entry->eventID = SDL_last_event_id;
-            entry->memory = memory;
-            entry->next = NULL;
-
-            if (SDL_event_memory_tail) {
-                SDL_event_memory_tail->next = entry;
-            } else {
-                SDL_event_memory_head = entry;
+        block = SDL_event_memory_tail;
+        if (!block || size > (block->size - block->used)) {
+            const size_t block_size = SDL_max(size, SDL_EVENT_MEMORY_BLOCK_SIZE - SDL_EVENT_MEMORY_HEADER_SIZE);
+
+            block = (SDL_EventMemoryBlock *)SDL_malloc(SDL_EVENT_MEMORY_HEADER_SIZE + block_size);
+            if (block) {
+                block->size = block_size;
+                block->used = 0;
+                block->next = NULL;
+
+                if (SDL_event_memory_tail) {
+                    SDL_event_memory_tail->next = block;
+                } else {
+                    SDL_event_memory_head = block;
+                }
+                SDL_event_memory_tail = block;
             }
-            SDL_event_memory_tail = entry;
-        } else {
-            SDL_free(memory);
-            memory = NULL;
+        }
+        if (block) {
+            block->eventID = (Uint32)SDL_AtomicGet(&SDL_last_event_id);
+            memory = (Uint8 *)block + SDL_EVENT_MEMORY_HEADER_SIZE + block->used;
+            block->used += size;
         }
     }
     SDL_UnlockMutex(SDL_event_memory_lock);
@@ -136,24 +182,28 @@ static void SDL_FlushEventMemory(Uint32 eventID)
 {
     SDL_LockMutex(SDL_event_memory_lock);
     {
-        if (SDL_event_memory_head) {
-            while (SDL_event_memory_head) {
-                SDL_EventMemory *entry = SDL_event_memory_head;
+        while (SDL_event_memory_head) {
+            SDL_EventMemoryBlock *block = SDL_event_memory_head;
 
-                if (eventID && (Sint32)(eventID - entry->eventID) < 0) {
-                    break;
-                }
-
-                /* If you crash here, your application has memory corruption
-                 * or freed memory in an event, which is no longer necessary.
-                 */
-                SDL_event_memory_head = entry->next;
-                SDL_free(entry->memory);
-                SDL_free(entry);
+            if (eventID && (Sint32)(eventID - block->eventID) < 0) {
+                break;
             }
-            if (!SDL_event_memory_head) {
-                SDL_event_memory_tail = NULL;
+
+            if (block == SDL_event_memory_tail && eventID &&
+                block->size == SDL_EVENT_MEMORY_BLOCK_SIZE - SDL_EVENT_MEMORY_HEADER_SIZE) {
+                /* Keep the last block around for the next events */
+                block->used = 0;
+                break;
             }
+
+            /* If you crash here, your application has memory corruption
+             * or freed memory in an event, which is no longer necessary.
+             */
+            SDL_event_memory_head = block->next;
+            SDL_free(block);
+        }
+        if (!SDL_event_memory_head) {
+            SDL_event_memory_tail = NULL;
         }
     }
     SDL_UnlockMutex(SDL_event_memory_lock);
@@ -186,6 +236,15 @@ static void SDLCALL SDL_PollSentinelChanged(void *userdata, const char *name, co
     SDL_SetEventEnabled(SDL_EVENT_POLL_SENTINEL, SDL_GetStringBoolean(hint, SDL_TRUE));
 }
 
+/* Whether motion, axis and sensor events are merged into queued ones, as defined in SDL_HINT_EVENT_COALESCING */
+static SDL_bool SDL_EventCoalescing = SDL_FALSE;
+static SDL_AtomicInt SDL_coalesced_events;
+
+static void SDLCALL SDL_EventCoalescingChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_EventCoalescing = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
 /**
  * Verbosity of logged events as defined in SDL_HINT_EVENT_LOGGING:
  *  - 0: (default) no logging
@@ -560,6 +619,11 @@ static void SDL_LogEvent(const SDL_Event *event)
                            event->sensor.data[3], event->sensor.data[4], event->sensor.data[5]);
         break;
 
+        SDL_EVENT_CASE(SDL_EVENT_ASYNC_IO_COMPLETE)
+        (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u queue=%p userdata=%p)",
+                           (uint)event->asyncio.timestamp, (void *)event->asyncio.queue, event->asyncio.userdata);
+        break;
+
 #undef SDL_EVENT_CASE
 
     case SDL_EVENT_POLL_SENTINEL:
@@ -581,6 +645,321 @@ static void SDL_LogEvent(const SDL_Event *event)
 #undef uint
 }
 
+static SDL_EventEntry *SDL_AllocEventEntry(void)
+{
+    SDL_EventEntry *entry;
+
+    if (SDL_EventQ.free == NULL) {
+        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
+    } else {
+        entry = SDL_EventQ.free;
+        SDL_EventQ.free = entry->next;
+    }
+    return entry;
+}
+
+static void SDL_FreeEventEntry(SDL_EventEntry *entry)
+{
+    entry->next = SDL_EventQ.free;
+    SDL_EventQ.free = entry;
+}
+
+/* Link an entry at the end of the list -- called with the queue locked */
+static void SDL_LinkEventEntry(SDL_EventEntry *entry)
+{
+    if (SDL_EventQ.tail) {
+        SDL_EventQ.tail->next = entry;
+        entry->prev = SDL_EventQ.tail;
+        SDL_EventQ.tail = entry;
+        entry->next = NULL;
+    } else {
+        SDL_assert(!SDL_EventQ.head);
+        SDL_EventQ.head = entry;
+        SDL_EventQ.tail = entry;
+        entry->prev = NULL;
+        entry->next = NULL;
+    }
+}
+
+static void SDL_UpdateMaxEventsSeen(void)
+{
+    const int count = SDL_AtomicGet(&SDL_EventQ.count);
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
+    }
+}
+
+static void SDL_StartEventRing(void)
+{
+    if (!SDL_EventRing.slots) {
+        int i;
+
+        SDL_EventRing.slots = (SDL_EventRingSlot *)SDL_malloc(SDL_EVENT_RING_SIZE * sizeof(*SDL_EventRing.slots));
+        if (!SDL_EventRing.slots) {
+            /* Everything will go through the list instead */
+            return;
+        }
+        for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+            SDL_AtomicSet(&SDL_EventRing.slots[i].sequence, i);
+        }
+        SDL_AtomicSet(&SDL_EventRing.tail, 0);
+        SDL_EventRing.head = 0;
+    }
+    SDL_AtomicSet(&SDL_EventRing.active, 1);
+}
+
+/* Called with the queue locked, after the ring contents have been moved to the list */
+static void SDL_StopEventRing(void)
+{
+    SDL_AtomicSet(&SDL_EventRing.active, 0);
+    while (SDL_AtomicGet(&SDL_EventRing.producers) > 0) {
+        SDL_CPUPauseInstruction();
+    }
+    SDL_free(SDL_EventRing.slots);
+    SDL_EventRing.slots = NULL;
+}
+
+/* Add an event to the ring without taking the queue lock.
+   Returns 1 if the event was added, or 0 if it needs to go through SDL_AddEvent() instead */
+static int SDL_PushEventRing(const SDL_Event *event)
+{
+    SDL_EventRingSlot *slot = NULL;
+    Uint32 pos;
+
+    SDL_AtomicIncRef(&SDL_EventRing.producers);
+    if (!SDL_AtomicGet(&SDL_EventRing.active) ||
+        SDL_AtomicGet(&SDL_EventQ.count) >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_AtomicDecRef(&SDL_EventRing.producers);
+        return 0;
+    }
+
+    pos = (Uint32)SDL_AtomicGet(&SDL_EventRing.tail);
+    for (;;) {
+        Sint32 diff;
+
+        slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+        diff = (Sint32)((Uint32)SDL_AtomicGet(&slot->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&SDL_EventRing.tail, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The ring is full */
+            SDL_AtomicDecRef(&SDL_EventRing.producers);
+            return 0;
+        }
+        pos = (Uint32)SDL_AtomicGet(&SDL_EventRing.tail);
+    }
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    SDL_copyp(&slot->event, event);
+    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
+    }
+    SDL_AtomicIncRef(&SDL_EventQ.count);
+    SDL_AtomicIncRef(&SDL_last_event_id);
+
+    /* Publish the event to the reader */
+    SDL_AtomicSet(&slot->sequence, (int)(pos + 1));
+
+    SDL_AtomicDecRef(&SDL_EventRing.producers);
+    return 1;
+}
+
+/* Look at the oldest event in the ring -- called with the queue locked */
+static SDL_Event *SDL_PeekEventRing(void)
+{
+    const Uint32 head = SDL_EventRing.head;
+    SDL_EventRingSlot *slot;
+
+    if (!SDL_EventRing.slots) {
+        return NULL;
+    }
+
+    slot = &SDL_EventRing.slots[head & (SDL_EVENT_RING_SIZE - 1)];
+    if ((Sint32)((Uint32)SDL_AtomicGet(&slot->sequence) - (head + 1)) < 0) {
+        /* Empty, or the next event hasn't been published yet */
+        return NULL;
+    }
+    return &slot->event;
+}
+
+/* Release the slot returned by SDL_PeekEventRing() -- called with the queue locked */
+static void SDL_SkipEventRing(void)
+{
+    const Uint32 head = SDL_EventRing.head;
+    SDL_EventRingSlot *slot = &SDL_EventRing.slots[head & (SDL_EVENT_RING_SIZE - 1)];
+
+    SDL_AtomicSet(&slot->sequence, (int)(head + SDL_EVENT_RING_SIZE));
+    SDL_EventRing.head = head + 1;
+}
+
+/* Take the oldest event out of the ring -- called with the queue locked.
+   This doesn't update the event counts, the event is still considered queued. */
+static SDL_bool SDL_PopEventRing(SDL_Event *event)
+{
+    const SDL_Event *next = SDL_PeekEventRing();
+
+    if (!next) {
+        return SDL_FALSE;
+    }
+    SDL_copyp(event, next);
+    SDL_SkipEventRing();
+    return SDL_TRUE;
+}
+
+/* Move the ring contents to the end of the list -- called with the queue locked.
+   If wait is SDL_TRUE, this waits for events that are in the middle of being
+   pushed, so that anything added to the list afterwards keeps its order. */
+static SDL_bool SDL_FlushEventRing(SDL_bool wait)
+{
+    const Uint32 end = (Uint32)SDL_AtomicGet(&SDL_EventRing.tail);
+
+    if (!SDL_EventRing.slots) {
+        return SDL_TRUE;
+    }
+
+    for (;;) {
+        SDL_EventEntry *entry = SDL_AllocEventEntry();
+        if (!entry) {
+            return SDL_FALSE;
+        }
+        if (SDL_PopEventRing(&entry->event)) {
+            SDL_LinkEventEntry(entry);
+            continue;
+        }
+        SDL_FreeEventEntry(entry);
+
+        if (wait && (Sint32)(end - SDL_EventRing.head) > 0) {
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+        return SDL_TRUE;
+    }
+}
+
+/* How far back to look for an event to merge with */
+#define SDL_COALESCE_SEARCH_LIMIT 16
+
+static SDL_bool SDL_IsCoalescableEvent(const SDL_Event *event)
+{
+    if (!SDL_EventCoalescing) {
+        return SDL_FALSE;
+    }
+
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+    case SDL_EVENT_PEN_MOTION:
+    case SDL_EVENT_GAMEPAD_SENSOR_UPDATE:
+    case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Merge an event into an unread one from the same device -- called with the queue locked.
+   Only a run of events of the same type at the end of the queue is searched,
+   so merging never moves an event past any other kind of event. */
+static SDL_bool SDL_CoalesceEvent(const SDL_Event *event)
+{
+    SDL_EventEntry *entry;
+    int searched = 0;
+
+    for (entry = SDL_EventQ.tail; entry && entry->event.type == event->type && searched < SDL_COALESCE_SEARCH_LIMIT; entry = entry->prev, ++searched) {
+        SDL_Event *queued = &entry->event;
+
+        switch (event->type) {
+        case SDL_EVENT_MOUSE_MOTION:
+            if (queued->motion.which == event->motion.which &&
+                queued->motion.windowID == event->motion.windowID &&
+                queued->motion.state == event->motion.state) {
+                const float xrel = queued->motion.xrel + event->motion.xrel;
+                const float yrel = queued->motion.yrel + event->motion.yrel;
+
+                SDL_copyp(&queued->motion, &event->motion);
+                queued->motion.xrel = xrel;
+                queued->motion.yrel = yrel;
+                return SDL_TRUE;
+            }
+            break;
+        case SDL_EVENT_PEN_MOTION:
+            if (queued->pmotion.which == event->pmotion.which &&
+                queued->pmotion.windowID == event->pmotion.windowID &&
+                queued->pmotion.pen_state == event->pmotion.pen_state) {
+                SDL_copyp(&queued->pmotion, &event->pmotion);
+                return SDL_TRUE;
+            }
+            break;
+        case SDL_EVENT_GAMEPAD_SENSOR_UPDATE:
+            if (queued->gsensor.which == event->gsensor.which &&
+                queued->gsensor.sensor == event->gsensor.sensor) {
+                SDL_copyp(&queued->gsensor, &event->gsensor);
+                return SDL_TRUE;
+            }
+            break;
+        case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+            if (queued->jaxis.which == event->jaxis.which &&
+                queued->jaxis.axis == event->jaxis.axis) {
+                SDL_copyp(&queued->jaxis, &event->jaxis);
+                return SDL_TRUE;
+            }
+            break;
+        default:
+            return SDL_FALSE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+/* Add an event to the end of the list -- called with the queue locked */
+static int SDL_AddEvent(SDL_Event *event)
+{
+    SDL_EventEntry *entry;
+    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
+
+    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_SetError("Event queue is full (%d events)", initial_count);
+        return 0;
+    }
+
+    /* Anything still in the ring was added before this event */
+    if (!SDL_FlushEventRing(SDL_TRUE)) {
+        return 0;
+    }
+
+    if (SDL_IsCoalescableEvent(event) && SDL_CoalesceEvent(event)) {
+        SDL_AtomicIncRef(&SDL_coalesced_events);
+        return 1;
+    }
+
+    entry = SDL_AllocEventEntry();
+    if (entry == NULL) {
+        return 0;
+    }
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    SDL_copyp(&entry->event, event);
+    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
+    }
+
+    SDL_LinkEventEntry(entry);
+
+    SDL_AtomicIncRef(&SDL_EventQ.count);
+    SDL_UpdateMaxEventsSeen();
+
+    SDL_AtomicIncRef(&SDL_last_event_id);
+
+    return 1;
+}
+
 void SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
@@ -597,6 +976,8 @@ void SDL_StopEventLoop(void)
     }
 
     /* Clean out EventQ */
+    SDL_FlushEventRing(SDL_FALSE);
+    SDL_StopEventRing();
     for (entry = SDL_EventQ.head; entry;) {
         SDL_EventEntry *next = entry->next;
         SDL_free(entry);
@@ -658,7 +1039,7 @@ int SDL_StartEventLoop(void)
     /* Create the lock and set ourselves active */
 #ifndef SDL_THREADS_DISABLED
     if (!SDL_EventQ.lock) {
-        SDL_EventQ.lock = SDL_CreateMutex();
+        SDL_EventQ.lock = SDL_CreateAdaptiveMutex(SDL_LOCK_NAME);
         if (SDL_EventQ.lock == NULL) {
             return -1;
         }
@@ -666,7 +1047,7 @@ int SDL_StartEventLoop(void)
     SDL_LockMutex(SDL_EventQ.lock);
 
     if (SDL_event_watchers_lock == NULL) {
-        SDL_event_watchers_lock = SDL_CreateMutex();
+        SDL_event_watchers_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         if (SDL_event_watchers_lock == NULL) {
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
@@ -674,7 +1055,7 @@ int SDL_StartEventLoop(void)
     }
 
     if (SDL_event_memory_lock == NULL) {
-        SDL_event_memory_lock = SDL_CreateMutex();
+        SDL_event_memory_lock = SDL_CreateAdaptiveMutex(SDL_LOCK_NAME);
         if (SDL_event_memory_lock == NULL) {
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
@@ -691,64 +1072,11 @@ int SDL_StartEventLoop(void)
 #endif
 
     SDL_EventQ.active = SDL_TRUE;
+    SDL_StartEventRing();
     SDL_UnlockMutex(SDL_EventQ.lock);
     return 0;
 }
 
-/* Add an event to the event queue -- called with the queue locked */
-static int SDL_AddEvent(SDL_Event *event)
-{
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
-    int final_count;
-
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
-    }
-
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
-        }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
-    }
-
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
-    }
-
-    SDL_copyp(&entry->event, event);
-    if (event->type == SDL_EVENT_POLL_SENTINEL) {
-        SDL_AtomicAdd(&SDL_sentinel_pending, 1);
-    }
-
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
-        entry->next = NULL;
-    } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
-        entry->prev = NULL;
-        entry->next = NULL;
-    }
-
-    final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
-    }
-
-    ++SDL_last_event_id;
-
-    return 1;
-}
-
 /* Remove an event from the queue -- called with the queue locked */
 static void SDL_CutEvent(SDL_EventEntry *entry)
 {
@@ -772,8 +1100,7 @@ static void SDL_CutEvent(SDL_EventEntry *entry)
         SDL_AtomicAdd(&SDL_sentinel_pending, -1);
     }
 
-    entry->next = SDL_EventQ.free;
-    SDL_EventQ.free = entry;
+    SDL_FreeEventEntry(entry);
     SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
     SDL_AtomicAdd(&SDL_EventQ.count, -1);
 }
@@ -808,6 +1135,20 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
     /* Lock the event queue */
     used = 0;
 
+    if (action == SDL_ADDEVENT) {
+        /* The common case doesn't need the lock at all */
+        while (used < numevents && !SDL_IsCoalescableEvent(&events[used]) &&
+               SDL_PushEventRing(&events[used])) {
+            ++used;
+        }
+        if (used == numevents) {
+            if (used > 0) {
+                SDL_SendWakeupEvent();
+            }
+            return used;
+        }
+    }
+
     SDL_LockMutex(SDL_EventQ.lock);
     {
         /* Don't look after we've quit */
@@ -817,20 +1158,59 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
                 SDL_SetError("The event system has been shut down");
             }
             SDL_UnlockMutex(SDL_EventQ.lock);
-            return -1;
+            return used > 0 ? used : -1;
         }
         if (action == SDL_ADDEVENT) {
-            for (i = 0; i < numevents; ++i) {
+            for (i = used; i < numevents; ++i) {
                 used += SDL_AddEvent(&events[i]);
             }
+        } else if (action == SDL_GETEVENT && events && !SDL_EventQ.head &&
+                   minType <= SDL_EVENT_FIRST && maxType >= SDL_EVENT_LAST) {
+            /* Nothing older in the list, take events straight from the ring */
+            const SDL_Event *next;
+
+            SDL_UpdateMaxEventsSeen();
+            while (used < numevents && (next = SDL_PeekEventRing()) != NULL) {
+                if (next->type == SDL_EVENT_POLL_SENTINEL && include_sentinel && used > 0 &&
+                    SDL_AtomicGet(&SDL_sentinel_pending) == 1) {
+                    /* Leave the end of the poll cycle for the next call */
+                    break;
+                }
+                SDL_copyp(&events[used], next);
+                SDL_SkipEventRing();
+                SDL_assert(SDL_AtomicGet(&SDL_EventQ.count) > 0);
+                SDL_AtomicAdd(&SDL_EventQ.count, -1);
+                if (events[used].type == SDL_EVENT_POLL_SENTINEL) {
+                    SDL_AtomicAdd(&SDL_sentinel_pending, -1);
+                    if (!include_sentinel) {
+                        continue;
+                    }
+                    if (SDL_AtomicGet(&SDL_sentinel_pending) > 0) {
+                        /* Skip it, there's another one pending */
+                        continue;
+                    }
+                    /* Reached the end of a poll cycle */
+                    ++used;
+                    break;
+                }
+                ++used;
+            }
         } else {
             SDL_EventEntry *entry, *next;
             Uint32 type;
 
+            SDL_FlushEventRing(SDL_FALSE);
+            SDL_UpdateMaxEventsSeen();
+
             for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
                 next = entry->next;
                 type = entry->event.type;
                 if (minType <= type && type <= maxType) {
+                    if (type == SDL_EVENT_POLL_SENTINEL && include_sentinel && used > 0 &&
+                        SDL_AtomicGet(&SDL_sentinel_pending) <= sentinels_expected + 1) {
+                        /* Leave the end of the poll cycle for the next call */
+                        break;
+                    }
                     if (events) {
                         SDL_copyp(&events[used], &entry->event);
 
@@ -851,6 +1231,9 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
                             /* Skip it, there's another one pending */
                             continue;
                         }
+                        /* Reached the end of a poll cycle */
+                        ++used;
+                        break;
                     }
                     ++used;
                 }
@@ -871,6 +1254,11 @@ int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_eventaction action,
     return SDL_PeepEventsInternal(events, numevents, action, minType, maxType, SDL_FALSE);
 }
 
+int SDL_GetNumCoalescedEvents(void)
+{
+    return SDL_AtomicGet(&SDL_coalesced_events);
+}
+
 SDL_bool SDL_HasEvent(Uint32 type)
 {
     return SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, type, type) > 0;
@@ -907,6 +1295,7 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
+        SDL_FlushEventRing(SDL_FALSE);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             type = entry->event.type;
@@ -926,7 +1315,7 @@ static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
     /* Free old event memory */
     /*SDL_FlushEventMemory(SDL_last_event_id - SDL_MAX_QUEUED_EVENTS);*/
     if (SDL_AtomicGet(&SDL_EventQ.count) == 0) {
-        SDL_FlushEventMemory(SDL_last_event_id);
+        SDL_FlushEventMemory((Uint32)SDL_AtomicGet(&SDL_last_event_id));
     }
 
     /* Release any keys held down from last frame */
@@ -983,6 +1372,33 @@ SDL_bool SDL_PollEvent(SDL_Event *event)
     return SDL_WaitEventTimeoutNS(event, 0);
 }
 
+int SDL_PollEvents(SDL_Event *events, int numevents)
+{
+    int result;
+
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents <= 0) {
+        return 0;
+    }
+
+    /* If there isn't a poll sentinel event pending, pump events and add one */
+    if (SDL_AtomicGet(&SDL_sentinel_pending) == 0) {
+        SDL_PumpEventsInternal(SDL_TRUE);
+    }
+
+    /* Take everything up to the end of the poll cycle in one go. The sentinel
+       is left in the queue if there are events before it, and only returned
+       by itself, like SDL_PollEvent() would. */
+    result = SDL_PeepEventsInternal(events, numevents, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST, SDL_TRUE);
+    if (result == 1 && events[0].type == SDL_EVENT_POLL_SENTINEL) {
+        /* Reached the end of a poll cycle */
+        return 0;
+    }
+    return result;
+}
+
 static SDL_bool SDL_events_need_periodic_poll(void)
 {
     SDL_bool need_periodic_poll = SDL_FALSE;
@@ -1335,6 +1751,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_FlushEventRing(SDL_FALSE);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1474,10 +1891,12 @@ int SDL_InitEvents(void)
 #ifndef SDL_SENSOR_DISABLED
     SDL_AddHintCallback(SDL_HINT_AUTO_UPDATE_SENSORS, SDL_AutoUpdateSensorsChanged, NULL);
 #endif
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     if (SDL_StartEventLoop() < 0) {
         SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+        SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
         return -1;
     }
 
@@ -1492,6 +1911,7 @@ void SDL_QuitEvents(void)
     SDL_StopEventLoop();
     SDL_DelHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
     SDL_DelHintCallback(SDL_HINT_AUTO_UPDATE_JOYSTICKS, SDL_AutoUpdateJoysticksChanged, NULL);
 #endif
@@ -825,7 +825,7 @@ void SDL_PenInit(void)
     SDL_AddHintCallback(SDL_HINT_PEN_DELAY_MOUSE_BUTTON,
                         SDL_PenUpdateHint, &pen_delay_mouse_button_mode);
 #ifndef SDL_THREADS_DISABLED
-    SDL_pen_access_lock = SDL_CreateMutex();
+    SDL_pen_access_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
 #endif
 }
 
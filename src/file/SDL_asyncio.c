@@ -0,0 +1,488 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* Asynchronous reads from SDL_RWops, serviced by a pool of I/O threads */
+
+#include "../thread/SDL_systhread.h"
+
+#ifdef HAVE_STDIO_H
+#include <stdio.h>
+#endif
+
+/* Files can be read at an offset without moving the stream */
+#if defined(HAVE_STDIO_H) && !defined(SDL_FILE_DISABLED) && \
+    (defined(__LINUX__) || defined(__APPLE__) || defined(__FREEBSD__) || defined(__NETBSD__) || defined(__OPENBSD__))
+#define SDL_ASYNCIO_PREAD
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+#if defined(__WIN32__) || defined(__GDK__) || defined(__WINRT__)
+#include "../core/windows/SDL_windows.h"
+#endif
+
+/* The default number of I/O threads, enough to keep a fast disk busy */
+#define SDL_ASYNCIO_DEFAULT_THREADS 4
+
+typedef struct SDL_AsyncIORequest
+{
+    SDL_AsyncIOResult result;
+    SDL_AsyncIOCallback callback;
+    struct SDL_AsyncIORequest *next;
+    struct SDL_AsyncIORequest *next_busy;
+} SDL_AsyncIORequest;
+
+struct SDL_AsyncIOQueue
+{
+    SDL_Mutex *lock;
+    SDL_Condition *request_cond;
+    SDL_Condition *result_cond;
+    SDL_AsyncIORequest *pending;
+    SDL_AsyncIORequest *pending_tail;
+    SDL_AsyncIORequest *results;
+    SDL_AsyncIORequest *results_tail;
+    int num_in_flight;
+    SDL_bool shutting_down;
+
+    /* Streams that can't be read at an offset are read one request at a time,
+       these are the requests reading them right now */
+    SDL_AsyncIORequest *busy_streams;
+    SDL_Condition *stream_cond;
+
+    int num_threads;
+    SDL_Thread **threads;
+};
+
+static size_t SDL_ReadMemoryAt(SDL_RWops *src, Sint64 offset, void *buffer, size_t size)
+{
+    const Sint64 length = src->hidden.mem.stop - src->hidden.mem.base;
+
+    if (offset >= length) {
+        return 0;
+    }
+    size = (size_t)SDL_min((Sint64)size, length - offset);
+    SDL_memcpy(buffer, src->hidden.mem.base + offset, size);
+    return size;
+}
+
+#ifdef SDL_ASYNCIO_PREAD
+static size_t SDL_ReadFileAt(SDL_RWops *src, Sint64 offset, void *buffer, size_t size, SDL_bool *failed)
+{
+    const int fd = fileno((FILE *)src->hidden.stdio.fp);
+    size_t total = 0;
+
+    while (total < size) {
+        ssize_t bytes = pread(fd, (Uint8 *)buffer + total, size - total, (off_t)(offset + total));
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            *failed = SDL_TRUE;
+            break;
+        }
+        if (bytes == 0) {
+            break;
+        }
+        total += (size_t)bytes;
+    }
+    return total;
+}
+#endif /* SDL_ASYNCIO_PREAD */
+
+#if defined(__WIN32__) || defined(__GDK__) || defined(__WINRT__)
+static size_t SDL_ReadWindowsFileAt(SDL_RWops *src, Sint64 offset, void *buffer, size_t size, SDL_bool *failed)
+{
+    size_t total = 0;
+
+    while (total < size) {
+        const DWORD chunk = (DWORD)SDL_min(size - total, 0x40000000);
+        OVERLAPPED overlapped;
+        DWORD bytes = 0;
+
+        SDL_zero(overlapped);
+        overlapped.Offset = (DWORD)((Uint64)(offset + total) & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)((Uint64)(offset + total) >> 32);
+        if (!ReadFile((HANDLE)src->hidden.windowsio.h, (Uint8 *)buffer + total, chunk, &bytes, &overlapped)) {
+            if (GetLastError() != ERROR_HANDLE_EOF) {
+                *failed = SDL_TRUE;
+            }
+            break;
+        }
+        if (bytes == 0) {
+            break;
+        }
+        total += bytes;
+    }
+    return total;
+}
+#endif /* __WIN32__ || __GDK__ || __WINRT__ */
+
+/* Wait until no other request is reading src, called with the queue unlocked */
+static void SDL_LockAsyncIOStream(SDL_AsyncIOQueue *queue, SDL_AsyncIORequest *request)
+{
+    SDL_AsyncIORequest *busy;
+
+    SDL_LockMutex(queue->lock);
+    busy = queue->busy_streams;
+    while (busy) {
+        if (busy->result.src == request->result.src) {
+            SDL_WaitCondition(queue->stream_cond, queue->lock);
+            busy = queue->busy_streams;
+        } else {
+            busy = busy->next_busy;
+        }
+    }
+    request->next_busy = queue->busy_streams;
+    queue->busy_streams = request;
+    SDL_UnlockMutex(queue->lock);
+}
+
+static void SDL_UnlockAsyncIOStream(SDL_AsyncIOQueue *queue, SDL_AsyncIORequest *request)
+{
+    SDL_AsyncIORequest **prev;
+
+    SDL_LockMutex(queue->lock);
+    for (prev = &queue->busy_streams; *prev; prev = &(*prev)->next_busy) {
+        if (*prev == request) {
+            *prev = request->next_busy;
+            break;
+        }
+    }
+    SDL_BroadcastCondition(queue->stream_cond);
+    SDL_UnlockMutex(queue->lock);
+}
+
+static size_t SDL_ReadStreamAt(SDL_AsyncIOQueue *queue, SDL_AsyncIORequest *request, SDL_bool *failed)
+{
+    SDL_RWops *src = request->result.src;
+    const Sint64 offset = request->result.offset;
+    Uint8 *buffer = (Uint8 *)request->result.buffer;
+    const size_t size = request->result.requested;
+    size_t total = 0;
+
+    SDL_LockAsyncIOStream(queue, request);
+    if (SDL_RWseek(src, offset, SDL_RW_SEEK_SET) != offset) {
+        *failed = SDL_TRUE;
+    } else {
+        while (total < size) {
+            size_t bytes = SDL_RWread(src, buffer + total, size - total);
+            if (bytes == 0) {
+                if (src->status == SDL_RWOPS_STATUS_ERROR) {
+                    *failed = SDL_TRUE;
+                }
+                break;
+            }
+            total += bytes;
+        }
+    }
+    SDL_UnlockAsyncIOStream(queue, request);
+
+    return total;
+}
+
+static void SDL_RunAsyncIORequest(SDL_AsyncIOQueue *queue, SDL_AsyncIORequest *request)
+{
+    SDL_AsyncIOResult *result = &request->result;
+    SDL_RWops *src = result->src;
+    SDL_bool failed = SDL_FALSE;
+
+    if (src->type == SDL_RWOPS_MEMORY || src->type == SDL_RWOPS_MEMORY_RO || src->type == SDL_RWOPS_MAPPED) {
+        result->bytes = SDL_ReadMemoryAt(src, result->offset, result->buffer, result->requested);
+#ifdef SDL_ASYNCIO_PREAD
+    } else if (src->type == SDL_RWOPS_STDFILE) {
+        result->bytes = SDL_ReadFileAt(src, result->offset, result->buffer, result->requested, &failed);
+#endif
+#if defined(__WIN32__) || defined(__GDK__) || defined(__WINRT__)
+    } else if (src->type == SDL_RWOPS_WINFILE) {
+        result->bytes = SDL_ReadWindowsFileAt(src, result->offset, result->buffer, result->requested, &failed);
+#endif
+    } else {
+        result->bytes = SDL_ReadStreamAt(queue, request, &failed);
+    }
+    result->status = failed ? SDL_ASYNCIO_FAILURE : SDL_ASYNCIO_COMPLETE;
+}
+
+/* Hand off a finished request, called with the queue unlocked */
+static void SDL_FinishAsyncIORequest(SDL_AsyncIOQueue *queue, SDL_AsyncIORequest *request)
+{
+    void *userdata;
+
+    if (request->callback) {
+        request->callback(&request->result);
+        SDL_free(request);
+
+        SDL_LockMutex(queue->lock);
+        --queue->num_in_flight;
+        SDL_BroadcastCondition(queue->result_cond);
+        SDL_UnlockMutex(queue->lock);
+        return;
+    }
+
+    /* Once the request is queued, a waiting thread may take and free it */
+    userdata = request->result.userdata;
+
+    SDL_LockMutex(queue->lock);
+    request->next = NULL;
+    if (queue->results_tail) {
+        queue->results_tail->next = request;
+    } else {
+        queue->results = request;
+    }
+    queue->results_tail = request;
+    SDL_BroadcastCondition(queue->result_cond);
+    SDL_UnlockMutex(queue->lock);
+
+    if (SDL_EventEnabled(SDL_EVENT_ASYNC_IO_COMPLETE)) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_ASYNC_IO_COMPLETE;
+        event.asyncio.queue = queue;
+        event.asyncio.userdata = userdata;
+        SDL_PushEvent(&event);
+    }
+}
+
+static int SDLCALL SDL_AsyncIOThread(void *data)
+{
+    SDL_AsyncIOQueue *queue = (SDL_AsyncIOQueue *)data;
+    SDL_AsyncIORequest *request;
+
+    SDL_LockMutex(queue->lock);
+    for (;;) {
+        while (!queue->pending && !queue->shutting_down) {
+            SDL_WaitCondition(queue->request_cond, queue->lock);
+        }
+
+        /* Requests that are already queued still run when shutting down */
+        request = queue->pending;
+        if (!request) {
+            break;
+        }
+        queue->pending = request->next;
+        if (!queue->pending) {
+            queue->pending_tail = NULL;
+        }
+        SDL_UnlockMutex(queue->lock);
+
+        SDL_RunAsyncIORequest(queue, request);
+        SDL_FinishAsyncIORequest(queue, request);
+
+        SDL_LockMutex(queue->lock);
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    return 0;
+}
+
+SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(int num_threads)
+{
+    SDL_AsyncIOQueue *queue;
+    int i;
+
+    if (num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+    if (num_threads == 0) {
+        num_threads = SDL_ASYNCIO_DEFAULT_THREADS;
+    }
+
+    queue = (SDL_AsyncIOQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+
+#ifndef SDL_THREADS_DISABLED
+    queue->lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
+    queue->stream_cond = SDL_CreateCondition();
+    queue->request_cond = SDL_CreateCondition();
+    queue->result_cond = SDL_CreateCondition();
+    queue->threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(*queue->threads));
+    if (!queue->lock || !queue->stream_cond || !queue->request_cond || !queue->result_cond || !queue->threads) {
+        SDL_DestroyAsyncIOQueue(queue);
+        return NULL;
+    }
+
+    for (i = 0; i < num_threads; ++i) {
+        char name[64];
+
+        (void)SDL_snprintf(name, sizeof(name), "SDLAsyncIO%d", i);
+        queue->threads[i] = SDL_CreateThreadInternal(SDL_AsyncIOThread, name, 0, queue);
+        if (!queue->threads[i]) {
+            SDL_DestroyAsyncIOQueue(queue);
+            return NULL;
+        }
+        ++queue->num_threads;
+    }
+#else
+    /* Requests are run as they are submitted */
+    (void)i;
+#endif /* !SDL_THREADS_DISABLED */
+
+    return queue;
+}
+
+int SDL_ReadAsync(SDL_AsyncIOQueue *queue, SDL_RWops *src, Sint64 offset, void *buffer, size_t size, SDL_AsyncIOCallback callback, void *userdata)
+{
+    SDL_AsyncIORequest *request;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+    if (offset < 0) {
+        return SDL_InvalidParamError("offset");
+    }
+    if (!buffer && size > 0) {
+        return SDL_InvalidParamError("buffer");
+    }
+
+    request = (SDL_AsyncIORequest *)SDL_calloc(1, sizeof(*request));
+    if (!request) {
+        return -1;
+    }
+    request->result.src = src;
+    request->result.offset = offset;
+    request->result.buffer = buffer;
+    request->result.requested = size;
+    request->result.userdata = userdata;
+    request->callback = callback;
+
+    SDL_LockMutex(queue->lock);
+    ++queue->num_in_flight;
+    if (queue->num_threads == 0) {
+        SDL_UnlockMutex(queue->lock);
+        SDL_RunAsyncIORequest(queue, request);
+        SDL_FinishAsyncIORequest(queue, request);
+        return 0;
+    }
+    if (queue->pending_tail) {
+        queue->pending_tail->next = request;
+    } else {
+        queue->pending = request;
+    }
+    queue->pending_tail = request;
+    SDL_SignalCondition(queue->request_cond);
+    SDL_UnlockMutex(queue->lock);
+
+    return 0;
+}
+
+/* Take the oldest result off the queue, called with the queue locked */
+static SDL_bool SDL_PopAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOResult *result)
+{
+    SDL_AsyncIORequest *request = queue->results;
+
+    if (!request) {
+        return SDL_FALSE;
+    }
+    queue->results = request->next;
+    if (!queue->results) {
+        queue->results_tail = NULL;
+    }
+    --queue->num_in_flight;
+
+    if (result) {
+        SDL_copyp(result, &request->result);
+    }
+    SDL_free(request);
+    return SDL_TRUE;
+}
+
+SDL_bool SDL_GetAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOResult *result)
+{
+    SDL_bool retval;
+
+    if (!queue) {
+        SDL_InvalidParamError("queue");
+        return SDL_FALSE;
+    }
+
+    SDL_LockMutex(queue->lock);
+    retval = SDL_PopAsyncIOResult(queue, result);
+    SDL_UnlockMutex(queue->lock);
+
+    return retval;
+}
+
+SDL_bool SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOResult *result, Sint32 timeoutMS)
+{
+    const Uint64 deadline = (timeoutMS > 0) ? SDL_GetTicks() + timeoutMS : 0;
+    SDL_bool retval;
+
+    if (!queue) {
+        SDL_InvalidParamError("queue");
+        return SDL_FALSE;
+    }
+
+    SDL_LockMutex(queue->lock);
+    for (;;) {
+        retval = SDL_PopAsyncIOResult(queue, result);
+        if (retval || queue->num_in_flight == 0 || queue->num_threads == 0) {
+            break;
+        }
+        if (timeoutMS > 0) {
+            const Uint64 now = SDL_GetTicks();
+            if (now >= deadline) {
+                break;
+            }
+            SDL_WaitConditionTimeout(queue->result_cond, queue->lock, (Sint32)(deadline - now));
+        } else if (SDL_WaitConditionTimeout(queue->result_cond, queue->lock, timeoutMS) == SDL_MUTEX_TIMEDOUT) {
+            break;
+        }
+    }
+    SDL_UnlockMutex(queue->lock);
+
+    return retval;
+}
+
+void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
+{
+    int i;
+
+    if (!queue) {
+        return;
+    }
+
+    if (queue->lock) {
+        SDL_LockMutex(queue->lock);
+        queue->shutting_down = SDL_TRUE;
+        SDL_BroadcastCondition(queue->request_cond);
+        SDL_UnlockMutex(queue->lock);
+    }
+    for (i = 0; i < queue->num_threads; ++i) {
+        SDL_WaitThread(queue->threads[i], NULL);
+    }
+
+    while (SDL_PopAsyncIOResult(queue, NULL)) {
+    }
+
+    SDL_free(queue->threads);
+    SDL_DestroyCondition(queue->result_cond);
+    SDL_DestroyCondition(queue->request_cond);
+    SDL_DestroyCondition(queue->stream_cond);
+    SDL_DestroyMutex(queue->lock);
+    SDL_free(queue);
+}
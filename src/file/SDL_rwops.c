@@ -47,6 +47,86 @@
 #include "../core/android/SDL_android.h"
 #endif
 
+/* Files opened read-only with "m" in the mode are memory-mapped */
+#if defined(HAVE_STDIO_H) && !defined(SDL_FILE_DISABLED) && \
+    (defined(__LINUX__) || defined(__FREEBSD__) || defined(__NETBSD__) || defined(__OPENBSD__))
+#define SDL_RWOPS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Large vectored reads and writes on files skip the stdio buffer */
+#if defined(HAVE_STDIO_H) && !defined(SDL_FILE_DISABLED) && \
+    (defined(__LINUX__) || defined(__FREEBSD__) || defined(__NETBSD__) || defined(__OPENBSD__))
+#define SDL_RWOPS_VECTORED
+#include <fcntl.h>
+#include <limits.h>
+#include <stddef.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+SDL_COMPILE_TIME_ASSERT(iovec_size, sizeof(struct iovec) == sizeof(SDL_RWvec));
+SDL_COMPILE_TIME_ASSERT(iovec_base, offsetof(struct iovec, iov_base) == offsetof(SDL_RWvec, data));
+SDL_COMPILE_TIME_ASSERT(iovec_len, offsetof(struct iovec, iov_len) == offsetof(SDL_RWvec, size));
+#endif
+
+/* The optional read-ahead buffer, see SDL_SetRWBufferSize()
+   This is allocated along with the data, so it isn't part of the public SDL_RWops layout.
+ */
+struct SDL_RWBuffer
+{
+    Uint8 *data;
+    size_t size;    /* The allocated size of data */
+    size_t pos;     /* The next byte in data to be read */
+    size_t len;     /* The number of valid bytes in data */
+    Sint64 offset;  /* The stream offset of data, or -1 if unknown */
+};
+
+static size_t SDL_GetRWvecSize(const SDL_RWvec *vec, int count)
+{
+    size_t total = 0;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        total += vec[i].size;
+    }
+    return total;
+}
+
+/* Read or write the buffers in turn with the stream's read or write method, starting skip bytes in */
+static size_t SDL_RWvecIO(SDL_RWops *context, const SDL_RWvec *vec, int count, size_t skip, SDL_bool write)
+{
+    size_t total = 0;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        Uint8 *data = (Uint8 *)vec[i].data;
+        size_t size = vec[i].size;
+        size_t bytes;
+
+        if (skip >= size) {
+            skip -= size;
+            continue;
+        }
+        data += skip;
+        size -= skip;
+        skip = 0;
+
+        if (write) {
+            bytes = context->write(context, data, size);
+        } else {
+            bytes = context->read(context, data, size);
+        }
+        total += bytes;
+        if (bytes < size) {
+            break;
+        }
+    }
+    return total;
+}
+
 #if defined(__WIN32__) || defined(__GDK__) || defined(__WINRT__)
 
 /* Functions to read/write Win32 API file pointers */
@@ -372,6 +452,71 @@ static size_t SDLCALL stdio_write(SDL_RWops *context, const void *ptr, size_t si
     return bytes;
 }
 
+#ifdef SDL_RWOPS_VECTORED
+/* Smaller transfers are cheaper to copy through the stdio buffer */
+#define STDIO_VECTORED_MIN_SIZE (64 * 1024)
+
+static size_t SDLCALL stdio_readv(SDL_RWops *context, const SDL_RWvec *vec, int count)
+{
+    FILE *fp = (FILE *)context->hidden.stdio.fp;
+    Sint64 pos;
+    ssize_t bytes;
+
+    if (count > IOV_MAX || SDL_GetRWvecSize(vec, count) < STDIO_VECTORED_MIN_SIZE) {
+        return SDL_RWvecIO(context, vec, count, 0, SDL_FALSE);
+    }
+
+    /* Drop the stdio buffer so the file descriptor is at the stream position */
+    if (fflush(fp) != 0 || (pos = ftell(fp)) < 0) {
+        SDL_Error(SDL_EFREAD);
+        return 0;
+    }
+    bytes = preadv(fileno(fp), (const struct iovec *)vec, count, (off_t)pos);
+    if (bytes < 0) {
+        SDL_Error(SDL_EFREAD);
+        return 0;
+    }
+    if (fseek(fp, (fseek_off_t)(pos + bytes), SEEK_SET) != 0) {
+        SDL_Error(SDL_EFSEEK);
+    }
+    return (size_t)bytes;
+}
+
+static size_t SDLCALL stdio_writev(SDL_RWops *context, const SDL_RWvec *vec, int count)
+{
+    FILE *fp = (FILE *)context->hidden.stdio.fp;
+    const size_t total = SDL_GetRWvecSize(vec, count);
+    Sint64 pos;
+    ssize_t bytes;
+
+    /* pwritev() ignores the offset on files opened for appending */
+    if (count > IOV_MAX || total < STDIO_VECTORED_MIN_SIZE || (fcntl(fileno(fp), F_GETFL) & O_APPEND)) {
+        return SDL_RWvecIO(context, vec, count, 0, SDL_TRUE);
+    }
+
+    /* Write out the stdio buffer so the file descriptor is at the stream position */
+    if (fflush(fp) != 0 || (pos = ftell(fp)) < 0) {
+        SDL_Error(SDL_EFWRITE);
+        return 0;
+    }
+    bytes = pwritev(fileno(fp), (const struct iovec *)vec, count, (off_t)pos);
+    if (bytes < 0) {
+        SDL_Error(SDL_EFWRITE);
+        return 0;
+    }
+    if (fseek(fp, (fseek_off_t)(pos + bytes), SEEK_SET) != 0) {
+        SDL_Error(SDL_EFSEEK);
+        return (size_t)bytes;
+    }
+
+    /* Large writes can be split by the system, finish them through stdio */
+    if ((size_t)bytes < total) {
+        bytes += SDL_RWvecIO(context, vec, count, (size_t)bytes, SDL_TRUE);
+    }
+    return (size_t)bytes;
+}
+#endif /* SDL_RWOPS_VECTORED */
+
 static int SDLCALL stdio_close(SDL_RWops *context)
 {
     int status = 0;
@@ -393,6 +538,10 @@ static SDL_RWops *SDL_RWFromFP(void *fp, SDL_bool autoclose)
         rwops->seek = stdio_seek;
         rwops->read = stdio_read;
         rwops->write = stdio_write;
+#ifdef SDL_RWOPS_VECTORED
+        rwops->readv = stdio_readv;
+        rwops->writev = stdio_writev;
+#endif
         rwops->close = stdio_close;
         rwops->hidden.stdio.fp = fp;
         rwops->hidden.stdio.autoclose = autoclose;
@@ -459,6 +608,50 @@ static size_t SDLCALL mem_write(SDL_RWops *context, const void *ptr, size_t size
 
 /* Functions to create SDL_RWops structures from various data sources */
 
+#ifdef SDL_RWOPS_MMAP
+static int SDLCALL mmap_close(SDL_RWops *context)
+{
+    munmap(context->hidden.mem.base, (size_t)(context->hidden.mem.stop - context->hidden.mem.base));
+    SDL_DestroyRW(context);
+    return 0;
+}
+
+/* Map a regular file for reading, or return NULL to open it normally */
+static SDL_RWops *SDL_RWFromMappedFile(const char *file)
+{
+    SDL_RWops *rwops;
+    struct stat st;
+    size_t size;
+    void *mem;
+    int fd;
+
+    fd = open(file, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) ||
+        st.st_size <= 0 || (Uint64)st.st_size > SDL_SIZE_MAX) {
+        close(fd);
+        return NULL;
+    }
+    size = (size_t)st.st_size;
+    mem = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+
+    rwops = SDL_RWFromConstMem(mem, size);
+    if (!rwops) {
+        munmap(mem, size);
+        return NULL;
+    }
+    rwops->close = mmap_close;
+    rwops->type = SDL_RWOPS_MAPPED;
+    return rwops;
+}
+#endif /* SDL_RWOPS_MMAP */
+
 SDL_RWops *SDL_RWFromFile(const char *file, const char *mode)
 {
     SDL_RWops *rwops = NULL;
@@ -528,6 +721,14 @@ SDL_RWops *SDL_RWFromFile(const char *file, const char *mode)
     rwops->type = SDL_RWOPS_WINFILE;
 #elif defined(HAVE_STDIO_H)
     {
+#ifdef SDL_RWOPS_MMAP
+        if (*mode == 'r' && SDL_strchr(mode, 'm') && !SDL_strchr(mode, '+')) {
+            rwops = SDL_RWFromMappedFile(file);
+            if (rwops) {
+                return rwops;
+            }
+        }
+#endif
 #if defined(__APPLE__) && !defined(SDL_FILE_DISABLED) // TODO: add dummy?
         FILE *fp = SDL_OpenFPFromBundleOrFallback(file, mode);
 #elif defined(__WINRT__)
@@ -618,15 +819,122 @@ SDL_RWops *SDL_CreateRW(void)
 void SDL_DestroyRW(SDL_RWops *context)
 {
     SDL_DestroyProperties(context->props);
+    SDL_free(context->buffer);
     SDL_free(context);
 }
 
+/* Drop the read-ahead buffer, seeking the stream back to the logical read position.
+   This fails and keeps the buffered data if the stream can't seek.
+ */
+static int SDL_DiscardRWBuffer(SDL_RWops *context)
+{
+    struct SDL_RWBuffer *buffer = context->buffer;
+    size_t remaining;
+
+    if (!buffer) {
+        return 0;
+    }
+
+    remaining = buffer->len - buffer->pos;
+    if (remaining > 0) {
+        Sint64 offset;
+
+        if (!context->seek) {
+            return SDL_Unsupported();
+        }
+        offset = context->seek(context, -(Sint64)remaining, SDL_RW_SEEK_CUR);
+        if (offset < 0) {
+            return -1;
+        }
+        buffer->offset = offset;
+    } else if (buffer->offset >= 0) {
+        buffer->offset += buffer->len;
+    }
+    buffer->pos = 0;
+    buffer->len = 0;
+    return 0;
+}
+
+int SDL_SetRWBufferSize(SDL_RWops *context, size_t size)
+{
+    struct SDL_RWBuffer *buffer = NULL;
+
+    if (!context) {
+        return SDL_InvalidParamError("context");
+    }
+    if (size == (context->buffer ? context->buffer->size : 0)) {
+        return 0;
+    }
+
+    if (SDL_DiscardRWBuffer(context) < 0) {
+        return -1;
+    }
+    if (size > 0) {
+        if (size > SDL_SIZE_MAX - sizeof(*buffer)) {
+            return SDL_OutOfMemory();
+        }
+        buffer = (struct SDL_RWBuffer *)SDL_malloc(sizeof(*buffer) + size);
+        if (!buffer) {
+            return -1;
+        }
+        buffer->data = (Uint8 *)(buffer + 1);
+        buffer->size = size;
+        buffer->pos = 0;
+        buffer->len = 0;
+        buffer->offset = -1;
+        if (context->seek) {
+            buffer->offset = context->seek(context, 0, SDL_RW_SEEK_CUR);
+            if (buffer->offset < 0) {
+                buffer->offset = -1;
+            }
+        }
+    }
+    SDL_free(context->buffer);
+    context->buffer = buffer;
+    return 0;
+}
+
+/* Read the rest of the read-ahead buffer and refill it, or read straight
+   from the stream if the request is bigger than the buffer.
+ */
+static size_t SDL_ReadRWBuffered(SDL_RWops *context, void *ptr, size_t size)
+{
+    struct SDL_RWBuffer *buffer = context->buffer;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t bytes, amount;
+
+    bytes = buffer->len - buffer->pos;
+    SDL_memcpy(dst, buffer->data + buffer->pos, bytes);
+    dst += bytes;
+    size -= bytes;
+
+    if (buffer->offset >= 0) {
+        buffer->offset += buffer->len;
+    }
+    buffer->pos = 0;
+    buffer->len = 0;
+
+    if (size >= buffer->size) {
+        amount = context->read(context, dst, size);
+        if (buffer->offset >= 0) {
+            buffer->offset += amount;
+        }
+        return bytes + amount;
+    }
+
+    buffer->len = context->read(context, buffer->data, buffer->size);
+    amount = SDL_min(size, buffer->len);
+    SDL_memcpy(dst, buffer->data, amount);
+    buffer->pos = amount;
+    return bytes + amount;
+}
+
 /* Load all the data from an SDL data stream */
 void *SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc)
 {
-    const int FILE_CHUNK_SIZE = 1024;
-    Sint64 size, size_total;
-    size_t size_read;
+    const size_t FILE_CHUNK_SIZE = 4096;
+    Sint64 size;
+    size_t size_total, size_read, capacity;
     char *data = NULL, *newdata;
     SDL_bool loading_chunks = SDL_FALSE;
 
@@ -637,37 +945,41 @@ void *SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc)
 
     size = SDL_RWsize(src);
     if (size < 0) {
-        size = FILE_CHUNK_SIZE;
+        capacity = FILE_CHUNK_SIZE;
         loading_chunks = SDL_TRUE;
-    }
-    if (size >= SDL_SIZE_MAX) {
+    } else if ((Uint64)size >= SDL_SIZE_MAX) {
         goto done;
+    } else {
+        capacity = (size_t)size;
     }
-    data = (char *)SDL_malloc((size_t)(size + 1));
+    data = (char *)SDL_malloc(capacity + 1);
     if (!data) {
         goto done;
     }
 
     size_total = 0;
     for (;;) {
-        if (loading_chunks) {
-            if ((size_total + FILE_CHUNK_SIZE) > size) {
-                size = (size_total + FILE_CHUNK_SIZE);
-                if (size >= SDL_SIZE_MAX) {
-                    newdata = NULL;
-                } else {
-                    newdata = SDL_realloc(data, (size_t)(size + 1));
-                }
-                if (!newdata) {
-                    SDL_free(data);
-                    data = NULL;
-                    goto done;
-                }
-                data = newdata;
+        if (size_total == capacity) {
+            if (!loading_chunks) {
+                break;
+            }
+
+            /* Double the buffer, so the total copy cost stays linear in the stream size */
+            if (capacity >= (SDL_SIZE_MAX - 1) / 2) {
+                newdata = NULL;
+            } else {
+                newdata = (char *)SDL_realloc(data, capacity * 2 + 1);
+            }
+            if (!newdata) {
+                SDL_free(data);
+                data = NULL;
+                goto done;
             }
+            data = newdata;
+            capacity *= 2;
         }
 
-        size_read = SDL_RWread(src, data + size_total, (size_t)(size - size_total));
+        size_read = SDL_RWread(src, data + size_total, capacity - size_total);
         if (size_read > 0) {
             size_total += size_read;
             continue;
@@ -677,8 +989,15 @@ void *SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize, SDL_bool freesrc)
         break;
     }
 
+    if (loading_chunks && size_total < capacity) {
+        newdata = (char *)SDL_realloc(data, size_total + 1);
+        if (newdata) {
+            data = newdata;
+        }
+    }
+
     if (datasize) {
-        *datasize = (size_t)size_total;
+        *datasize = size_total;
     }
     data[size_total] = '\0';
 
@@ -689,6 +1008,55 @@ done:
     return data;
 }
 
+int SDL_LoadFileInto_RW(SDL_RWops *src, void *buffer, size_t buffersize, size_t *datasize, SDL_bool freesrc)
+{
+    Sint64 size;
+    size_t size_total = 0, size_read;
+    Uint8 extra;
+    int result = 0;
+
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+    if (!buffer && buffersize > 0) {
+        result = SDL_InvalidParamError("buffer");
+        goto done;
+    }
+
+    size = SDL_RWsize(src);
+    if (size >= 0 && (Uint64)size > buffersize) {
+        if (datasize) {
+            *datasize = ((Uint64)size < SDL_SIZE_MAX) ? (size_t)size : SDL_SIZE_MAX;
+        }
+        result = SDL_SetError("Buffer is too small, %" SDL_PRIs64 " bytes needed", size);
+        goto done;
+    }
+
+    while (size_total < buffersize) {
+        size_read = SDL_RWread(src, (Uint8 *)buffer + size_total, buffersize - size_total);
+        if (size_read == 0) {
+            break;
+        }
+        size_total += size_read;
+    }
+
+    /* If we don't know how big the stream is, make sure we got all of it */
+    if (size < 0 && size_total == buffersize && SDL_RWread(src, &extra, sizeof(extra)) > 0) {
+        result = SDL_SetError("Buffer is too small");
+        goto done;
+    }
+
+    if (datasize) {
+        *datasize = size_total;
+    }
+
+done:
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return result;
+}
+
 void *SDL_LoadFile(const char *file, size_t *datasize)
 {
     return SDL_LoadFile_RW(SDL_RWFromFile(file, "rb"), datasize, SDL_TRUE);
@@ -707,6 +1075,29 @@ SDL_PropertiesID SDL_GetRWProperties(SDL_RWops *context)
     return context->props;
 }
 
+const void *SDL_GetRWRange(SDL_RWops *context, Sint64 offset, size_t size)
+{
+    Sint64 length;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return NULL;
+    }
+    if (context->type != SDL_RWOPS_MEMORY &&
+        context->type != SDL_RWOPS_MEMORY_RO &&
+        context->type != SDL_RWOPS_MAPPED) {
+        SDL_SetError("Stream isn't backed by memory");
+        return NULL;
+    }
+
+    length = context->hidden.mem.stop - context->hidden.mem.base;
+    if (offset < 0 || offset > length || size > (Uint64)(length - offset)) {
+        SDL_SetError("Range is outside of the stream");
+        return NULL;
+    }
+    return context->hidden.mem.base + offset;
+}
+
 Sint64 SDL_RWsize(SDL_RWops *context)
 {
     if (!context) {
@@ -729,13 +1120,45 @@ Sint64 SDL_RWsize(SDL_RWops *context)
 
 Sint64 SDL_RWseek(SDL_RWops *context, Sint64 offset, int whence)
 {
+    struct SDL_RWBuffer *buffer;
+    Sint64 result;
+
     if (!context) {
         return SDL_InvalidParamError("context");
     }
     if (!context->seek) {
         return SDL_Unsupported();
     }
-    return context->seek(context, offset, whence);
+
+    buffer = context->buffer;
+    if (buffer && buffer->len > 0) {
+        const Sint64 base = buffer->offset;
+
+        /* Seeks within the buffered data don't need to touch the stream */
+        if (base >= 0 && whence != SDL_RW_SEEK_END) {
+            Sint64 target = offset;
+            if (whence == SDL_RW_SEEK_CUR) {
+                target += base + (Sint64)buffer->pos;
+            }
+            if (target >= base && target <= base + (Sint64)buffer->len) {
+                buffer->pos = (size_t)(target - base);
+                return target;
+            }
+        }
+
+        /* The stream is ahead of the logical position by the unread data */
+        if (whence == SDL_RW_SEEK_CUR) {
+            offset -= (Sint64)(buffer->len - buffer->pos);
+        }
+        buffer->pos = 0;
+        buffer->len = 0;
+    }
+
+    result = context->seek(context, offset, whence);
+    if (buffer) {
+        buffer->offset = (result >= 0) ? result : -1;
+    }
+    return result;
 }
 
 Sint64 SDL_RWtell(SDL_RWops *context)
@@ -745,6 +1168,7 @@ Sint64 SDL_RWtell(SDL_RWops *context)
 
 size_t SDL_RWread(SDL_RWops *context, void *ptr, size_t size)
 {
+    struct SDL_RWBuffer *buffer;
     size_t bytes;
 
     if (!context) {
@@ -758,13 +1182,27 @@ size_t SDL_RWread(SDL_RWops *context, void *ptr, size_t size)
     }
 
     context->status = SDL_RWOPS_STATUS_READY;
-    SDL_ClearError();
 
     if (size == 0) {
+        SDL_ClearError();
         return 0;
     }
 
-    bytes = context->read(context, ptr, size);
+    /* Small reads are just a copy out of the read-ahead buffer */
+    buffer = context->buffer;
+    if (buffer && size <= buffer->len - buffer->pos) {
+        SDL_memcpy(ptr, buffer->data + buffer->pos, size);
+        buffer->pos += size;
+        return size;
+    }
+
+    SDL_ClearError();
+
+    if (buffer) {
+        bytes = SDL_ReadRWBuffered(context, ptr, size);
+    } else {
+        bytes = context->read(context, ptr, size);
+    }
     if (bytes == 0 && context->status == SDL_RWOPS_STATUS_READY) {
         if (*SDL_GetError()) {
             context->status = SDL_RWOPS_STATUS_ERROR;
@@ -789,6 +1227,11 @@ size_t SDL_RWwrite(SDL_RWops *context, const void *ptr, size_t size)
         return 0;
     }
 
+    /* Writes go where the application has read up to, if the stream can seek.
+       Otherwise reading and writing are independent, so the buffer is kept.
+     */
+    SDL_DiscardRWBuffer(context);
+
     context->status = SDL_RWOPS_STATUS_READY;
     SDL_ClearError();
 
@@ -800,6 +1243,102 @@ size_t SDL_RWwrite(SDL_RWops *context, const void *ptr, size_t size)
     if (bytes == 0 && context->status == SDL_RWOPS_STATUS_READY) {
         context->status = SDL_RWOPS_STATUS_ERROR;
     }
+    if (context->buffer && context->buffer->len == 0 && context->buffer->offset >= 0) {
+        context->buffer->offset += bytes;
+    }
+    return bytes;
+}
+
+size_t SDL_RWreadv(SDL_RWops *context, const SDL_RWvec *vec, int count)
+{
+    size_t bytes, total;
+    int i;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    }
+    if (count < 0 || (!vec && count > 0)) {
+        SDL_InvalidParamError("vec");
+        return 0;
+    }
+
+    /* Without a readv method, or with a read-ahead buffer, this is just a series of reads */
+    if (!context->readv || context->buffer) {
+        total = 0;
+        for (i = 0; i < count; ++i) {
+            bytes = SDL_RWread(context, vec[i].data, vec[i].size);
+            total += bytes;
+            if (bytes < vec[i].size) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    context->status = SDL_RWOPS_STATUS_READY;
+    SDL_ClearError();
+
+    total = SDL_GetRWvecSize(vec, count);
+    if (total == 0) {
+        return 0;
+    }
+
+    bytes = context->readv(context, vec, count);
+    if (bytes == 0 && context->status == SDL_RWOPS_STATUS_READY) {
+        if (*SDL_GetError()) {
+            context->status = SDL_RWOPS_STATUS_ERROR;
+        } else {
+            context->status = SDL_RWOPS_STATUS_EOF;
+        }
+    }
+    return bytes;
+}
+
+size_t SDL_RWwritev(SDL_RWops *context, const SDL_RWvec *vec, int count)
+{
+    size_t bytes, total;
+    int i;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return 0;
+    }
+    if (count < 0 || (!vec && count > 0)) {
+        SDL_InvalidParamError("vec");
+        return 0;
+    }
+
+    /* Without a writev method, this is just a series of writes */
+    if (!context->writev) {
+        total = 0;
+        for (i = 0; i < count; ++i) {
+            bytes = SDL_RWwrite(context, vec[i].data, vec[i].size);
+            total += bytes;
+            if (bytes < vec[i].size) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    SDL_DiscardRWBuffer(context);
+
+    context->status = SDL_RWOPS_STATUS_READY;
+    SDL_ClearError();
+
+    total = SDL_GetRWvecSize(vec, count);
+    if (total == 0) {
+        return 0;
+    }
+
+    bytes = context->writev(context, vec, count);
+    if (bytes < total && context->status == SDL_RWOPS_STATUS_READY) {
+        context->status = SDL_RWOPS_STATUS_ERROR;
+    }
+    if (context->buffer && context->buffer->len == 0 && context->buffer->offset >= 0) {
+        context->buffer->offset += bytes;
+    }
     return bytes;
 }
 
@@ -852,12 +1391,26 @@ int SDL_RWclose(SDL_RWops *context)
 
 /* Functions for dynamically reading and writing endian-specific values */
 
+/* Values are usually read from the read-ahead buffer, if there is one */
+SDL_FORCE_INLINE SDL_bool SDL_ReadValue(SDL_RWops *src, void *value, size_t size)
+{
+    struct SDL_RWBuffer *buffer = src ? src->buffer : NULL;
+
+    if (buffer && size <= buffer->len - buffer->pos) {
+        SDL_memcpy(value, buffer->data + buffer->pos, size);
+        buffer->pos += size;
+        src->status = SDL_RWOPS_STATUS_READY;
+        return SDL_TRUE;
+    }
+    return (SDL_RWread(src, value, size) == size);
+}
+
 SDL_bool SDL_ReadU8(SDL_RWops *src, Uint8 *value)
 {
     Uint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -871,7 +1424,7 @@ SDL_bool SDL_ReadU16LE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -890,7 +1443,7 @@ SDL_bool SDL_ReadU16BE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -909,7 +1462,7 @@ SDL_bool SDL_ReadU32LE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -928,7 +1481,7 @@ SDL_bool SDL_ReadU32BE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -947,7 +1500,7 @@ SDL_bool SDL_ReadU64LE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -966,7 +1519,7 @@ SDL_bool SDL_ReadU64BE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadValue(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
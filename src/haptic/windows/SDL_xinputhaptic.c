@@ -188,7 +188,7 @@ static int SDL_XINPUT_HapticOpenFromUserIndex(SDL_Haptic *haptic, const Uint8 us
     haptic->hwdata->bXInputHaptic = 1;
     haptic->hwdata->userid = userid;
 
-    haptic->hwdata->mutex = SDL_CreateMutex();
+    haptic->hwdata->mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (!haptic->hwdata->mutex) {
         SDL_free(haptic->effects);
         SDL_free(haptic->hwdata);
@@ -36,7 +36,7 @@ static int SDL_CreateThreadBarrier(SDL_ThreadBarrier *barrier, Uint32 count)
     SDL_assert(barrier != NULL);
     SDL_assert(count != 0);
 
-    barrier->mutex = SDL_CreateMutex();
+    barrier->mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (barrier->mutex == NULL) {
         return -1; /* Error set by CreateMutex */
     }
@@ -89,7 +89,7 @@ typedef struct
 
 static void hidapi_thread_state_init(hidapi_thread_state *state)
 {
-    state->mutex = SDL_CreateMutex();
+    state->mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     state->condition = SDL_CreateCondition();
     SDL_CreateThreadBarrier(&state->barrier, 2);
 }
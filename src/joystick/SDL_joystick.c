@@ -597,7 +597,7 @@ int SDL_InitJoysticks(void)
 
     /* Create the joystick list lock */
     if (SDL_joystick_lock == NULL) {
-        SDL_joystick_lock = SDL_CreateMutex();
+        SDL_joystick_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     }
 
 #ifndef SDL_EVENTS_DISABLED
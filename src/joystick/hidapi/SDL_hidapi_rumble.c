@@ -143,7 +143,7 @@ static void SDL_HIDAPI_StopRumbleThread(SDL_HIDAPI_RumbleContext *ctx)
 
 static int SDL_HIDAPI_StartRumbleThread(SDL_HIDAPI_RumbleContext *ctx)
 {
-    SDL_HIDAPI_rumble_lock = SDL_CreateMutex();
+    SDL_HIDAPI_rumble_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (!SDL_HIDAPI_rumble_lock) {
         SDL_HIDAPI_StopRumbleThread(ctx);
         return -1;
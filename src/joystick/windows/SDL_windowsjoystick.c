@@ -403,7 +403,7 @@ static int SDLCALL SDL_JoystickThread(void *_data)
 /* spin up the thread to detect hotplug of devices */
 static int SDL_StartJoystickThread(void)
 {
-    s_mutexJoyStickEnum = SDL_CreateMutex();
+    s_mutexJoyStickEnum = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (!s_mutexJoyStickEnum) {
         return -1;
     }
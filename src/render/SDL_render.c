@@ -26,6 +26,8 @@
 #include "software/SDL_render_sw_c.h"
 #include "../video/SDL_pixels_c.h"
 #include "../video/SDL_video_c.h"
+#include "../SDL_hints_c.h"
+#include "../SDL_properties_c.h"
 
 #ifdef __ANDROID__
 #include "../core/android/SDL_android.h"
@@ -45,6 +47,8 @@ this should probably be removed at some point in the future.  --ryan. */
 
 #define SDL_PROPERTY_WINDOW_RENDERER "SDL.internal.window.renderer"
 
+static SDL_PropertyKey SDL_window_renderer_key = SDL_PROPERTY_KEY_INIT(SDL_PROPERTY_WINDOW_RENDERER);
+
 #define CHECK_RENDERER_MAGIC(renderer, retval)                  \
     if (!(renderer) || (renderer)->magic != &SDL_renderer_magic) { \
         SDL_InvalidParamError("renderer");                      \
@@ -757,15 +761,16 @@ static SDL_INLINE void VerifyDrawQueueFunctions(const SDL_Renderer *renderer)
     SDL_assert(renderer->RunCommandQueue != NULL);
 }
 
+static int SDL_ParseRenderLineMethod(const char *hint, int default_value)
+{
+    return hint ? SDL_atoi(hint) : default_value;
+}
+
 static SDL_RenderLineMethod SDL_GetRenderLineMethod(void)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_LINE_METHOD);
+    static SDL_HintCache hint = SDL_HINT_CACHE_INIT(SDL_HINT_RENDER_LINE_METHOD, SDL_ParseRenderLineMethod, 0);
 
-    int method = 0;
-    if (hint) {
-        method = SDL_atoi(hint);
-    }
-    switch (method) {
+    switch (SDL_GetCachedHint(&hint)) {
     case 1:
         return SDL_RENDERLINEMETHOD_POINTS;
     case 2:
@@ -885,7 +890,7 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
 
     renderer->magic = &SDL_renderer_magic;
     renderer->window = window;
-    renderer->target_mutex = SDL_CreateMutex();
+    renderer->target_mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     renderer->main_view.viewport.w = -1;
     renderer->main_view.viewport.h = -1;
     renderer->main_view.scale.x = 1.0f;
@@ -971,7 +976,7 @@ SDL_Renderer *SDL_CreateSoftwareRenderer(SDL_Surface *surface)
     if (renderer) {
         VerifyDrawQueueFunctions(renderer);
         renderer->magic = &SDL_renderer_magic;
-        renderer->target_mutex = SDL_CreateMutex();
+        renderer->target_mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         renderer->main_view.pixel_w = surface->w;
         renderer->main_view.pixel_h = surface->h;
         renderer->main_view.viewport.w = -1;
@@ -999,7 +1004,7 @@ SDL_Renderer *SDL_CreateSoftwareRenderer(SDL_Surface *surface)
 
 SDL_Renderer *SDL_GetRenderer(SDL_Window *window)
 {
-    return (SDL_Renderer *)SDL_GetProperty(SDL_GetWindowProperties(window), SDL_PROPERTY_WINDOW_RENDERER, NULL);
+    return (SDL_Renderer *)SDL_GetPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_renderer_key, NULL);
 }
 
 SDL_Window *SDL_GetRenderWindow(SDL_Renderer *renderer)
@@ -1106,21 +1111,28 @@ static Uint32 GetClosestSupportedFormat(SDL_Renderer *renderer, Uint32 format)
     return renderer->info.texture_formats[0];
 }
 
-static SDL_ScaleMode SDL_GetScaleMode(void)
+static int SDL_ParseScaleMode(const char *hint, int default_value)
 {
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
-
-    if (!hint || SDL_strcasecmp(hint, "nearest") == 0) {
+    if (!hint) {
+        return default_value;
+    } else if (SDL_strcasecmp(hint, "nearest") == 0) {
         return SDL_SCALEMODE_NEAREST;
     } else if (SDL_strcasecmp(hint, "linear") == 0) {
         return SDL_SCALEMODE_LINEAR;
     } else if (SDL_strcasecmp(hint, "best") == 0) {
         return SDL_SCALEMODE_BEST;
     } else {
-        return (SDL_ScaleMode)SDL_atoi(hint);
+        return SDL_atoi(hint);
     }
 }
 
+static SDL_ScaleMode SDL_GetScaleMode(void)
+{
+    static SDL_HintCache hint = SDL_HINT_CACHE_INIT(SDL_HINT_RENDER_SCALE_QUALITY, SDL_ParseScaleMode, SDL_SCALEMODE_NEAREST);
+
+    return (SDL_ScaleMode)SDL_GetCachedHint(&hint);
+}
+
 SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
 {
     SDL_Texture *texture;
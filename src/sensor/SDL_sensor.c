@@ -129,7 +129,7 @@ int SDL_InitSensors(void)
 
     /* Create the sensor list lock */
     if (SDL_sensor_lock == NULL) {
-        SDL_sensor_lock = SDL_CreateMutex();
+        SDL_sensor_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     }
 
 #ifndef SDL_EVENTS_DISABLED
@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "../SDL_hints_c.h"
+
 #if defined(__WIN32__) || defined(__WINGDK__)
 #include "../core/windows/SDL_windows.h"
 #endif
@@ -37,7 +39,7 @@ static size_t SDL_envmemlen = 0;
 /* Put a variable into the environment */
 /* Note: Name may not contain a '=' character. (Reference: http://www.unix.com/man-page/Linux/3/setenv/) */
 #ifdef HAVE_SETENV
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_internal(const char *name, const char *value, int overwrite)
 {
     /* Input validation */
     if (!name || *name == '\0' || SDL_strchr(name, '=') != NULL || !value) {
@@ -47,7 +49,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
     return setenv(name, value, overwrite);
 }
 #elif defined(__WIN32__) || defined(__WINGDK__)
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_internal(const char *name, const char *value, int overwrite)
 {
     /* Input validation */
     if (!name || *name == '\0' || SDL_strchr(name, '=') != NULL || !value) {
@@ -66,7 +68,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
 }
 /* We have a real environment table, but no real setenv? Fake it w/ putenv. */
 #elif (defined(HAVE_GETENV) && defined(HAVE_PUTENV) && !defined(HAVE_SETENV))
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_internal(const char *name, const char *value, int overwrite)
 {
     size_t len;
     char *new_variable;
@@ -96,7 +98,7 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
 }
 #else /* roll our own */
 static char **SDL_env = (char **)0;
-int SDL_setenv(const char *name, const char *value, int overwrite)
+static int SDL_setenv_internal(const char *name, const char *value, int overwrite)
 {
     int added;
     size_t len, i;
@@ -159,6 +161,16 @@ int SDL_setenv(const char *name, const char *value, int overwrite)
 }
 #endif
 
+int SDL_setenv(const char *name, const char *value, int overwrite)
+{
+    const int result = SDL_setenv_internal(name, value, overwrite);
+    if (result == 0) {
+        /* Let the hints know they need to look at the environment again */
+        SDL_OnEnvironmentChanged();
+    }
+    return result;
+}
+
 /* Retrieve a variable named "name" from the environment */
 #ifdef HAVE_GETENV
 char *SDL_getenv(const char *name)
@@ -0,0 +1,621 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_thread_c.h"
+#include "SDL_systhread.h"
+
+/* A pool of worker threads, each with its own work-stealing deque of jobs.
+ *
+ * A worker pushes the jobs it submits onto the bottom of its own deque and
+ * takes them back from there, while idle threads steal from the top of other
+ * deques. Jobs submitted by threads outside the pool, or that don't fit in a
+ * deque, go on a shared queue.
+ */
+
+#define SDL_JOB_DEQUE_SIZE  1024 /* must be a power of two */
+#define SDL_JOB_MAX_WORKERS 64
+
+typedef struct SDL_Job
+{
+    SDL_JobFunction func;
+    void *userdata;
+    SDL_AtomicInt *counter;
+    struct SDL_Job *next;
+} SDL_Job;
+
+typedef struct SDL_JobDeque
+{
+    /* Stolen from by other threads */
+    SDL_AtomicInt top;
+
+    /* Padding to separate cache lines between threads */
+    char cache_pad[SDL_CACHELINE_SIZE];
+
+    /* Pushed and popped by the owning worker */
+    SDL_AtomicInt bottom;
+    void *jobs[SDL_JOB_DEQUE_SIZE];
+} SDL_JobDeque;
+
+typedef struct SDL_JobWorker
+{
+    SDL_JobPool *pool;
+    SDL_Thread *thread;
+    int index;
+    SDL_JobDeque deque;
+} SDL_JobWorker;
+
+struct SDL_JobPool
+{
+    SDL_JobWorker *workers;
+    int num_workers;
+
+    /* Jobs that have been submitted and not taken by a thread yet */
+    SDL_AtomicInt num_queued;
+
+    /* Shared queue for jobs submitted outside the pool */
+    SDL_SpinLock queue_lock;
+    SDL_Job *queue_head;
+    SDL_Job *queue_tail;
+
+    /* Job structures available for reuse */
+    SDL_SpinLock free_lock;
+    SDL_Job *free_jobs;
+
+    /* Idle threads sleep on this until jobs are queued or finish */
+    SDL_Mutex *lock;
+    SDL_Condition *wakeup;
+    SDL_AtomicInt num_sleeping;
+    SDL_AtomicInt quit;
+
+    SDL_JobProfileCallback profile_callback;
+    void *profile_userdata;
+};
+
+typedef struct SDL_ParallelForRange
+{
+    SDL_ParallelForFunction func;
+    void *userdata;
+    int start;
+    int end;
+} SDL_ParallelForRange;
+
+static SDL_JobPool *SDL_default_job_pool;
+static SDL_SpinLock SDL_default_job_pool_lock;
+
+/* The worker running on the current thread, if any */
+#ifdef SDL_THREAD_LOCAL
+static SDL_THREAD_LOCAL SDL_JobWorker *SDL_current_job_worker;
+#else
+static SDL_TLSID SDL_current_job_worker_tls;
+static SDL_SpinLock SDL_current_job_worker_tls_lock;
+#endif
+
+/* The deque positions only ever increase and are allowed to wrap */
+static int SDL_GetJobDequeSize(int top, int bottom)
+{
+    return (int)((unsigned int)bottom - (unsigned int)top);
+}
+
+static SDL_bool SDL_PushJob(SDL_JobDeque *deque, SDL_Job *job)
+{
+    const int bottom = SDL_AtomicGet(&deque->bottom);
+    const int top = SDL_AtomicGet(&deque->top);
+
+    if (SDL_GetJobDequeSize(top, bottom) >= SDL_JOB_DEQUE_SIZE) {
+        return SDL_FALSE;
+    }
+    SDL_AtomicSetPtr(&deque->jobs[bottom & (SDL_JOB_DEQUE_SIZE - 1)], job);
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&deque->bottom, (int)((unsigned int)bottom + 1));
+    return SDL_TRUE;
+}
+
+static SDL_Job *SDL_PopJob(SDL_JobDeque *deque)
+{
+    /* The add is a full barrier, so thieves see the new bottom before we read top */
+    const int bottom = (int)((unsigned int)SDL_AtomicAdd(&deque->bottom, -1) - 1);
+    const int top = SDL_AtomicGet(&deque->top);
+    const int size = SDL_GetJobDequeSize(top, bottom);
+    SDL_Job *job = NULL;
+
+    if (size >= 0) {
+        job = (SDL_Job *)SDL_AtomicGetPtr(&deque->jobs[bottom & (SDL_JOB_DEQUE_SIZE - 1)]);
+        if (size > 0) {
+            return job;
+        }
+
+        /* This is the last job, race any thieves for it */
+        if (!SDL_AtomicCAS(&deque->top, top, (int)((unsigned int)top + 1))) {
+            job = NULL;
+        }
+    }
+    SDL_AtomicSet(&deque->bottom, (int)((unsigned int)bottom + 1));
+    return job;
+}
+
+static SDL_Job *SDL_StealJob(SDL_JobDeque *deque)
+{
+    const int top = SDL_AtomicGet(&deque->top);
+    int bottom;
+    SDL_Job *job;
+
+    SDL_MemoryBarrierAcquire();
+    bottom = SDL_AtomicGet(&deque->bottom);
+    if (SDL_GetJobDequeSize(top, bottom) <= 0) {
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_AtomicGetPtr(&deque->jobs[top & (SDL_JOB_DEQUE_SIZE - 1)]);
+    if (!SDL_AtomicCAS(&deque->top, top, (int)((unsigned int)top + 1))) {
+        /* Another thread took it first */
+        return NULL;
+    }
+    return job;
+}
+
+static SDL_JobPool *SDL_GetJobPool(SDL_JobPool *pool)
+{
+    if (!pool) {
+        SDL_AtomicLockNamed(&SDL_default_job_pool_lock, SDL_LOCK_NAME);
+        if (!SDL_default_job_pool) {
+            SDL_default_job_pool = SDL_CreateJobPool(0);
+        }
+        pool = SDL_default_job_pool;
+        SDL_AtomicUnlock(&SDL_default_job_pool_lock);
+    }
+    return pool;
+}
+
+static void SDL_SetCurrentJobWorker(SDL_JobWorker *worker)
+{
+#ifdef SDL_THREAD_LOCAL
+    SDL_current_job_worker = worker;
+#else
+    SDL_SetTLS(SDL_current_job_worker_tls, worker, NULL);
+#endif
+}
+
+static SDL_JobWorker *SDL_GetCurrentJobWorker(SDL_JobPool *pool)
+{
+    SDL_JobWorker *worker;
+
+#ifdef SDL_THREAD_LOCAL
+    worker = SDL_current_job_worker;
+#else
+    worker = (SDL_JobWorker *)SDL_GetTLS(SDL_current_job_worker_tls);
+#endif
+    if (worker && worker->pool == pool) {
+        return worker;
+    }
+    return NULL;
+}
+
+static SDL_Job *SDL_AllocJob(SDL_JobPool *pool)
+{
+    SDL_Job *job;
+
+    SDL_AtomicLockNamed(&pool->free_lock, SDL_LOCK_NAME);
+    job = pool->free_jobs;
+    if (job) {
+        pool->free_jobs = job->next;
+    }
+    SDL_AtomicUnlock(&pool->free_lock);
+
+    if (!job) {
+        job = (SDL_Job *)SDL_malloc(sizeof(*job));
+    }
+    return job;
+}
+
+static void SDL_FreeJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    SDL_AtomicLockNamed(&pool->free_lock, SDL_LOCK_NAME);
+    job->next = pool->free_jobs;
+    pool->free_jobs = job;
+    SDL_AtomicUnlock(&pool->free_lock);
+}
+
+static void SDL_WakeJobThreads(SDL_JobPool *pool, SDL_bool all)
+{
+    /* The caller changed state with a full barrier before this check, and
+       sleepers check that state after announcing themselves, so either we
+       see them here or they see the change and don't go to sleep.
+     */
+    if (SDL_AtomicGet(&pool->num_sleeping) > 0) {
+        SDL_LockMutex(pool->lock);
+        if (all) {
+            SDL_BroadcastCondition(pool->wakeup);
+        } else {
+            SDL_SignalCondition(pool->wakeup);
+        }
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+static void SDL_QueueJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    SDL_JobWorker *worker = SDL_GetCurrentJobWorker(pool);
+
+    SDL_AtomicIncRef(&pool->num_queued);
+
+    if (!worker || !SDL_PushJob(&worker->deque, job)) {
+        job->next = NULL;
+        SDL_AtomicLockNamed(&pool->queue_lock, SDL_LOCK_NAME);
+        if (pool->queue_tail) {
+            pool->queue_tail->next = job;
+        } else {
+            pool->queue_head = job;
+        }
+        pool->queue_tail = job;
+        SDL_AtomicUnlock(&pool->queue_lock);
+    }
+
+    SDL_WakeJobThreads(pool, SDL_FALSE);
+}
+
+static SDL_Job *SDL_TakeJob(SDL_JobPool *pool, SDL_JobWorker *worker)
+{
+    SDL_Job *job = NULL;
+    int i, start;
+
+    if (SDL_AtomicGet(&pool->num_queued) <= 0) {
+        return NULL;
+    }
+
+    if (worker) {
+        job = SDL_PopJob(&worker->deque);
+    }
+
+    if (!job && pool->queue_head) {
+        SDL_AtomicLockNamed(&pool->queue_lock, SDL_LOCK_NAME);
+        job = pool->queue_head;
+        if (job) {
+            pool->queue_head = job->next;
+            if (!pool->queue_head) {
+                pool->queue_tail = NULL;
+            }
+        }
+        SDL_AtomicUnlock(&pool->queue_lock);
+    }
+
+    if (!job) {
+        start = worker ? worker->index + 1 : 0;
+        for (i = 0; i < pool->num_workers && !job; ++i) {
+            SDL_JobWorker *victim = &pool->workers[(start + i) % pool->num_workers];
+            if (victim != worker) {
+                job = SDL_StealJob(&victim->deque);
+            }
+        }
+    }
+
+    if (job) {
+        SDL_AtomicAdd(&pool->num_queued, -1);
+    }
+    return job;
+}
+
+static void SDL_RunJob(SDL_JobPool *pool, SDL_JobFunction func, void *userdata, SDL_AtomicInt *counter, int worker)
+{
+    if (pool->profile_callback) {
+        const Uint64 start = SDL_GetTicksNS();
+        func(userdata);
+        pool->profile_callback(pool->profile_userdata, func, userdata, worker, start, SDL_GetTicksNS());
+    } else {
+        func(userdata);
+    }
+
+    if (counter && SDL_AtomicDecRef(counter)) {
+        /* Wake up anyone waiting for this group of jobs */
+        SDL_WakeJobThreads(pool, SDL_TRUE);
+    }
+}
+
+static void SDL_RunQueuedJob(SDL_JobPool *pool, SDL_Job *job, SDL_JobWorker *worker)
+{
+    SDL_JobFunction func = job->func;
+    void *userdata = job->userdata;
+    SDL_AtomicInt *counter = job->counter;
+
+    SDL_FreeJob(pool, job);
+    SDL_RunJob(pool, func, userdata, counter, worker ? worker->index : -1);
+}
+
+static int SDLCALL SDL_JobWorkerThread(void *data)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)data;
+    SDL_JobPool *pool = worker->pool;
+    SDL_Job *job;
+
+    SDL_SetCurrentJobWorker(worker);
+
+    for (;;) {
+        job = SDL_TakeJob(pool, worker);
+        if (job) {
+            SDL_RunQueuedJob(pool, job, worker);
+            continue;
+        }
+
+        if (SDL_AtomicGet(&pool->quit)) {
+            break;
+        }
+
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicIncRef(&pool->num_sleeping);
+        while (SDL_AtomicGet(&pool->num_queued) <= 0 && !SDL_AtomicGet(&pool->quit)) {
+            SDL_WaitCondition(pool->wakeup, pool->lock);
+        }
+        SDL_AtomicDecRef(&pool->num_sleeping);
+        SDL_UnlockMutex(pool->lock);
+    }
+    return 0;
+}
+
+SDL_JobPool *SDL_CreateJobPool(int num_threads)
+{
+    SDL_JobPool *pool;
+    int i;
+
+    if (num_threads < 0) {
+        SDL_InvalidParamError("num_threads");
+        return NULL;
+    }
+
+#ifdef SDL_THREADS_DISABLED
+    num_threads = 0;
+#else
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount() - 1;
+    }
+    num_threads = SDL_min(num_threads, SDL_JOB_MAX_WORKERS);
+#endif
+
+    pool = (SDL_JobPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+#ifndef SDL_THREAD_LOCAL
+    if (num_threads > 0 && !SDL_current_job_worker_tls) {
+        SDL_AtomicLockNamed(&SDL_current_job_worker_tls_lock, SDL_LOCK_NAME);
+        if (!SDL_current_job_worker_tls) {
+            SDL_current_job_worker_tls = SDL_CreateTLS();
+        }
+        SDL_AtomicUnlock(&SDL_current_job_worker_tls_lock);
+    }
+#endif
+
+    if (num_threads > 0) {
+        pool->workers = (SDL_JobWorker *)SDL_calloc(num_threads, sizeof(*pool->workers));
+        pool->lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
+        pool->wakeup = SDL_CreateCondition();
+        if (!pool->workers || !pool->lock || !pool->wakeup) {
+            SDL_DestroyJobPool(pool);
+            return NULL;
+        }
+
+        for (i = 0; i < num_threads; ++i) {
+            SDL_JobWorker *worker = &pool->workers[i];
+
+            worker->pool = pool;
+            worker->index = i;
+            worker->thread = SDL_CreateThreadInternal(SDL_JobWorkerThread, "SDLJobs", 0, worker);
+            if (!worker->thread) {
+                SDL_DestroyJobPool(pool);
+                return NULL;
+            }
+            ++pool->num_workers;
+        }
+    }
+    return pool;
+}
+
+int SDL_SubmitJob(SDL_JobPool *pool, SDL_JobFunction func, void *userdata, SDL_AtomicInt *counter)
+{
+    SDL_Job *job;
+
+    if (!func) {
+        return SDL_InvalidParamError("func");
+    }
+
+    pool = SDL_GetJobPool(pool);
+    if (!pool) {
+        return -1;
+    }
+
+    if (counter) {
+        SDL_AtomicIncRef(counter);
+    }
+
+    if (pool->num_workers == 0) {
+        SDL_RunJob(pool, func, userdata, counter, -1);
+        return 0;
+    }
+
+    job = SDL_AllocJob(pool);
+    if (!job) {
+        if (counter) {
+            SDL_AtomicDecRef(counter);
+        }
+        return -1;
+    }
+    job->func = func;
+    job->userdata = userdata;
+    job->counter = counter;
+
+    SDL_QueueJob(pool, job);
+    return 0;
+}
+
+int SDL_WaitJobs(SDL_JobPool *pool, SDL_AtomicInt *counter)
+{
+    SDL_JobWorker *worker;
+    SDL_Job *job;
+
+    if (!counter) {
+        return SDL_InvalidParamError("counter");
+    }
+
+    pool = SDL_GetJobPool(pool);
+    if (!pool) {
+        return -1;
+    }
+
+    worker = SDL_GetCurrentJobWorker(pool);
+    while (SDL_AtomicGet(counter) > 0) {
+        job = SDL_TakeJob(pool, worker);
+        if (job) {
+            SDL_RunQueuedJob(pool, job, worker);
+            continue;
+        }
+
+        /* The remaining jobs are running on other threads */
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicIncRef(&pool->num_sleeping);
+        while (SDL_AtomicGet(counter) > 0 && SDL_AtomicGet(&pool->num_queued) <= 0) {
+            SDL_WaitCondition(pool->wakeup, pool->lock);
+        }
+        SDL_AtomicDecRef(&pool->num_sleeping);
+        SDL_UnlockMutex(pool->lock);
+    }
+    return 0;
+}
+
+static void SDLCALL SDL_RunParallelForRange(void *data)
+{
+    SDL_ParallelForRange *range = (SDL_ParallelForRange *)data;
+
+    range->func(range->userdata, range->start, range->end);
+}
+
+int SDL_ParallelFor(SDL_JobPool *pool, int count, int grain, SDL_ParallelForFunction func, void *userdata)
+{
+    SDL_ParallelForRange *ranges;
+    SDL_AtomicInt counter;
+    int i, num_ranges;
+
+    if (!func) {
+        return SDL_InvalidParamError("func");
+    }
+    if (count <= 0) {
+        return 0;
+    }
+
+    pool = SDL_GetJobPool(pool);
+    if (!pool) {
+        return -1;
+    }
+
+    if (grain <= 0) {
+        /* A few ranges per thread, so faster threads can steal from slower ones */
+        grain = SDL_max(count / ((pool->num_workers + 1) * 4), 1);
+    }
+    num_ranges = (count / grain) + ((count % grain) ? 1 : 0);
+
+    if (num_ranges == 1 || pool->num_workers == 0) {
+        func(userdata, 0, count);
+        return 0;
+    }
+
+    ranges = (SDL_ParallelForRange *)SDL_malloc(num_ranges * sizeof(*ranges));
+    if (!ranges) {
+        return -1;
+    }
+    for (i = 0; i < num_ranges; ++i) {
+        ranges[i].func = func;
+        ranges[i].userdata = userdata;
+        ranges[i].start = i * grain;
+        ranges[i].end = (i == num_ranges - 1) ? count : (i + 1) * grain;
+    }
+
+    /* Submit the ranges in reverse, so a worker running on this thread
+       takes the first ones back from its own deque in order. */
+    SDL_AtomicSet(&counter, 0);
+    for (i = num_ranges - 1; i > 0; --i) {
+        if (SDL_SubmitJob(pool, SDL_RunParallelForRange, &ranges[i], &counter) < 0) {
+            SDL_RunParallelForRange(&ranges[i]);
+        }
+    }
+    SDL_RunParallelForRange(&ranges[0]);
+    SDL_WaitJobs(pool, &counter);
+
+    SDL_free(ranges);
+    return 0;
+}
+
+int SDL_SetJobPoolProfileCallback(SDL_JobPool *pool, SDL_JobProfileCallback callback, void *userdata)
+{
+    pool = SDL_GetJobPool(pool);
+    if (!pool) {
+        return -1;
+    }
+
+    pool->profile_callback = callback;
+    pool->profile_userdata = userdata;
+    return 0;
+}
+
+void SDL_DestroyJobPool(SDL_JobPool *pool)
+{
+    SDL_Job *job;
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    if (pool->num_workers > 0) {
+        /* The workers run any jobs that are left before they exit */
+        SDL_AtomicSet(&pool->quit, 1);
+        SDL_WakeJobThreads(pool, SDL_TRUE);
+        for (i = 0; i < pool->num_workers; ++i) {
+            SDL_WaitThread(pool->workers[i].thread, NULL);
+        }
+
+        /* Run anything that was submitted while they were exiting */
+        while ((job = SDL_TakeJob(pool, NULL)) != NULL) {
+            SDL_RunQueuedJob(pool, job, NULL);
+        }
+    }
+
+    while (pool->free_jobs) {
+        job = pool->free_jobs;
+        pool->free_jobs = job->next;
+        SDL_free(job);
+    }
+
+    SDL_DestroyCondition(pool->wakeup);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool->workers);
+    SDL_free(pool);
+}
+
+void SDL_QuitJobPool(void)
+{
+    SDL_JobPool *pool;
+
+    SDL_AtomicLockNamed(&SDL_default_job_pool_lock, SDL_LOCK_NAME);
+    pool = SDL_default_job_pool;
+    SDL_default_job_pool = NULL;
+    SDL_AtomicUnlock(&SDL_default_job_pool_lock);
+
+    SDL_DestroyJobPool(pool);
+}
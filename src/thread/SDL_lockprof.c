@@ -0,0 +1,373 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_lockprof_c.h"
+#include "SDL_thread_c.h"
+#include "../SDL_hints_c.h"
+
+#ifdef SDL_LOADSO_DLOPEN
+#include <dlfcn.h>
+#endif
+
+/* The most lock sites that can be profiled, must be a power of two */
+#define SDL_MAX_LOCK_PROFILES 1024
+
+/* The most spinlocks a thread can hold at once and still have their hold times recorded */
+#define SDL_MAX_HELD_SPINLOCKS 8
+
+struct SDL_LockProfile
+{
+    void *site;
+    SDL_LockType type;
+    SDL_AtomicInt ready;
+    SDL_SpinLock lock;
+    Uint64 acquisitions;
+    Uint64 contended;
+    Uint64 wait_ticks;
+    Uint64 max_hold_ticks;
+    char name[64];
+};
+
+int SDL_lock_profiling = -1;
+static SDL_LockProfile *SDL_lock_profiles;
+static SDL_AtomicInt SDL_lock_profile_misses;
+static char SDL_unknown_lock_site;
+
+#ifdef SDL_THREAD_LOCAL
+typedef struct SDL_HeldSpinLock
+{
+    SDL_SpinLock *lock;
+    SDL_LockProfile *profile;
+    Uint64 locked_at;
+} SDL_HeldSpinLock;
+
+/* The spinlocks this thread is holding, so their hold times can be recorded */
+static SDL_THREAD_LOCAL SDL_HeldSpinLock SDL_held_spinlocks[SDL_MAX_HELD_SPINLOCKS];
+static SDL_THREAD_LOCAL int SDL_num_held_spinlocks;
+#endif
+
+static void SDL_InitLockProfiling(void)
+{
+    SDL_bool enabled = SDL_FALSE;
+
+#ifndef SDL_ATOMIC_DISABLED
+    /* This is read from the environment directly, since the hint system
+       itself uses locks. */
+    if (SDL_GetStringBoolean(SDL_getenv(SDL_HINT_LOCK_PROFILING), SDL_FALSE)) {
+        SDL_LockProfile *profiles = (SDL_LockProfile *)SDL_calloc(SDL_MAX_LOCK_PROFILES, sizeof(*profiles));
+        if (profiles) {
+            if (!SDL_AtomicCASPtr((void **)&SDL_lock_profiles, NULL, profiles)) {
+                SDL_free(profiles);
+            }
+            enabled = SDL_TRUE;
+        }
+    }
+#endif
+    SDL_MemoryBarrierRelease();
+    SDL_lock_profiling = enabled ? 1 : 0;
+}
+
+/* The profile statistics can't be protected by SDL_AtomicLock(), which is profiled itself */
+static void SDL_LockProfileStats(SDL_LockProfile *profile)
+{
+    while (!SDL_AtomicTryLock(&profile->lock)) {
+        SDL_CPUPauseInstruction();
+    }
+}
+
+static void SDL_UnlockProfileStats(SDL_LockProfile *profile)
+{
+    SDL_MemoryBarrierRelease();
+    profile->lock = 0;
+}
+
+static void SDL_GetLockSiteName(const void *site, const char *label, char *name, size_t maxlen)
+{
+#ifdef SDL_LOADSO_DLOPEN
+    Dl_info info;
+#endif
+
+    if (label) {
+        /* Internal locks are labelled with their source file and line */
+        const char *file = SDL_strrchr(label, '/');
+        if (!file) {
+            file = SDL_strrchr(label, '\\');
+        }
+        SDL_strlcpy(name, file ? file + 1 : label, maxlen);
+        return;
+    }
+
+    if (site == &SDL_unknown_lock_site) {
+        SDL_strlcpy(name, "unknown", maxlen);
+        return;
+    }
+
+#ifdef SDL_LOADSO_DLOPEN
+    /* Static functions and variables don't have symbols, so fall back to
+       an offset into the module, which can be looked up with addr2line */
+    if (dladdr(site, &info) && info.dli_fname) {
+        if (info.dli_sname && info.dli_saddr) {
+            SDL_snprintf(name, maxlen, "%s+0x%x", info.dli_sname, (unsigned int)((const char *)site - (const char *)info.dli_saddr));
+        } else {
+            const char *module = SDL_strrchr(info.dli_fname, '/');
+            SDL_snprintf(name, maxlen, "%s+0x%x", module ? module + 1 : info.dli_fname, (unsigned int)((const char *)site - (const char *)info.dli_fbase));
+        }
+        return;
+    }
+#endif
+    SDL_snprintf(name, maxlen, "%p", site);
+}
+
+static SDL_LockProfile *SDL_FindLockProfile(SDL_LockType type, const void *site, const char *label)
+{
+    const Uint32 hash = (Uint32)(((Uint64)(uintptr_t)site * (Uint64)0x9E3779B97F4A7C15ull) >> 32);
+    SDL_LockProfile *profile;
+    void *existing;
+    int i;
+
+    if (!SDL_lock_profiles) {
+        return NULL;
+    }
+
+    for (i = 0; i < SDL_MAX_LOCK_PROFILES; ++i) {
+        profile = &SDL_lock_profiles[(hash + i) & (SDL_MAX_LOCK_PROFILES - 1)];
+        existing = SDL_AtomicGetPtr(&profile->site);
+        if (existing == site) {
+            return profile;
+        }
+        if (existing) {
+            continue;
+        }
+        if (SDL_AtomicCASPtr(&profile->site, NULL, (void *)site)) {
+            profile->type = type;
+            SDL_GetLockSiteName(site, label, profile->name, sizeof(profile->name));
+            SDL_AtomicSet(&profile->ready, 1);
+            return profile;
+        }
+        /* Another thread claimed this slot, check it again */
+        --i;
+    }
+
+    /* The table is full, this is reported by SDL_LogLockStats() */
+    SDL_AtomicIncRef(&SDL_lock_profile_misses);
+    return NULL;
+}
+
+SDL_LockProfile *SDL_GetLockProfile(SDL_LockType type, const void *site, const char *name)
+{
+    if (SDL_lock_profiling < 0) {
+        SDL_InitLockProfiling();
+    }
+    if (!SDL_lock_profiling) {
+        return NULL;
+    }
+    if (!site) {
+        site = &SDL_unknown_lock_site;
+    }
+    return SDL_FindLockProfile(type, site, name);
+}
+
+Uint64 SDL_RecordLockAcquired(SDL_LockProfile *profile, SDL_bool contended, Uint64 wait_start)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    SDL_LockProfileStats(profile);
+    ++profile->acquisitions;
+    if (contended) {
+        ++profile->contended;
+        profile->wait_ticks += (now - wait_start);
+    }
+    SDL_UnlockProfileStats(profile);
+
+    return now;
+}
+
+void SDL_RecordLockReleased(SDL_LockProfile *profile, Uint64 locked_at)
+{
+    const Uint64 held = SDL_GetPerformanceCounter() - locked_at;
+
+    SDL_LockProfileStats(profile);
+    if (held > profile->max_hold_ticks) {
+        profile->max_hold_ticks = held;
+    }
+    SDL_UnlockProfileStats(profile);
+}
+
+void SDL_RecordSpinLockAcquired(SDL_SpinLock *lock, const void *site, const char *name, SDL_bool contended, Uint64 wait_start)
+{
+    SDL_LockProfile *profile;
+    Uint64 locked_at;
+
+    if (!site) {
+        site = &SDL_unknown_lock_site;
+    }
+    profile = SDL_FindLockProfile(SDL_LOCK_TYPE_SPINLOCK, site, name);
+    if (!profile) {
+        return;
+    }
+
+    locked_at = SDL_RecordLockAcquired(profile, contended, wait_start);
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_num_held_spinlocks < SDL_MAX_HELD_SPINLOCKS) {
+        SDL_HeldSpinLock *held = &SDL_held_spinlocks[SDL_num_held_spinlocks++];
+        held->lock = lock;
+        held->profile = profile;
+        held->locked_at = locked_at;
+    }
+#else
+    (void)locked_at;
+#endif
+}
+
+void SDL_RecordSpinLockReleased(SDL_SpinLock *lock)
+{
+#ifdef SDL_THREAD_LOCAL
+    int i;
+
+    /* Spinlocks taken with SDL_AtomicTryLock() or unlocked by another thread aren't timed */
+    for (i = SDL_num_held_spinlocks; i--;) {
+        if (SDL_held_spinlocks[i].lock == lock) {
+            SDL_RecordLockReleased(SDL_held_spinlocks[i].profile, SDL_held_spinlocks[i].locked_at);
+            --SDL_num_held_spinlocks;
+            SDL_memmove(&SDL_held_spinlocks[i], &SDL_held_spinlocks[i + 1], (SDL_num_held_spinlocks - i) * sizeof(SDL_held_spinlocks[i]));
+            break;
+        }
+    }
+#else
+    (void)lock;
+#endif
+}
+
+static Uint64 SDL_LockTicksToNS(Uint64 ticks, Uint64 frequency)
+{
+    return (ticks / frequency) * SDL_NS_PER_SECOND + ((ticks % frequency) * SDL_NS_PER_SECOND) / frequency;
+}
+
+int SDL_GetLockStats(SDL_LockStats *stats, int count)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    SDL_LockProfile *profile;
+    int i, total = 0;
+
+    if (SDL_lock_profiling <= 0 || !SDL_lock_profiles) {
+        return 0;
+    }
+
+    for (i = 0; i < SDL_MAX_LOCK_PROFILES; ++i) {
+        profile = &SDL_lock_profiles[i];
+        if (!SDL_AtomicGet(&profile->ready)) {
+            continue;
+        }
+        if (stats && total < count) {
+            SDL_LockStats *entry = &stats[total];
+
+            SDL_LockProfileStats(profile);
+            entry->type = profile->type;
+            entry->name = profile->name;
+            entry->acquisitions = profile->acquisitions;
+            entry->contended = profile->contended;
+            entry->wait_ns = SDL_LockTicksToNS(profile->wait_ticks, frequency);
+            entry->max_hold_ns = SDL_LockTicksToNS(profile->max_hold_ticks, frequency);
+            SDL_UnlockProfileStats(profile);
+        }
+        ++total;
+    }
+    return total;
+}
+
+static int SDLCALL SDL_CompareLockStats(const void *a, const void *b)
+{
+    const SDL_LockStats *A = (const SDL_LockStats *)a;
+    const SDL_LockStats *B = (const SDL_LockStats *)b;
+
+    if (A->wait_ns != B->wait_ns) {
+        return (A->wait_ns > B->wait_ns) ? -1 : 1;
+    }
+    if (A->contended != B->contended) {
+        return (A->contended > B->contended) ? -1 : 1;
+    }
+    if (A->acquisitions != B->acquisitions) {
+        return (A->acquisitions > B->acquisitions) ? -1 : 1;
+    }
+    return 0;
+}
+
+void SDL_LogLockStats(void)
+{
+    static const char *types[] = { "mutex", "rwlock", "spinlock" };
+    SDL_LockStats *stats;
+    int i, count, misses;
+
+    if (SDL_lock_profiling <= 0) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_SYSTEM, "Lock profiling is disabled, set %s=1 in the environment to enable it", SDL_HINT_LOCK_PROFILING);
+        return;
+    }
+
+    misses = SDL_AtomicGet(&SDL_lock_profile_misses);
+    if (misses > 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_SYSTEM, "The table of %d lock sites is full, %d lock creations and acquisitions weren't profiled", SDL_MAX_LOCK_PROFILES, misses);
+    }
+
+    count = SDL_GetLockStats(NULL, 0);
+    if (count == 0) {
+        return;
+    }
+    stats = (SDL_LockStats *)SDL_malloc(count * sizeof(*stats));
+    if (!stats) {
+        return;
+    }
+    count = SDL_GetLockStats(stats, count);
+    SDL_qsort(stats, count, sizeof(*stats), SDL_CompareLockStats);
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_SYSTEM, "Lock statistics, most contended first:");
+    for (i = 0; i < count; ++i) {
+        const SDL_LockStats *entry = &stats[i];
+        SDL_LogInfo(SDL_LOG_CATEGORY_SYSTEM,
+                    "  %-8s %-40s acquired %" SDL_PRIu64 ", contended %" SDL_PRIu64 ", waited %" SDL_PRIu64 " us, longest hold %" SDL_PRIu64 " us",
+                    types[entry->type], entry->name, entry->acquisitions, entry->contended,
+                    SDL_NS_TO_US(entry->wait_ns), SDL_NS_TO_US(entry->max_hold_ns));
+    }
+    SDL_free(stats);
+}
+
+void SDL_ResetLockStats(void)
+{
+    SDL_LockProfile *profile;
+    int i;
+
+    if (SDL_lock_profiling <= 0 || !SDL_lock_profiles) {
+        return;
+    }
+
+    for (i = 0; i < SDL_MAX_LOCK_PROFILES; ++i) {
+        profile = &SDL_lock_profiles[i];
+        if (!SDL_AtomicGet(&profile->ready)) {
+            continue;
+        }
+        SDL_LockProfileStats(profile);
+        profile->acquisitions = 0;
+        profile->contended = 0;
+        profile->wait_ticks = 0;
+        profile->max_hold_ticks = 0;
+        SDL_UnlockProfileStats(profile);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_lockprof_c_h_
+#define SDL_lockprof_c_h_
+
+/* Lock contention profiling, enabled with SDL_HINT_LOCK_PROFILING.
+   Times are recorded in performance counter ticks.
+ */
+typedef struct SDL_LockProfile SDL_LockProfile;
+
+/* -1 until the first lock profile is requested, then 0 or 1 */
+extern int SDL_lock_profiling;
+
+/* The code that called the current function */
+#if defined(__GNUC__) || defined(__clang__)
+#define SDL_LOCK_CALL_SITE() __builtin_return_address(0)
+#else
+#define SDL_LOCK_CALL_SITE() NULL
+#endif
+
+/* Get the profile shared by locks created at this site, or NULL if locks aren't being profiled.
+   The profile is labelled with name, or with the symbol at site if name is NULL.
+ */
+extern SDL_LockProfile *SDL_GetLockProfile(SDL_LockType type, const void *site, const char *name);
+
+/* Record a lock being taken, and return the time it was taken */
+extern Uint64 SDL_RecordLockAcquired(SDL_LockProfile *profile, SDL_bool contended, Uint64 wait_start);
+
+/* Record a lock taken at locked_at being released */
+extern void SDL_RecordLockReleased(SDL_LockProfile *profile, Uint64 locked_at);
+
+/* Spinlocks don't have a creation site, so they are profiled by the code that takes them */
+extern void SDL_RecordSpinLockAcquired(SDL_SpinLock *lock, const void *site, const char *name, SDL_bool contended, Uint64 wait_start);
+extern void SDL_RecordSpinLockReleased(SDL_SpinLock *lock);
+
+#endif /* SDL_lockprof_c_h_ */
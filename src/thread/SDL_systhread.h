@@ -69,6 +69,13 @@ extern SDL_Thread *
 SDL_CreateThreadInternal(int(SDLCALL *fn)(void *), const char *name,
                          const size_t stacksize, void *data);
 
+/* Create a recursive mutex for short critical sections, which spins for a
+   moment before sleeping when it's contended. It can't be used with an
+   SDL_Condition. This is a regular SDL_Mutex on platforms without support.
+   The name is used for lock profiling, usually SDL_LOCK_NAME.
+ */
+extern SDL_Mutex *SDL_CreateAdaptiveMutex(const char *name);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -26,6 +26,14 @@
 #include "SDL_systhread.h"
 #include "../SDL_error_c.h"
 
+#ifdef SDL_THREAD_LOCAL
+/* A copy of the system TLS data for this thread, which avoids a system call on every lookup */
+static SDL_THREAD_LOCAL SDL_TLSData *SDL_tls_storage;
+
+/* The error buffer for this thread, which is also stored in TLS so it's cleaned up */
+static SDL_THREAD_LOCAL SDL_error *SDL_tls_errbuf;
+#endif
+
 SDL_TLSID SDL_CreateTLS(void)
 {
     static SDL_AtomicInt SDL_tls_id;
@@ -36,7 +44,11 @@ void *SDL_GetTLS(SDL_TLSID id)
 {
     SDL_TLSData *storage;
 
+#ifdef SDL_THREAD_LOCAL
+    storage = SDL_tls_storage;
+#else
     storage = SDL_SYS_GetTLSData();
+#endif
     if (!storage || id == 0 || id > storage->limit) {
         return NULL;
     }
@@ -51,7 +63,15 @@ int SDL_SetTLS(SDL_TLSID id, const void *value, void(SDLCALL *destructor)(void *
         return SDL_InvalidParamError("id");
     }
 
+#ifdef SDL_THREAD_LOCAL
+    storage = SDL_tls_storage;
+    if (!storage) {
+        /* This also creates the system TLS slot the first time through */
+        storage = SDL_SYS_GetTLSData();
+    }
+#else
     storage = SDL_SYS_GetTLSData();
+#endif
     if (!storage || (id > storage->limit)) {
         unsigned int i, oldlimit, newlimit;
         SDL_TLSData *new_storage;
@@ -71,6 +91,9 @@ int SDL_SetTLS(SDL_TLSID id, const void *value, void(SDLCALL *destructor)(void *
         if (SDL_SYS_SetTLSData(storage) != 0) {
             return -1;
         }
+#ifdef SDL_THREAD_LOCAL
+        SDL_tls_storage = storage;
+#endif
     }
 
     storage->array[id - 1].data = SDL_const_cast(void *, value);
@@ -82,7 +105,11 @@ void SDL_CleanupTLS(void)
 {
     SDL_TLSData *storage;
 
+#ifdef SDL_THREAD_LOCAL
+    storage = SDL_tls_storage;
+#else
     storage = SDL_SYS_GetTLSData();
+#endif
     if (storage) {
         unsigned int i;
         for (i = 0; i < storage->limit; ++i) {
@@ -90,6 +117,9 @@ void SDL_CleanupTLS(void)
                 storage->array[i].destructor(storage->array[i].data);
             }
         }
+#ifdef SDL_THREAD_LOCAL
+        SDL_tls_storage = NULL;
+#endif
         SDL_SYS_SetTLSData(NULL);
         SDL_free(storage);
     }
@@ -122,9 +152,9 @@ SDL_TLSData *SDL_Generic_GetTLSData(void)
 #ifndef SDL_THREADS_DISABLED
     if (!SDL_generic_TLS_mutex) {
         static SDL_SpinLock tls_lock;
-        SDL_AtomicLock(&tls_lock);
+        SDL_AtomicLockNamed(&tls_lock, SDL_LOCK_NAME);
         if (!SDL_generic_TLS_mutex) {
-            SDL_Mutex *mutex = SDL_CreateMutex();
+            SDL_Mutex *mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
             SDL_MemoryBarrierRelease();
             SDL_generic_TLS_mutex = mutex;
             if (!SDL_generic_TLS_mutex) {
@@ -204,6 +234,11 @@ static void SDLCALL SDL_FreeErrBuf(void *data)
 {
     SDL_error *errbuf = (SDL_error *)data;
 
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_tls_errbuf == errbuf) {
+        SDL_tls_errbuf = NULL;
+    }
+#endif
     if (errbuf->str) {
         errbuf->free_func(errbuf->str);
     }
@@ -223,6 +258,12 @@ SDL_error *SDL_GetErrBuf(SDL_bool create)
     const SDL_error *ALLOCATION_IN_PROGRESS = (SDL_error *)-1;
     SDL_error *errbuf;
 
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_tls_errbuf) {
+        return SDL_tls_errbuf;
+    }
+#endif
+
     if (!tls_errbuf && !create) {
         return NULL;
     }
@@ -232,7 +273,7 @@ SDL_error *SDL_GetErrBuf(SDL_bool create)
        but that's very unlikely and hopefully won't cause issues.
      */
     if (!tls_errbuf && !tls_being_created) {
-        SDL_AtomicLock(&tls_lock);
+        SDL_AtomicLockNamed(&tls_lock, SDL_LOCK_NAME);
         if (!tls_errbuf) {
             SDL_TLSID slot;
             tls_being_created = SDL_TRUE;
@@ -272,6 +313,9 @@ SDL_error *SDL_GetErrBuf(SDL_bool create)
         errbuf->free_func = free_func;
         SDL_SetTLS(tls_errbuf, errbuf, SDL_FreeErrBuf);
     }
+#ifdef SDL_THREAD_LOCAL
+    SDL_tls_errbuf = errbuf;
+#endif
     return errbuf;
 #endif /* SDL_THREADS_DISABLED */
 }
@@ -409,6 +453,25 @@ SDL_Thread *SDL_CreateThreadInternal(int(SDLCALL *fn)(void *), const char *name,
 #endif
 }
 
+#ifndef SDL_THREAD_ADAPTIVE_MUTEX
+SDL_Mutex *SDL_CreateAdaptiveMutex(const char *name)
+{
+    return SDL_CreateMutexNamed(name);
+}
+#endif
+
+#ifndef SDL_THREAD_NAMED_LOCKS
+SDL_Mutex *SDL_CreateMutexNamed(const char *name)
+{
+    return SDL_CreateMutex();
+}
+
+SDL_RWLock *SDL_CreateRWLockNamed(const char *name)
+{
+    return SDL_CreateRWLock();
+}
+#endif
+
 SDL_threadID SDL_GetThreadID(SDL_Thread *thread)
 {
     SDL_threadID id;
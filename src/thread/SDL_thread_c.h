@@ -48,6 +48,32 @@
 #endif
 #include "../SDL_error_c.h"
 
+/* Mutexes that spin briefly before sleeping, see SDL_CreateAdaptiveMutex() */
+#if !defined(SDL_THREADS_DISABLED) && defined(SDL_THREAD_PTHREAD) && defined(__LINUX__)
+#define SDL_THREAD_ADAPTIVE_MUTEX
+#endif
+
+/* Locks that are profiled under their name, see SDL_CreateMutexNamed() */
+#if !defined(SDL_THREADS_DISABLED) && defined(SDL_THREAD_PTHREAD)
+#define SDL_THREAD_NAMED_LOCKS
+#endif
+
+/* Compiler-native thread-local storage, used to cache the TLS array and error buffer.
+   This is limited to platforms where it is known to work in shared libraries.
+ */
+#if !defined(SDL_THREADS_DISABLED) && \
+    (defined(SDL_THREAD_PTHREAD) || defined(SDL_THREAD_WINDOWS)) && \
+    (defined(__LINUX__) || defined(__ANDROID__) || defined(__APPLE__) || defined(__FREEBSD__) || \
+     defined(__NETBSD__) || defined(__OPENBSD__) || defined(__WIN32__) || defined(__GDK__))
+#if defined(_MSC_VER)
+#define SDL_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SDL_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#define SDL_THREAD_LOCAL __thread
+#endif
+#endif
+
 typedef enum SDL_ThreadState
 {
     SDL_THREAD_STATE_ALIVE,
@@ -101,4 +127,7 @@ extern SDL_TLSData *SDL_Generic_GetTLSData(void);
  */
 extern int SDL_Generic_SetTLSData(SDL_TLSData *data);
 
+/* Destroy the job pool shared by SDL and the application */
+extern void SDL_QuitJobPool(void);
+
 #endif /* SDL_thread_c_h_ */
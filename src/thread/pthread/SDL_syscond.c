@@ -101,9 +101,23 @@ int SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 tim
     if (!cond) {
         return SDL_InvalidParamError("cond");
     }
+#ifdef SDL_THREAD_ADAPTIVE_MUTEX
+    if (mutex && mutex->adaptive) {
+        return SDL_SetError("Adaptive mutexes can't be used with conditions");
+    }
+#endif
+
+    /* The mutex is released while waiting, so that doesn't count as holding it */
+    if (mutex->profile) {
+        SDL_RecordLockReleased(mutex->profile, mutex->profile_locked_at);
+    }
 
     if (timeoutNS < 0) {
-        if (pthread_cond_wait(&cond->cond, &mutex->id) != 0) {
+        retval = pthread_cond_wait(&cond->cond, &mutex->id);
+        if (mutex->profile) {
+            mutex->profile_locked_at = SDL_GetPerformanceCounter();
+        }
+        if (retval != 0) {
             return SDL_SetError("pthread_cond_wait() failed");
         }
         return 0;
@@ -139,5 +153,8 @@ tryagain:
     default:
         retval = SDL_SetError("pthread_cond_timedwait() failed");
     }
+    if (mutex->profile) {
+        mutex->profile_locked_at = SDL_GetPerformanceCounter();
+    }
     return retval;
 }
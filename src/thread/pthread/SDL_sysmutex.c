@@ -25,7 +25,65 @@
 
 #include "SDL_sysmutex_c.h"
 
-SDL_Mutex *SDL_CreateMutex(void)
+#ifdef SDL_THREAD_ADAPTIVE_MUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* How many times to check an adaptive mutex before going to sleep */
+#define SDL_MUTEX_SPIN_COUNT 100
+
+SDL_Mutex *SDL_CreateAdaptiveMutex(const char *name)
+{
+    SDL_Mutex *mutex = (SDL_Mutex *)SDL_calloc(1, sizeof(*mutex));
+    if (mutex) {
+        mutex->adaptive = SDL_TRUE;
+        mutex->profile = SDL_GetLockProfile(SDL_LOCK_TYPE_MUTEX, name, name);
+    }
+    return mutex;
+}
+
+static void SDL_LockAdaptiveMutex(SDL_Mutex *mutex)
+{
+    int i, state;
+
+    if (SDL_AtomicCAS(&mutex->state, 0, 1)) {
+        return;
+    }
+
+    /* The owner is likely to release it soon, so spin for a moment if it
+       could be running on another CPU. Only try to take it when it looks
+       free, so waiters aren't all writing to the cache line.
+     */
+    if (SDL_GetCPUCount() > 1) {
+        for (i = 0; i < SDL_MUTEX_SPIN_COUNT; ++i) {
+            SDL_CPUPauseInstruction();
+            if (SDL_AtomicGet(&mutex->state) == 0 && SDL_AtomicCAS(&mutex->state, 0, 1)) {
+                return;
+            }
+        }
+    }
+
+    /* Mark the mutex as having waiters and sleep until it's released */
+    state = SDL_AtomicSet(&mutex->state, 2);
+    while (state != 0) {
+        syscall(SYS_futex, &mutex->state.value, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+        state = SDL_AtomicSet(&mutex->state, 2);
+    }
+}
+
+static void SDL_UnlockAdaptiveMutex(SDL_Mutex *mutex)
+{
+    if (SDL_AtomicAdd(&mutex->state, -1) != 1) {
+        /* There may be threads sleeping, wake one of them up */
+        SDL_AtomicSet(&mutex->state, 0);
+        syscall(SYS_futex, &mutex->state.value, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+#endif /* SDL_THREAD_ADAPTIVE_MUTEX */
+
+/* Locks created by the application are grouped by the code that created them */
+static SDL_Mutex *SDL_CreateProfiledMutex(const void *site, const char *name)
 {
     SDL_Mutex *mutex;
     pthread_mutexattr_t attr;
@@ -45,22 +103,53 @@ SDL_Mutex *SDL_CreateMutex(void)
             SDL_SetError("pthread_mutex_init() failed");
             SDL_free(mutex);
             mutex = NULL;
+        } else {
+            mutex->profile = SDL_GetLockProfile(SDL_LOCK_TYPE_MUTEX, site, name);
         }
     }
     return mutex;
 }
 
+SDL_Mutex *SDL_CreateMutex(void)
+{
+    return SDL_CreateProfiledMutex(SDL_LOCK_CALL_SITE(), NULL);
+}
+
+SDL_Mutex *SDL_CreateMutexNamed(const char *name)
+{
+    return SDL_CreateProfiledMutex(name, name);
+}
+
 void SDL_DestroyMutex(SDL_Mutex *mutex)
 {
     if (mutex) {
+#ifdef SDL_THREAD_ADAPTIVE_MUTEX
+        if (!mutex->adaptive) {
+            pthread_mutex_destroy(&mutex->id);
+        }
+#else
         pthread_mutex_destroy(&mutex->id);
+#endif
         SDL_free(mutex);
     }
 }
 
-void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+static void SDL_LockMutexInternal(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS
 {
     if (mutex != NULL) {
+#ifdef SDL_THREAD_ADAPTIVE_MUTEX
+        if (mutex->adaptive) {
+            pthread_t this_thread = pthread_self();
+            if (mutex->adaptive_owner == this_thread) {
+                ++mutex->adaptive_recursive;
+            } else {
+                SDL_LockAdaptiveMutex(mutex);
+                mutex->adaptive_owner = this_thread;
+                mutex->adaptive_recursive = 0;
+            }
+            return;
+        }
+#endif
 #ifdef FAKE_RECURSIVE_MUTEX
         pthread_t this_thread = pthread_self();
         if (mutex->owner == this_thread) {
@@ -82,11 +171,25 @@ void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang does
     }
 }
 
-int SDL_TryLockMutex(SDL_Mutex *mutex)
+static int SDL_TryLockMutexInternal(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS
 {
     int retval = 0;
 
     if (mutex) {
+#ifdef SDL_THREAD_ADAPTIVE_MUTEX
+        if (mutex->adaptive) {
+            pthread_t this_thread = pthread_self();
+            if (mutex->adaptive_owner == this_thread) {
+                ++mutex->adaptive_recursive;
+            } else if (SDL_AtomicCAS(&mutex->state, 0, 1)) {
+                mutex->adaptive_owner = this_thread;
+                mutex->adaptive_recursive = 0;
+            } else {
+                retval = SDL_MUTEX_TIMEDOUT;
+            }
+            return retval;
+        }
+#endif
 #ifdef FAKE_RECURSIVE_MUTEX
         pthread_t this_thread = pthread_self();
         if (mutex->owner == this_thread) {
@@ -123,9 +226,22 @@ int SDL_TryLockMutex(SDL_Mutex *mutex)
     return retval;
 }
 
-void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+static void SDL_UnlockMutexInternal(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS
 {
     if (mutex != NULL) {
+#ifdef SDL_THREAD_ADAPTIVE_MUTEX
+        if (mutex->adaptive) {
+            // We can only unlock the mutex if we own it
+            SDL_assert(mutex->adaptive_owner == pthread_self());
+            if (mutex->adaptive_recursive) {
+                --mutex->adaptive_recursive;
+            } else {
+                mutex->adaptive_owner = 0;
+                SDL_UnlockAdaptiveMutex(mutex);
+            }
+            return;
+        }
+#endif
 #ifdef FAKE_RECURSIVE_MUTEX
         // We can only unlock the mutex if we own it
         if (pthread_self() == mutex->owner) {
@@ -151,3 +267,49 @@ void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang do
     }
 }
 
+void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex != NULL) {
+        if (mutex->profile) {
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            SDL_bool contended = SDL_FALSE;
+
+            if (SDL_TryLockMutexInternal(mutex) != 0) {
+                contended = SDL_TRUE;
+                SDL_LockMutexInternal(mutex);
+            }
+            if (mutex->profile_depth++ == 0) {
+                mutex->profile_locked_at = SDL_RecordLockAcquired(mutex->profile, contended, wait_start);
+            }
+        } else {
+            SDL_LockMutexInternal(mutex);
+        }
+    }
+}
+
+int SDL_TryLockMutex(SDL_Mutex *mutex)
+{
+    int retval = 0;
+
+    if (mutex) {
+        retval = SDL_TryLockMutexInternal(mutex);
+        if (retval == 0 && mutex->profile) {
+            if (mutex->profile_depth++ == 0) {
+                mutex->profile_locked_at = SDL_RecordLockAcquired(mutex->profile, SDL_FALSE, 0);
+            }
+        }
+    }
+    return retval;
+}
+
+void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex != NULL) {
+        if (mutex->profile && mutex->profile_depth > 0) {
+            if (--mutex->profile_depth == 0) {
+                SDL_RecordLockReleased(mutex->profile, mutex->profile_locked_at);
+            }
+        }
+        SDL_UnlockMutexInternal(mutex);
+    }
+}
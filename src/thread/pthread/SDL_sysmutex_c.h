@@ -23,6 +23,9 @@
 #ifndef SDL_mutex_c_h_
 #define SDL_mutex_c_h_
 
+#include "../SDL_thread_c.h"
+#include "../SDL_lockprof_c.h"
+
 #if !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
     defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP))
 #define FAKE_RECURSIVE_MUTEX
@@ -35,6 +38,17 @@ struct SDL_Mutex
     int recursive;
     pthread_t owner;
 #endif
+#ifdef SDL_THREAD_ADAPTIVE_MUTEX
+    /* Used instead of id by mutexes from SDL_CreateAdaptiveMutex() */
+    SDL_bool adaptive;
+    SDL_AtomicInt state; /* 0 = unlocked, 1 = locked, 2 = locked with sleeping waiters */
+    pthread_t adaptive_owner;
+    int adaptive_recursive;
+#endif
+    /* Used when SDL_HINT_LOCK_PROFILING is enabled */
+    SDL_LockProfile *profile;
+    Uint64 profile_locked_at;
+    int profile_depth;
 };
 
 #endif /* SDL_mutex_c_h_ */
@@ -23,13 +23,21 @@
 #include <errno.h>
 #include <pthread.h>
 
+#include "../SDL_lockprof_c.h"
+
 struct SDL_RWLock
 {
     pthread_rwlock_t id;
+
+    /* Used when SDL_HINT_LOCK_PROFILING is enabled, only writers are timed */
+    SDL_LockProfile *profile;
+    pthread_t writer;
+    Uint64 write_locked_at;
 };
 
 
-SDL_RWLock *SDL_CreateRWLock(void)
+/* Locks created by the application are grouped by the code that created them */
+static SDL_RWLock *SDL_CreateProfiledRWLock(const void *site, const char *name)
 {
     SDL_RWLock *rwlock;
 
@@ -40,11 +48,23 @@ SDL_RWLock *SDL_CreateRWLock(void)
             SDL_SetError("pthread_rwlock_init() failed");
             SDL_free(rwlock);
             rwlock = NULL;
+        } else {
+            rwlock->profile = SDL_GetLockProfile(SDL_LOCK_TYPE_RWLOCK, site, name);
         }
     }
     return rwlock;
 }
 
+SDL_RWLock *SDL_CreateRWLock(void)
+{
+    return SDL_CreateProfiledRWLock(SDL_LOCK_CALL_SITE(), NULL);
+}
+
+SDL_RWLock *SDL_CreateRWLockNamed(const char *name)
+{
+    return SDL_CreateProfiledRWLock(name, name);
+}
+
 void SDL_DestroyRWLock(SDL_RWLock *rwlock)
 {
     if (rwlock) {
@@ -56,16 +76,41 @@ void SDL_DestroyRWLock(SDL_RWLock *rwlock)
 void SDL_LockRWLockForReading(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        const int rc = pthread_rwlock_rdlock(&rwlock->id);
-        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        if (rwlock->profile) {
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            SDL_bool contended = SDL_FALSE;
+
+            if (pthread_rwlock_tryrdlock(&rwlock->id) != 0) {
+                const int rc = pthread_rwlock_rdlock(&rwlock->id);
+                SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+                contended = SDL_TRUE;
+            }
+            SDL_RecordLockAcquired(rwlock->profile, contended, wait_start);
+        } else {
+            const int rc = pthread_rwlock_rdlock(&rwlock->id);
+            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        }
     }
 }
 
 void SDL_LockRWLockForWriting(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        const int rc = pthread_rwlock_wrlock(&rwlock->id);
-        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        if (rwlock->profile) {
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            SDL_bool contended = SDL_FALSE;
+
+            if (pthread_rwlock_trywrlock(&rwlock->id) != 0) {
+                const int rc = pthread_rwlock_wrlock(&rwlock->id);
+                SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+                contended = SDL_TRUE;
+            }
+            rwlock->writer = pthread_self();
+            rwlock->write_locked_at = SDL_RecordLockAcquired(rwlock->profile, contended, wait_start);
+        } else {
+            const int rc = pthread_rwlock_wrlock(&rwlock->id);
+            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        }
     }
 }
 
@@ -80,6 +125,8 @@ int SDL_TryLockRWLockForReading(SDL_RWLock *rwlock)
             if (result != EBUSY) {
                 SDL_assert(!"Error trying to lock rwlock for reading");  // assume we're in a lot of trouble if this assert fails.
             }
+        } else if (rwlock->profile) {
+            SDL_RecordLockAcquired(rwlock->profile, SDL_FALSE, 0);
         }
     }
 
@@ -97,6 +144,9 @@ int SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
             if (result != EBUSY) {
                 SDL_assert(!"Error trying to lock rwlock for writing");  // assume we're in a lot of trouble if this assert fails.
             }
+        } else if (rwlock->profile) {
+            rwlock->writer = pthread_self();
+            rwlock->write_locked_at = SDL_RecordLockAcquired(rwlock->profile, SDL_FALSE, 0);
         }
     }
 
@@ -106,7 +156,13 @@ int SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
 void SDL_UnlockRWLock(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        const int rc = pthread_rwlock_unlock(&rwlock->id);
+        int rc;
+
+        if (rwlock->profile && rwlock->writer == pthread_self()) {
+            rwlock->writer = 0;
+            SDL_RecordLockReleased(rwlock->profile, rwlock->write_locked_at);
+        }
+        rc = pthread_rwlock_unlock(&rwlock->id);
         SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
     }
 }
@@ -33,7 +33,7 @@ SDL_TLSData *SDL_SYS_GetTLSData(void)
 {
     if (thread_local_storage == INVALID_PTHREAD_KEY && !generic_local_storage) {
         static SDL_SpinLock lock;
-        SDL_AtomicLock(&lock);
+        SDL_AtomicLockNamed(&lock, SDL_LOCK_NAME);
         if (thread_local_storage == INVALID_PTHREAD_KEY && !generic_local_storage) {
             pthread_key_t storage;
             if (pthread_key_create(&storage, NULL) == 0) {
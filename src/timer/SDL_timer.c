@@ -21,6 +21,8 @@
 #include "SDL_internal.h"
 
 #include "SDL_timer_c.h"
+#include "../SDL_hashtable.h"
+#include "../SDL_hints_c.h"
 #include "../thread/SDL_systhread.h"
 
 /* #define DEBUG_TIMERS */
@@ -30,28 +32,23 @@
 typedef struct SDL_Timer
 {
     int timerID;
-    SDL_TimerCallback callback;
+    SDL_TimerCallback callback_ms;
+    SDL_NSTimerCallback callback_ns;
     void *param;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 dispatched; /* The timer thread wakeup this timer last fired in */
     SDL_AtomicInt canceled;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    int timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-/* The timers are kept in a sorted list */
+/* The timers are kept in a binary heap, ordered by scheduling time */
 typedef struct
 {
     /* Data used by the main thread */
     SDL_Thread *thread;
     SDL_AtomicInt nextID;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap;
     SDL_Mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -64,36 +61,92 @@ typedef struct
     SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    /* List of timers - this is only touched by the timer thread */
-    SDL_Timer *timers;
+    /* Heap of timers - this is only touched by the timer thread */
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
 
+static int SDL_ParseTimerSlack(const char *value, int default_value)
+{
+    if (value && *value) {
+        return SDL_max(SDL_atoi(value), 0);
+    }
+    return default_value;
+}
+
+static SDL_HintCache SDL_timer_slack = SDL_HINT_CACHE_INIT(SDL_HINT_TIMER_SLACK, SDL_ParseTimerSlack, 0);
+
 /* The idea here is that any thread might add a timer, but a single
  * thread manages the active timer queue, sorted by scheduling time.
  *
  * Timers are removed by simply setting a canceled flag
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+static void SDL_SiftTimerUp(SDL_TimerData *data, int i)
 {
-    SDL_Timer *prev, *curr;
+    SDL_Timer **timers = data->timers;
+    SDL_Timer *timer = timers[i];
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+    while (i > 0) {
+        const int parent = (i - 1) / 2;
+        if (timers[parent]->scheduled <= timer->scheduled) {
             break;
         }
+        timers[i] = timers[parent];
+        i = parent;
     }
+    timers[i] = timer;
+}
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
-    } else {
-        data->timers = timer;
+static void SDL_SiftTimerDown(SDL_TimerData *data, int i)
+{
+    SDL_Timer **timers = data->timers;
+    SDL_Timer *timer = timers[i];
+    const int count = data->num_timers;
+
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && timers[child + 1]->scheduled < timers[child]->scheduled) {
+            ++child;
+        }
+        if (timer->scheduled <= timers[child]->scheduled) {
+            break;
+        }
+        timers[i] = timers[child];
+        i = child;
+    }
+    timers[i] = timer;
+}
+
+static SDL_bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    if (data->num_timers == data->max_timers) {
+        const int max_timers = data->max_timers ? data->max_timers * 2 : 64;
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return SDL_FALSE;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    data->timers[data->num_timers++] = timer;
+    SDL_SiftTimerUp(data, data->num_timers - 1);
+    return SDL_TRUE;
+}
+
+static void SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    if (--data->num_timers > 0) {
+        data->timers[0] = data->timers[data->num_timers];
+        SDL_SiftTimerDown(data, 0);
     }
-    timer->next = curr;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -103,7 +156,7 @@ static int SDLCALL SDL_TimerThread(void *_data)
     SDL_Timer *current;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
-    Uint64 tick, now, interval, delay;
+    Uint64 tick, now, interval, delay, deadline;
 
     /* Threaded timer loop:
      *  1. Queue timers added by other threads
@@ -112,7 +165,7 @@ static int SDLCALL SDL_TimerThread(void *_data)
      */
     for (;;) {
         /* Pending and freelist maintenance */
-        SDL_AtomicLock(&data->lock);
+        SDL_AtomicLockNamed(&data->lock, SDL_LOCK_NAME);
         {
             /* Get any timers ready to be queued */
             pending = data->pending;
@@ -126,14 +179,23 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_AtomicUnlock(&data->lock);
 
-        /* Sort the pending timers into our list */
+        freelist_head = NULL;
+        freelist_tail = NULL;
+
+        /* Sort the pending timers into our heap */
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (!SDL_AddTimerInternal(data, current)) {
+                /* Out of memory, the timer will never fire */
+                SDL_AtomicSet(&current->canceled, 1);
+                current->next = freelist_head;
+                freelist_head = current;
+                if (!freelist_tail) {
+                    freelist_tail = current;
+                }
+            }
         }
-        freelist_head = NULL;
-        freelist_tail = NULL;
 
         /* Check to see if we're still running, after maintenance */
         if (!SDL_AtomicGet(&data->active)) {
@@ -145,32 +207,50 @@ static int SDLCALL SDL_TimerThread(void *_data)
 
         tick = SDL_GetTicksNS();
 
+        /* If a timer is due, timers due within the slack window are dispatched
+           along with it. A timer that already fired in this wakeup waits until
+           it's really due, and so does everything after a spurious wakeup. */
+        deadline = tick;
+        if (data->num_timers > 0 && data->timers[0]->scheduled <= tick) {
+            deadline += SDL_US_TO_NS((Uint64)SDL_GetCachedHint(&SDL_timer_slack));
+        }
+
         /* Process all the pending timers for this tick */
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
-            if (tick < current->scheduled) {
+            if (current->scheduled > deadline || (current->scheduled > tick && current->dispatched == tick)) {
                 /* Scheduled for the future, wait a bit */
                 delay = (current->scheduled - tick);
                 break;
             }
 
             /* We're going to do something with this timer */
-            data->timers = current->next;
-
+            current->dispatched = tick;
             if (SDL_AtomicGet(&current->canceled)) {
                 interval = 0;
+            } else if (current->callback_ns) {
+                interval = current->callback_ns(current->param, current->timerID, current->interval);
             } else {
-                /* FIXME: We could potentially support sub-millisecond timers now */
-                interval = SDL_MS_TO_NS(current->callback((Uint32)SDL_NS_TO_MS(current->interval), current->param));
+                interval = SDL_MS_TO_NS(current->callback_ms((Uint32)SDL_NS_TO_MS(current->interval), current->param));
             }
 
             if (interval > 0) {
-                /* Reschedule this timer */
+                /* Reschedule this timer relative to when it was due, so it
+                   doesn't drift. If we've fallen behind by a whole interval,
+                   skip the missed iterations instead of bursting to catch up.
+                   The timer is still at the top of the heap.
+                 */
                 current->interval = interval;
-                current->scheduled = tick + interval;
-                SDL_AddTimerInternal(data, current);
+                current->scheduled += interval;
+                if (current->scheduled <= tick) {
+                    current->scheduled = tick + interval;
+                }
+                SDL_SiftTimerDown(data, 0);
             } else {
+                SDL_RemoveFirstTimer(data);
+
+                current->next = NULL;
                 if (!freelist_head) {
                     freelist_head = current;
                 }
@@ -202,19 +282,31 @@ static int SDLCALL SDL_TimerThread(void *_data)
     return 0;
 }
 
+static void SDL_NukeTimerMapEntry(const void *key, const void *value, void *data)
+{
+    /* The timers are freed separately */
+}
+
 int SDL_InitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
 
     if (!SDL_AtomicGet(&data->active)) {
         const char *name = "SDLTimer";
-        data->timermap_lock = SDL_CreateMutex();
+        data->timermap_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         if (!data->timermap_lock) {
             return -1;
         }
 
+        data->timermap = SDL_CreateHashTable(NULL, 64, SDL_HashID, SDL_KeyMatchID, SDL_NukeTimerMapEntry, SDL_FALSE);
+        if (!data->timermap) {
+            SDL_DestroyMutex(data->timermap_lock);
+            return -1;
+        }
+
         data->sem = SDL_CreateSemaphore(0);
         if (!data->sem) {
+            SDL_DestroyHashTable(data->timermap);
             SDL_DestroyMutex(data->timermap_lock);
             return -1;
         }
@@ -237,7 +329,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (SDL_AtomicCAS(&data->active, 1, 0)) { /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -251,9 +343,17 @@ void SDL_QuitTimers(void)
         data->sem = NULL;
 
         /* Clean up the timer entries */
-        while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
+        for (i = 0; i < data->num_timers; ++i) {
+            SDL_free(data->timers[i]);
+        }
+        SDL_free(data->timers);
+        data->timers = NULL;
+        data->num_timers = 0;
+        data->max_timers = 0;
+
+        while (data->pending) {
+            timer = data->pending;
+            data->pending = timer->next;
             SDL_free(timer);
         }
         while (data->freelist) {
@@ -261,24 +361,27 @@ void SDL_QuitTimers(void)
             data->freelist = timer->next;
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
-        }
+
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
     }
 }
 
-SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    SDL_bool inserted;
+
+    if (!callback_ms && !callback_ns) {
+        SDL_InvalidParamError("callback");
+        return 0;
+    }
 
-    SDL_AtomicLock(&data->lock);
+    SDL_AtomicLockNamed(&data->lock, SDL_LOCK_NAME);
     if (!SDL_AtomicGet(&data->active)) {
         if (SDL_InitTimers() < 0) {
             SDL_AtomicUnlock(&data->lock);
@@ -301,27 +404,25 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
         }
     }
     timer->timerID = SDL_AtomicIncRef(&data->nextID);
-    timer->callback = callback;
+    timer->callback_ms = callback_ms;
+    timer->callback_ns = callback_ns;
     timer->param = param;
-    timer->interval = SDL_MS_TO_NS(interval);
+    timer->interval = interval;
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
+    timer->dispatched = 0;
     SDL_AtomicSet(&timer->canceled, 0);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
+    SDL_LockMutex(data->timermap_lock);
+    inserted = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer);
+    SDL_UnlockMutex(data->timermap_lock);
+
+    if (!inserted) {
         SDL_free(timer);
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
-    SDL_AtomicLock(&data->lock);
+    SDL_AtomicLockNamed(&data->lock, SDL_LOCK_NAME);
     timer->next = data->pending;
     data->pending = timer;
     SDL_AtomicUnlock(&data->lock);
@@ -329,36 +430,42 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     /* Wake up the timer thread if necessary */
     SDL_PostSemaphore(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
+}
+
+SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, param);
+}
+
+SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *userdata)
+{
+    return SDL_CreateTimer(interval, NULL, callback, userdata);
 }
 
 SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_Timer *timer = NULL;
     SDL_bool canceled = SDL_FALSE;
 
+    if (!id) {
+        return SDL_FALSE;
+    }
+
     /* Find the timer */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
+    if (data->timermap &&
+        SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, (const void **)&timer)) {
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
     }
     SDL_UnlockMutex(data->timermap_lock);
 
-    if (entry) {
-        if (!SDL_AtomicGet(&entry->timer->canceled)) {
-            SDL_AtomicSet(&entry->timer->canceled, 1);
+    if (timer) {
+        if (!SDL_AtomicGet(&timer->canceled)) {
+            SDL_AtomicSet(&timer->canceled, 1);
             canceled = SDL_TRUE;
         }
-        SDL_free(entry);
     }
     return canceled;
 }
@@ -372,8 +479,9 @@ typedef struct SDL_TimerMap
 {
     int timerID;
     int timeoutID;
-    Uint32 interval;
-    SDL_TimerCallback callback;
+    Uint64 interval;
+    SDL_TimerCallback callback_ms;
+    SDL_NSTimerCallback callback_ns;
     void *param;
     struct SDL_TimerMap *next;
 } SDL_TimerMap;
@@ -389,10 +497,14 @@ static SDL_TimerData SDL_timer_data;
 static void SDL_Emscripten_TimerHelper(void *userdata)
 {
     SDL_TimerMap *entry = (SDL_TimerMap *)userdata;
-    entry->interval = entry->callback(entry->interval, entry->param);
+    if (entry->callback_ns) {
+        entry->interval = entry->callback_ns(entry->param, entry->timerID, entry->interval);
+    } else {
+        entry->interval = SDL_MS_TO_NS(entry->callback_ms((Uint32)SDL_NS_TO_MS(entry->interval), entry->param));
+    }
     if (entry->interval > 0) {
         entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
-                                                  entry->interval,
+                                                  (double)entry->interval / SDL_NS_PER_MS,
                                                   entry);
     }
 }
@@ -414,22 +526,28 @@ void SDL_QuitTimers(void)
     }
 }
 
-SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *param)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_TimerMap *entry;
 
+    if (!callback_ms && !callback_ns) {
+        SDL_InvalidParamError("callback");
+        return 0;
+    }
+
     entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
     if (!entry) {
         return 0;
     }
     entry->timerID = ++data->nextID;
-    entry->callback = callback;
+    entry->callback_ms = callback_ms;
+    entry->callback_ns = callback_ns;
     entry->param = param;
     entry->interval = interval;
 
     entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
-                                              entry->interval,
+                                              (double)entry->interval / SDL_NS_PER_MS,
                                               entry);
 
     entry->next = data->timermap;
@@ -438,6 +556,16 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     return entry->timerID;
 }
 
+SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *param)
+{
+    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, param);
+}
+
+SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *userdata)
+{
+    return SDL_CreateTimer(interval, NULL, callback, userdata);
+}
+
 SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
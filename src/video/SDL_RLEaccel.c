@@ -60,6 +60,12 @@
  *   The end of the sequence is marked by a zero <skip>,<run> pair at the *
  *   beginning of a line.
  *
+ *   Every scan line is encoded, even blank ones, and the offset of each line
+ *   in the encoded data is kept in a separate table. This lets blits start
+ *   directly at the first visible line, lets scaled blits pick the source
+ *   line for each destination line, and lets a lock that only modifies a
+ *   few lines re-encode just those lines.
+ *
  * Encoding of surfaces with per-pixel alpha:
  *
  *   The sequence begins with a struct RLEDestFormat describing the target
@@ -88,8 +94,20 @@
  */
 
 #include "SDL_sysvideo.h"
+#include "SDL_video_c.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
+#include "SDL_pixels_c.h"
+
+/* The encoded data of a colorkeyed surface */
+typedef struct RLEColorkeyData
+{
+    Uint8 *buf;       /* encoded lines, followed by the end marker */
+    size_t size;      /* size of the encoded data in bytes */
+    size_t *lines;    /* offset of each line in buf, h + 1 entries */
+    int dirty_y0;     /* range of lines modified while locked */
+    int dirty_y1;
+} RLEColorkeyData;
 
 #define PIXEL_COPY(to, from, len, bpp) \
     SDL_memcpy(to, from, (size_t)(len) * (bpp))
@@ -441,73 +459,87 @@ static void RLEClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
 
 #undef RLECLIPBLIT
 
-/* blit a colorkeyed RLE surface */
-static int SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
-                               SDL_Surface *surf_dst, const SDL_Rect *dstrect)
+/*
+ * Nearest neighbour scaling: each destination line is produced from the
+ * source line it maps to, stepping through the segments of that line as
+ * the destination pixels advance.
+ */
+#define RLESCALEBLIT(bpp, Type, do_blit)                                          \
+    do {                                                                          \
+        int linecount = dstrect->h;                                               \
+        Uint32 posy = incy / 2;                                                   \
+        while (linecount--) {                                                     \
+            Uint8 *line = rle->buf + rle->lines[srcrect->y + (posy >> 16)];      \
+            Uint8 *runbuf = line;                                                 \
+            Uint8 *dstp = dstbuf;                                                 \
+            Uint32 posx = incx / 2;                                               \
+            int count = dstrect->w;                                               \
+            int ofs = 0;                                                          \
+            int start = 0;                                                        \
+            int end = 0;                                                          \
+            while (count--) {                                                     \
+                int col = srcrect->x + (int)(posx >> 16);                         \
+                while (col >= end && ofs < w) {                                   \
+                    ofs += *(Type *)line;                                         \
+                    start = ofs;                                                  \
+                    ofs += ((Type *)line)[1];                                     \
+                    end = ofs;                                                    \
+                    runbuf = line + 2 * sizeof(Type);                             \
+                    line = runbuf + (end - start) * bpp;                          \
+                }                                                                 \
+                if (col >= end) {                                                 \
+                    /* the rest of the line is transparent */                     \
+                    break;                                                        \
+                }                                                                 \
+                if (col >= start) {                                               \
+                    do_blit(dstp, runbuf + (col - start) * bpp, 1, bpp, alpha);   \
+                }                                                                 \
+                dstp += bpp;                                                      \
+                posx += incx;                                                     \
+            }                                                                     \
+            dstbuf += surf_dst->pitch;                                            \
+            posy += incy;                                                         \
+        }                                                                         \
+    } while (0)
+
+static void RLEScaleBlit(const RLEColorkeyData *rle, int w, SDL_Surface *surf_dst,
+                         Uint8 *dstbuf, const SDL_Rect *srcrect,
+                         const SDL_Rect *dstrect, unsigned alpha)
+{
+    SDL_PixelFormat *fmt = surf_dst->format;
+    int incy = (srcrect->h << 16) / dstrect->h;
+    int incx = (srcrect->w << 16) / dstrect->w;
+
+    CHOOSE_BLIT(RLESCALEBLIT, alpha, fmt);
+}
+
+#undef RLESCALEBLIT
+
+/* blit a colorkeyed RLE surface, the destination must be locked */
+static void RLEBlitLines(SDL_Surface *surf_src, const SDL_Rect *srcrect,
+                         SDL_Surface *surf_dst, const SDL_Rect *dstrect)
 {
+    RLEColorkeyData *rle = (RLEColorkeyData *)surf_src->map->data;
     Uint8 *dstbuf;
     Uint8 *srcbuf;
     int x, y;
     int w = surf_src->w;
     unsigned alpha;
 
-    /* Lock the destination if necessary */
-    if (SDL_MUSTLOCK(surf_dst)) {
-        if (SDL_LockSurface(surf_dst) < 0) {
-            return -1;
-        }
-    }
-
     /* Set up the source and destination pointers */
     x = dstrect->x;
     y = dstrect->y;
     dstbuf = (Uint8 *)surf_dst->pixels + y * surf_dst->pitch + x * surf_src->format->BytesPerPixel;
-    srcbuf = (Uint8 *)surf_src->map->data;
 
-    {
-        /* skip lines at the top if necessary */
-        int vskip = srcrect->y;
-        int ofs = 0;
-        if (vskip) {
-
-#define RLESKIP(bpp, Type)          \
-    for (;;) {                      \
-        int run;                    \
-        ofs += *(Type *)srcbuf;     \
-        run = ((Type *)srcbuf)[1];  \
-        srcbuf += sizeof(Type) * 2; \
-        if (run) {                  \
-            srcbuf += run * bpp;    \
-            ofs += run;             \
-        } else if (!ofs)            \
-            goto done;              \
-        if (ofs == w) {             \
-            ofs = 0;                \
-            if (!--vskip)           \
-                break;              \
-        }                           \
+    alpha = surf_src->map->info.a;
+    if (srcrect->w != dstrect->w || srcrect->h != dstrect->h) {
+        RLEScaleBlit(rle, w, surf_dst, dstbuf, srcrect, dstrect, alpha);
+        return;
     }
 
-            switch (surf_src->format->BytesPerPixel) {
-            case 1:
-                RLESKIP(1, Uint8);
-                break;
-            case 2:
-                RLESKIP(2, Uint8);
-                break;
-            case 3:
-                RLESKIP(3, Uint8);
-                break;
-            case 4:
-                RLESKIP(4, Uint16);
-                break;
-            }
-
-#undef RLESKIP
-        }
-    }
+    /* skip lines at the top if necessary */
+    srcbuf = rle->buf + rle->lines[srcrect->y];
 
-    alpha = surf_src->map->info.a;
     /* if left or right edge clipping needed, call clip blit */
     if (srcrect->x || srcrect->w != surf_src->w) {
         RLEClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect, alpha);
@@ -542,8 +574,21 @@ static int SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
 
 #undef RLEBLIT
     }
+}
+
+/* blit a colorkeyed RLE surface */
+static int SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
+                               SDL_Surface *surf_dst, const SDL_Rect *dstrect)
+{
+    /* Lock the destination if necessary */
+    if (SDL_MUSTLOCK(surf_dst)) {
+        if (SDL_LockSurfaceRect(surf_dst, dstrect) < 0) {
+            return -1;
+        }
+    }
+
+    RLEBlitLines(surf_src, srcrect, surf_dst, dstrect);
 
-done:
     /* Unlock the destination if necessary */
     if (SDL_MUSTLOCK(surf_dst)) {
         SDL_UnlockSurface(surf_dst);
@@ -727,7 +772,7 @@ static int SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcre
 
     /* Lock the destination if necessary */
     if (SDL_MUSTLOCK(surf_dst)) {
-        if (SDL_LockSurface(surf_dst) < 0) {
+        if (SDL_LockSurfaceRect(surf_dst, dstrect) < 0) {
             return -1;
         }
     }
@@ -1265,54 +1310,25 @@ static const getpix_func getpixes[4] = {
     getpix_8, getpix_16, getpix_24, getpix_32
 };
 
-static int RLEColorkeySurface(SDL_Surface *surface)
+/* calculate the worst case size for one compressed line */
+static size_t RLEColorkeyMaxLineSize(int w, int bpp)
 {
-    Uint8 *rlebuf, *dst;
-    int maxn;
-    int y;
-    Uint8 *srcbuf, *lastline;
-    int maxsize = 0;
-    const int bpp = surface->format->BytesPerPixel;
-    getpix_func getpix;
-    Uint32 ckey, rgbmask;
-    int w, h;
-
-    /* calculate the worst case size for the compressed surface */
     switch (bpp) {
     case 1:
         /* worst case is alternating opaque and transparent pixels,
            starting with an opaque pixel */
-        maxsize = surface->h * 3 * (surface->w / 2 + 1) + 2;
-        break;
+        return (size_t)3 * (w / 2 + 1);
     case 2:
     case 3:
         /* worst case is solid runs, at most 255 pixels wide */
-        maxsize = surface->h * (2 * (surface->w / 255 + 1) + surface->w * bpp) + 2;
-        break;
+        return (size_t)2 * (w / 255 + 1) + (size_t)w * bpp;
     case 4:
         /* worst case is solid runs, at most 65535 pixels wide */
-        maxsize = surface->h * (4 * (surface->w / 65535 + 1) + surface->w * 4) + 4;
-        break;
-
+        return (size_t)4 * (w / 65535 + 1) + (size_t)w * 4;
     default:
-        return -1;
+        return 0;
     }
-
-    rlebuf = (Uint8 *)SDL_malloc(maxsize);
-    if (!rlebuf) {
-        return -1;
-    }
-
-    /* Set up the conversion */
-    srcbuf = (Uint8 *)surface->pixels;
-    maxn = bpp == 4 ? 65535 : 255;
-    dst = rlebuf;
-    rgbmask = ~surface->format->Amask;
-    ckey = surface->map->info.colorkey & rgbmask;
-    lastline = dst;
-    getpix = getpixes[bpp - 1];
-    w = surface->w;
-    h = surface->h;
+}
 
 #define ADD_COUNTS(n, m)                \
     if (bpp == 4) {                     \
@@ -1325,10 +1341,24 @@ static int RLEColorkeySurface(SDL_Surface *surface)
         dst += 2;                       \
     }
 
-    for (y = 0; y < h; y++) {
+/* encode lines [y0, y1) of the surface into dst, recording their offsets */
+static Uint8 *RLEColorkeyLines(SDL_Surface *surface, Uint8 *dst, size_t *lines, int y0, int y1)
+{
+    const int bpp = surface->format->BytesPerPixel;
+    const int maxn = bpp == 4 ? 65535 : 255;
+    const getpix_func getpix = getpixes[bpp - 1];
+    const Uint32 rgbmask = ~surface->format->Amask;
+    const Uint32 ckey = surface->map->info.colorkey & rgbmask;
+    const int w = surface->w;
+    Uint8 *linestart = dst;
+    Uint8 *srcbuf = (Uint8 *)surface->pixels + y0 * surface->pitch;
+    int y;
+
+    for (y = y0; y < y1; y++) {
         int x = 0;
-        int blankline = 0;
-        do {
+
+        lines[y - y0] = dst - linestart;
+        while (x < w) {
             int run, skip;
             int len;
             int runstart;
@@ -1343,9 +1373,6 @@ static int RLEColorkeySurface(SDL_Surface *surface)
                 x++;
             }
             skip = runstart - skipstart;
-            if (skip == w) {
-                blankline = 1;
-            }
             run = x - runstart;
 
             /* encode segment */
@@ -1367,19 +1394,16 @@ static int RLEColorkeySurface(SDL_Surface *surface)
                 runstart += len;
                 run -= len;
             }
-            if (!blankline) {
-                lastline = dst;
-            }
-        } while (x < w);
+        }
 
         srcbuf += surface->pitch;
     }
-    dst = lastline; /* back up bast trailing blank lines */
-    ADD_COUNTS(0, 0);
-
-#undef ADD_COUNTS
+    return dst;
+}
 
-    /* Now that we have it encoded, release the original pixels */
+/* free the pixels of an encoded surface, unless they belong to the application */
+static void RLEColorkeyReleasePixels(SDL_Surface *surface)
+{
     if (!(surface->flags & SDL_PREALLOC)) {
         if (surface->flags & SDL_SIMD_ALIGNED) {
             SDL_aligned_free(surface->pixels);
@@ -1389,20 +1413,145 @@ static int RLEColorkeySurface(SDL_Surface *surface)
         }
         surface->pixels = NULL;
     }
+}
+
+static int RLEColorkeySurface(SDL_Surface *surface)
+{
+    RLEColorkeyData *rle;
+    Uint8 *dst;
+    size_t maxline, maxsize;
+    const int bpp = surface->format->BytesPerPixel;
+
+    maxline = RLEColorkeyMaxLineSize(surface->w, bpp);
+    if (!maxline) {
+        return -1;
+    }
+    if (SDL_size_mul_overflow(maxline, surface->h, &maxsize) ||
+        SDL_size_add_overflow(maxsize, 4, &maxsize)) {
+        return -1;
+    }
+
+    rle = (RLEColorkeyData *)SDL_calloc(1, sizeof(*rle));
+    if (!rle) {
+        return -1;
+    }
+    rle->lines = (size_t *)SDL_malloc((surface->h + 1) * sizeof(*rle->lines));
+    rle->buf = (Uint8 *)SDL_malloc(maxsize);
+    if (!rle->lines || !rle->buf) {
+        SDL_free(rle->lines);
+        SDL_free(rle->buf);
+        SDL_free(rle);
+        return -1;
+    }
+
+    /* Encode every line, then mark the end of the sequence */
+    dst = RLEColorkeyLines(surface, rle->buf, rle->lines, 0, surface->h);
+    rle->lines[surface->h] = dst - rle->buf;
+    ADD_COUNTS(0, 0);
+    rle->size = dst - rle->buf;
+
+    /* Now that we have it encoded, release the original pixels */
+    RLEColorkeyReleasePixels(surface);
 
     /* reallocate the buffer to release unused memory */
     {
         /* If SDL_realloc returns NULL, the original block is left intact */
-        Uint8 *p = SDL_realloc(rlebuf, dst - rlebuf);
+        Uint8 *p = SDL_realloc(rle->buf, rle->size);
+        if (p) {
+            rle->buf = p;
+        }
+    }
+    surface->map->data = rle;
+
+    return 0;
+}
+
+/* re-encode lines [y0, y1) in place, leaving the other lines untouched */
+static int RLEColorkeyUpdateLines(SDL_Surface *surface, int y0, int y1)
+{
+    RLEColorkeyData *rle = (RLEColorkeyData *)surface->map->data;
+    const int bpp = surface->format->BytesPerPixel;
+    const int h = surface->h;
+    size_t *lines;
+    Uint8 *tmp, *end;
+    size_t oldlen, newlen, newsize, tail;
+    int y;
+
+    tmp = (Uint8 *)SDL_malloc(RLEColorkeyMaxLineSize(surface->w, bpp) * (y1 - y0));
+    lines = (size_t *)SDL_malloc((y1 - y0) * sizeof(*lines));
+    if (!tmp || !lines) {
+        SDL_free(tmp);
+        SDL_free(lines);
+        return -1;
+    }
+    end = RLEColorkeyLines(surface, tmp, lines, y0, y1);
+
+    oldlen = rle->lines[y1] - rle->lines[y0];
+    newlen = end - tmp;
+    tail = rle->size - rle->lines[y1];
+    newsize = rle->size - oldlen + newlen;
+
+    /* move the following lines out of the way and splice in the new ones */
+    if (newlen > oldlen) {
+        Uint8 *p = (Uint8 *)SDL_realloc(rle->buf, newsize);
         if (!p) {
-            p = rlebuf;
+            SDL_free(tmp);
+            SDL_free(lines);
+            return -1;
+        }
+        rle->buf = p;
+    }
+    SDL_memmove(rle->buf + rle->lines[y0] + newlen, rle->buf + rle->lines[y1], tail);
+    SDL_memcpy(rle->buf + rle->lines[y0], tmp, newlen);
+    if (newlen < oldlen) {
+        /* If SDL_realloc returns NULL, the original block is left intact */
+        Uint8 *p = (Uint8 *)SDL_realloc(rle->buf, newsize);
+        if (p) {
+            rle->buf = p;
         }
-        surface->map->data = p;
     }
 
+    for (y = y0 + 1; y < y1; y++) {
+        rle->lines[y] = rle->lines[y0] + lines[y - y0];
+    }
+    for (y = y1; y <= h; y++) {
+        rle->lines[y] = rle->lines[y] - oldlen + newlen;
+    }
+    rle->size = newsize;
+
+    SDL_free(tmp);
+    SDL_free(lines);
     return 0;
 }
 
+#undef ADD_COUNTS
+
+/* re-create the original pixels of a colorkeyed surface */
+static SDL_bool RLEColorkeyDecode(SDL_Surface *surface)
+{
+    SDL_Rect full;
+    size_t size;
+
+    if (SDL_size_mul_overflow(surface->h, surface->pitch, &size)) {
+        return SDL_FALSE;
+    }
+    surface->pixels = SDL_aligned_alloc(SDL_SIMDGetAlignment(), size);
+    if (!surface->pixels) {
+        return SDL_FALSE;
+    }
+    surface->flags |= SDL_SIMD_ALIGNED;
+
+    /* fill it with the background color */
+    SDL_FillSurfaceRect(surface, NULL, surface->map->info.colorkey);
+
+    /* now render the encoded surface */
+    full.x = full.y = 0;
+    full.w = surface->w;
+    full.h = surface->h;
+    RLEBlitLines(surface, &full, surface, &full);
+    return SDL_TRUE;
+}
+
 int SDL_RLESurface(SDL_Surface *surface)
 {
     int flags;
@@ -1435,8 +1584,13 @@ int SDL_RLESurface(SDL_Surface *surface)
     /* Pass on combinations not supported */
     if ((flags & SDL_COPY_MODULATE_COLOR) ||
         ((flags & SDL_COPY_MODULATE_ALPHA) && surface->format->Amask) ||
-        (flags & (SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) ||
-        (flags & SDL_COPY_NEAREST)) {
+        (flags & (SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
+        return -1;
+    }
+
+    /* Only the colorkey blitter knows how to scale */
+    if ((flags & SDL_COPY_NEAREST) &&
+        surface->format->Amask && (flags & SDL_COPY_BLEND)) {
         return -1;
     }
 
@@ -1556,47 +1710,80 @@ void SDL_UnRLESurface(SDL_Surface *surface, int recode)
     if (surface->flags & SDL_RLEACCEL) {
         surface->flags &= ~SDL_RLEACCEL;
 
-        if (recode && !(surface->flags & SDL_PREALLOC)) {
-            if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
-                SDL_Rect full;
-                size_t size;
+        if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
+            RLEColorkeyData *rle = (RLEColorkeyData *)surface->map->data;
 
-                /* re-create the original surface */
-                if (SDL_size_mul_overflow(surface->h, surface->pitch, &size)) {
-                    /* Memory corruption? */
-                    surface->flags |= SDL_RLEACCEL;
-                    return;
-                }
-                surface->pixels = SDL_aligned_alloc(SDL_SIMDGetAlignment(), size);
-                if (!surface->pixels) {
+            /* The pixels are still around if the surface is locked */
+            if (recode && !surface->pixels) {
+                if (!RLEColorkeyDecode(surface)) {
                     /* Oh crap... */
                     surface->flags |= SDL_RLEACCEL;
                     return;
                 }
-                surface->flags |= SDL_SIMD_ALIGNED;
-
-                /* fill it with the background color */
-                SDL_FillSurfaceRect(surface, NULL, surface->map->info.colorkey);
-
-                /* now render the encoded surface */
-                full.x = full.y = 0;
-                full.w = surface->w;
-                full.h = surface->h;
-                SDL_RLEBlit(surface, &full, surface, &full);
-            } else {
+            }
+            SDL_free(rle->buf);
+            SDL_free(rle->lines);
+            SDL_free(rle);
+        } else {
+            if (recode && !(surface->flags & SDL_PREALLOC)) {
                 if (!UnRLEAlpha(surface)) {
                     /* Oh crap... */
                     surface->flags |= SDL_RLEACCEL;
                     return;
                 }
             }
+            SDL_free(surface->map->data);
         }
         surface->map->info.flags &=
             ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY);
 
-        SDL_free(surface->map->data);
         surface->map->data = NULL;
     }
 }
 
+int SDL_LockRLESurface(SDL_Surface *surface, int y0, int y1)
+{
+    RLEColorkeyData *rle = (RLEColorkeyData *)surface->map->data;
+
+    /* Decode the pixels, they are kept until the last unlock */
+    if (!surface->pixels) {
+        if (!RLEColorkeyDecode(surface)) {
+            return SDL_OutOfMemory();
+        }
+    }
+
+    if (y0 < y1) {
+        if (rle->dirty_y0 < rle->dirty_y1) {
+            rle->dirty_y0 = SDL_min(rle->dirty_y0, y0);
+            rle->dirty_y1 = SDL_max(rle->dirty_y1, y1);
+        } else {
+            rle->dirty_y0 = y0;
+            rle->dirty_y1 = y1;
+        }
+    }
+    return 0;
+}
+
+void SDL_UnlockRLESurface(SDL_Surface *surface)
+{
+    RLEColorkeyData *rle = (RLEColorkeyData *)surface->map->data;
+
+    if (rle->dirty_y0 < rle->dirty_y1) {
+        int y0 = rle->dirty_y0;
+        int y1 = rle->dirty_y1;
+
+        rle->dirty_y0 = rle->dirty_y1 = 0;
+        if (RLEColorkeyUpdateLines(surface, y0, y1) < 0) {
+            /* Fall back to encoding the whole surface, which releases the pixels */
+            if (SDL_RLESurface(surface) < 0) {
+                SDL_InvalidateMap(surface->map);
+            }
+            return;
+        }
+    }
+
+    /* Only the encoded data is kept while the surface isn't locked */
+    RLEColorkeyReleasePixels(surface);
+}
+
 #endif /* SDL_HAVE_RLE */
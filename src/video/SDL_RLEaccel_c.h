@@ -28,5 +28,7 @@
 
 extern int SDL_RLESurface(SDL_Surface *surface);
 extern void SDL_UnRLESurface(SDL_Surface *surface, int recode);
+extern int SDL_LockRLESurface(SDL_Surface *surface, int y0, int y1);
+extern void SDL_UnlockRLESurface(SDL_Surface *surface);
 
 #endif /* SDL_RLEaccel_c_h_ */
@@ -21,12 +21,97 @@
 #include "SDL_internal.h"
 
 #include "SDL_sysvideo.h"
+#include "SDL_video_c.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
 #include "SDL_blit_copy.h"
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../SDL_hints_c.h"
+
+/* Large blits can be split into horizontal bands and run on the shared job
+   pool, see SDL_HINT_SURFACE_BLIT_THREADS. Each band gets its own copy of the
+   SDL_BlitInfo with the pointers and heights adjusted, so any blitter works
+   without changes.
+ */
+#define SDL_BLIT_THREAD_MIN_PIXELS  (512 * 512)
+#define SDL_BLIT_BAND_MIN_PIXELS    (64 * 1024)
+#define SDL_BLIT_MAX_THREADS        16
+
+typedef struct SDL_BlitBands
+{
+    SDL_BlitFunc blit;
+    const SDL_BlitInfo *info;
+    int num_bands;
+} SDL_BlitBands;
+
+static void SDLCALL SDL_RunBlitBands(void *data, int start, int end)
+{
+    const SDL_BlitBands *bands = (const SDL_BlitBands *)data;
+    const SDL_BlitInfo *info = bands->info;
+    int band;
+
+    for (band = start; band < end; ++band) {
+        SDL_BlitInfo band_info = *info;
+        int y0 = (int)(((Sint64)info->dst_h * band) / bands->num_bands);
+        int y1 = (int)(((Sint64)info->dst_h * (band + 1)) / bands->num_bands);
+
+        band_info.src += y0 * info->src_pitch;
+        band_info.dst += y0 * info->dst_pitch;
+        band_info.src_h = band_info.dst_h = y1 - y0;
+        bands->blit(&band_info);
+    }
+}
+
+static int SDL_ParseBlitThreads(const char *value, int default_value)
+{
+    int count = (value && *value) ? SDL_atoi(value) : default_value;
+
+    if (count <= 0) {
+        count = SDL_GetCPUCount();
+    }
+    return SDL_min(count, SDL_BLIT_MAX_THREADS);
+}
+
+/* Returns the number of threads that should take part in blits, including the caller */
+static int SDL_GetBlitThreadCount(void)
+{
+    static SDL_HintCache hint = SDL_HINT_CACHE_INIT(SDL_HINT_SURFACE_BLIT_THREADS, SDL_ParseBlitThreads, 1);
+
+    return SDL_GetCachedHint(&hint);
+}
+
+static SDL_bool SDL_ParallelBlit(SDL_BlitFunc blit, const SDL_BlitInfo *info)
+{
+    Sint64 pixels = (Sint64)info->dst_w * info->dst_h;
+    SDL_BlitBands bands;
+
+    if (pixels < SDL_BLIT_THREAD_MIN_PIXELS ||
+        info->src_w != info->dst_w || info->src_h != info->dst_h ||
+        (info->flags & SDL_COPY_NEAREST)) {
+        return SDL_FALSE;
+    }
+
+    /* Bands of an overlapping blit would race each other */
+    if (info->src < info->dst + (size_t)info->dst_h * info->dst_pitch &&
+        info->dst < info->src + (size_t)info->src_h * info->src_pitch) {
+        return SDL_FALSE;
+    }
+
+    bands.blit = blit;
+    bands.info = info;
+    bands.num_bands = (int)SDL_min(SDL_GetBlitThreadCount(), pixels / SDL_BLIT_BAND_MIN_PIXELS);
+    if (bands.num_bands < 2) {
+        return SDL_FALSE;
+    }
+
+    /* One band per job, the calling thread runs the first one */
+    if (SDL_ParallelFor(NULL, bands.num_bands, 1, SDL_RunBlitBands, &bands) < 0) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
 
 /* The general purpose software blit routine */
 static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
@@ -42,7 +127,7 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
-        if (SDL_LockSurface(dst) < 0) {
+        if (SDL_LockSurfaceRect(dst, dstrect) < 0) {
             okay = 0;
         } else {
             dst_locked = 1;
@@ -51,7 +136,7 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     /* Lock the source if it's in hardware */
     src_locked = 0;
     if (SDL_MUSTLOCK(src)) {
-        if (SDL_LockSurface(src) < 0) {
+        if (SDL_LockSurfaceReadOnly(src) < 0) {
             okay = 0;
         } else {
             src_locked = 1;
@@ -83,7 +168,9 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
         RunBlit = (SDL_BlitFunc)src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        if (!SDL_ParallelBlit(RunBlit, info)) {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -122,10 +209,8 @@ static SDL_bool SDL_UseAltivecPrefetch(void)
 }
 #endif /* __MACOS__ */
 
-static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
-                                       SDL_BlitFuncEntry *entries)
+static unsigned int SDL_GetBlitCPUFeatures(void)
 {
-    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
     static unsigned int features = 0x7fffffff;
 
     /* Get the available CPU features */
@@ -156,7 +241,151 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int
             }
         }
     }
+    return features;
+}
+
+#define SDL_BLIT_FLAGCHECK_MASK (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST)
+
+/* The flags that take part in the selection packed into 8 bits */
+#define SDL_BLIT_FLAG_COMBINATIONS 256
+#define SDL_BLIT_FLAG_INDEX(flags) (((flags) & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) | \
+                                    (((flags) & (SDL_BLIT_FLAGCHECK_MASK & ~(SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA))) >> 2))
+#define SDL_BLIT_FLAGS_FROM_INDEX(index) (((index) & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) | \
+                                          (((index) & ~(SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) << 2))
+SDL_COMPILE_TIME_ASSERT(blit_flag_index, SDL_BLIT_FLAG_INDEX(SDL_BLIT_FLAGCHECK_MASK) == SDL_BLIT_FLAG_COMBINATIONS - 1);
+
+/* The generated blitters are indexed by format pair, with the best entry
+   for every combination of flags precomputed, so choosing a blitter is a
+   hash lookup instead of a scan through the whole table. */
+#define SDL_BLIT_INDEX_MAX_PAIRS 64
+#define SDL_BLIT_INDEX_HASH_SIZE (SDL_BLIT_INDEX_MAX_PAIRS * 2)
+#define SDL_BLIT_INDEX_NONE      0xFFFF
+
+typedef struct SDL_BlitFormatPair
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    Uint16 entry[SDL_BLIT_FLAG_COMBINATIONS]; /* index into the table, or SDL_BLIT_INDEX_NONE */
+} SDL_BlitFormatPair;
+
+typedef struct SDL_BlitFuncIndex
+{
+    const SDL_BlitFuncEntry *entries;
+    SDL_bool complete; /* SDL_FALSE if some pairs didn't fit and need a scan */
+    int num_pairs;
+    Uint8 hash[SDL_BLIT_INDEX_HASH_SIZE]; /* pair index + 1, or 0 if empty */
+    SDL_BlitFormatPair pairs[SDL_BLIT_INDEX_MAX_PAIRS];
+} SDL_BlitFuncIndex;
+
+static SDL_BlitFuncIndex SDL_blit_index;
+static SDL_AtomicInt SDL_blit_index_ready;
+static SDL_SpinLock SDL_blit_index_lock;
+
+static Uint32 SDL_HashBlitFormats(Uint32 src_format, Uint32 dst_format)
+{
+    Uint32 hash = (src_format * 0x9E3779B1u) ^ (dst_format * 0x85EBCA77u);
+    return hash ^ (hash >> 16);
+}
+
+static SDL_BlitFormatPair *SDL_FindBlitFormatPair(SDL_BlitFuncIndex *index, Uint32 src_format, Uint32 dst_format)
+{
+    Uint32 slot = SDL_HashBlitFormats(src_format, dst_format);
+    int i;
+
+    for (i = 0; i < SDL_BLIT_INDEX_HASH_SIZE; ++i) {
+        int pair = index->hash[(slot + i) % SDL_BLIT_INDEX_HASH_SIZE];
+        if (pair == 0) {
+            break;
+        }
+        if (index->pairs[pair - 1].src_format == src_format &&
+            index->pairs[pair - 1].dst_format == dst_format) {
+            return &index->pairs[pair - 1];
+        }
+    }
+    return NULL;
+}
+
+static SDL_BlitFormatPair *SDL_AddBlitFormatPair(SDL_BlitFuncIndex *index, Uint32 src_format, Uint32 dst_format)
+{
+    Uint32 slot = SDL_HashBlitFormats(src_format, dst_format);
+    SDL_BlitFormatPair *pair;
+
+    if (index->num_pairs == SDL_BLIT_INDEX_MAX_PAIRS) {
+        return NULL;
+    }
+    while (index->hash[slot % SDL_BLIT_INDEX_HASH_SIZE] != 0) {
+        ++slot;
+    }
+    pair = &index->pairs[index->num_pairs++];
+    index->hash[slot % SDL_BLIT_INDEX_HASH_SIZE] = (Uint8)index->num_pairs;
+    pair->src_format = src_format;
+    pair->dst_format = dst_format;
+    SDL_memset(pair->entry, 0xFF, sizeof(pair->entry));
+    return pair;
+}
+
+static void SDL_BuildBlitFuncIndex(SDL_BlitFuncIndex *index, const SDL_BlitFuncEntry *entries)
+{
+    unsigned int features = SDL_GetBlitCPUFeatures();
+    int i, flags;
+
+    SDL_zerop(index);
+    index->entries = entries;
+    index->complete = SDL_TRUE;
+
+    for (i = 0; entries[i].func; ++i) {
+        SDL_BlitFormatPair *pair;
+
+        if ((entries[i].cpu & features) != entries[i].cpu || i >= SDL_BLIT_INDEX_NONE) {
+            continue;
+        }
+
+        pair = SDL_FindBlitFormatPair(index, entries[i].src_format, entries[i].dst_format);
+        if (!pair) {
+            pair = SDL_AddBlitFormatPair(index, entries[i].src_format, entries[i].dst_format);
+            if (!pair) {
+                index->complete = SDL_FALSE;
+                continue;
+            }
+        }
+
+        /* The first matching entry wins, just like the linear scan */
+        for (flags = 0; flags < SDL_BLIT_FLAG_COMBINATIONS; ++flags) {
+            int flagcheck = SDL_BLIT_FLAGS_FROM_INDEX(flags);
+            if (pair->entry[flags] == SDL_BLIT_INDEX_NONE &&
+                (flagcheck & entries[i].flags) == flagcheck) {
+                pair->entry[flags] = (Uint16)i;
+            }
+        }
+    }
+}
+
+static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
+                                       SDL_BlitFuncEntry *entries)
+{
+    int i, flagcheck = (flags & SDL_BLIT_FLAGCHECK_MASK);
+    unsigned int features;
+
+    if (!SDL_AtomicGet(&SDL_blit_index_ready)) {
+        SDL_AtomicLockNamed(&SDL_blit_index_lock, SDL_LOCK_NAME);
+        if (!SDL_AtomicGet(&SDL_blit_index_ready)) {
+            SDL_BuildBlitFuncIndex(&SDL_blit_index, entries);
+            SDL_AtomicSet(&SDL_blit_index_ready, 1);
+        }
+        SDL_AtomicUnlock(&SDL_blit_index_lock);
+    }
+
+    if (SDL_blit_index.entries == entries) {
+        const SDL_BlitFormatPair *pair = SDL_FindBlitFormatPair(&SDL_blit_index, src_format, dst_format);
+        if (pair) {
+            Uint16 entry = pair->entry[SDL_BLIT_FLAG_INDEX(flagcheck)];
+            return (entry == SDL_BLIT_INDEX_NONE) ? NULL : entries[entry].func;
+        } else if (SDL_blit_index.complete) {
+            return NULL;
+        }
+    }
 
+    features = SDL_GetBlitCPUFeatures();
     for (i = 0; entries[i].func; ++i) {
         /* Check for matching pixel formats */
         if (src_format != entries[i].src_format) {
@@ -183,6 +412,43 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int
 }
 #endif /* SDL_HAVE_BLIT_AUTO */
 
+/* Everything other than the formats that the blitter selection depends on */
+static SDL_bool SDL_MatchBlitCache(const SDL_BlitMap *map, const SDL_BlitCacheEntry *entry)
+{
+    return (entry->flags == map->info.flags &&
+            entry->identity == map->identity &&
+            entry->opaque == (map->info.a == 255));
+}
+
+static SDL_BlitFunc SDL_LookupBlitCache(SDL_BlitMap *map, Uint32 src_format, Uint32 dst_format)
+{
+    int i;
+
+    for (i = 0; i < SDL_BLIT_CACHE_SIZE; ++i) {
+        const SDL_BlitCacheEntry *entry = &map->cache[i];
+        if (entry->func &&
+            entry->src_format == src_format &&
+            entry->dst_format == dst_format &&
+            SDL_MatchBlitCache(map, entry)) {
+            return entry->func;
+        }
+    }
+    return NULL;
+}
+
+static void SDL_AddBlitCache(SDL_BlitMap *map, Uint32 src_format, Uint32 dst_format, SDL_BlitFunc func)
+{
+    SDL_BlitCacheEntry *entry = &map->cache[map->cache_next];
+
+    entry->src_format = src_format;
+    entry->dst_format = dst_format;
+    entry->flags = map->info.flags;
+    entry->identity = map->identity;
+    entry->opaque = (map->info.a == 255);
+    entry->func = func;
+    map->cache_next = (map->cache_next + 1) % SDL_BLIT_CACHE_SIZE;
+}
+
 /* Figure out which of many blit routines to set up on a surface */
 int SDL_CalculateBlit(SDL_Surface *surface)
 {
@@ -218,6 +484,13 @@ int SDL_CalculateBlit(SDL_Surface *surface)
     }
 #endif
 
+    /* See if this combination was chosen recently */
+    blit = SDL_LookupBlitCache(map, surface->format->format, dst->format->format);
+    if (blit) {
+        map->data = blit;
+        return 0;
+    }
+
     /* Choose a standard blit function */
     if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
         blit = SDL_BlitCopy;
@@ -278,6 +551,7 @@ int SDL_CalculateBlit(SDL_Surface *surface)
         SDL_InvalidateMap(map);
         return SDL_SetError("Blit combination not supported");
     }
+    SDL_AddBlitCache(map, surface->format->format, dst->format->format, blit);
 
     return 0;
 }
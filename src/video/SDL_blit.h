@@ -83,6 +83,21 @@ typedef struct
     SDL_BlitFunc func;
 } SDL_BlitFuncEntry;
 
+/* The number of recently chosen blitters remembered by each blit map, so that
+   switching back and forth between blend modes, alpha modulation and the like
+   doesn't have to go through the full blitter selection every time. */
+#define SDL_BLIT_CACHE_SIZE 4
+
+typedef struct
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    int flags;
+    int identity;
+    SDL_bool opaque; /* info.a == 255 */
+    SDL_BlitFunc func;
+} SDL_BlitCacheEntry;
+
 /* Blit mapping definition */
 /* typedef'ed in SDL_surface.h */
 struct SDL_BlitMap
@@ -97,6 +112,9 @@ struct SDL_BlitMap
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    SDL_BlitCacheEntry cache[SDL_BLIT_CACHE_SIZE];
+    int cache_next;
 };
 
 /* Functions found in SDL_blit.c */
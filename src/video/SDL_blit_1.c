@@ -423,6 +423,96 @@ static void Blit1to4Key(SDL_BlitInfo *info)
     }
 }
 
+/* The palette lookup has to be done one pixel at a time, but the key test
+   and the conditional store are done four pixels at a time with a vector
+   compare and a bitwise select, so the loop has no data dependent branches.
+*/
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") Blit1to4KeySSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dstp = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip;
+    Uint32 *palmap = (Uint32 *)info->table;
+    Uint32 ckey = info->colorkey;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vckey = _mm_set1_epi32((int)ckey);
+
+    /* Set up some basic variables */
+    dstskip /= 4;
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            Uint32 indices;
+            __m128i idx, key, p, d;
+
+            SDL_memcpy(&indices, src, sizeof(indices));
+            idx = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)indices), zero), zero);
+            key = _mm_cmpeq_epi32(idx, vckey);
+            p = _mm_set_epi32((int)palmap[src[3]], (int)palmap[src[2]], (int)palmap[src[1]], (int)palmap[src[0]]);
+            d = _mm_loadu_si128((const __m128i *)dstp);
+            _mm_storeu_si128((__m128i *)dstp, _mm_or_si128(_mm_and_si128(key, d), _mm_andnot_si128(key, p)));
+            src += 4;
+            dstp += 4;
+            n -= 4;
+        }
+        while (n--) {
+            if (*src != ckey) {
+                *dstp = palmap[*src];
+            }
+            src++;
+            dstp++;
+        }
+        src += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static void Blit1to4KeyNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dstp = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip;
+    Uint32 *palmap = (Uint32 *)info->table;
+    Uint32 ckey = info->colorkey;
+    const uint32x4_t vckey = vdupq_n_u32(ckey);
+
+    /* Set up some basic variables */
+    dstskip /= 4;
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            const Uint32 indices[4] = { src[0], src[1], src[2], src[3] };
+            const Uint32 pixels[4] = { palmap[src[0]], palmap[src[1]], palmap[src[2]], palmap[src[3]] };
+            uint32x4_t key = vceqq_u32(vld1q_u32(indices), vckey);
+            vst1q_u32(dstp, vbslq_u32(key, vld1q_u32(dstp), vld1q_u32(pixels)));
+            src += 4;
+            dstp += 4;
+            n -= 4;
+        }
+        while (n--) {
+            if (*src != ckey) {
+                *dstp = palmap[*src];
+            }
+            src++;
+            dstp++;
+        }
+        src += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif /* SDL_NEON_INTRINSICS */
+
 static void Blit1toNAlpha(SDL_BlitInfo *info)
 {
     int width = info->dst_w;
@@ -514,6 +604,21 @@ static const SDL_BlitFunc one_blitkey[] = {
     (SDL_BlitFunc)NULL, Blit1to1Key, Blit1to2Key, Blit1to3Key, Blit1to4Key
 };
 
+static SDL_BlitFunc GetBlit1Key(int which)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (which == 4 && SDL_HasSSE2()) {
+        return Blit1to4KeySSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (which == 4 && SDL_HasNEON()) {
+        return Blit1to4KeyNEON;
+    }
+#endif
+    return one_blitkey[which];
+}
+
 SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
 {
     int which;
@@ -530,10 +635,10 @@ SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
         return one_blit[which];
 
     case SDL_COPY_COLORKEY:
-        return one_blitkey[which];
+        return GetBlit1Key(which);
 
     case SDL_COPY_COLORKEY | SDL_COPY_BLEND:  /* this is not super-robust but handles a specific case we found sdl12-compat. */
-        return (surface->map->info.a == 255) ? one_blitkey[which] :
+        return (surface->map->info.a == 255) ? GetBlit1Key(which) :
                 which >= 2 ? Blit1toNAlphaKey : (SDL_BlitFunc)NULL;
 
     case SDL_COPY_BLEND:
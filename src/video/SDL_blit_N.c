@@ -2583,6 +2583,231 @@ static void Blit2to2Key(SDL_BlitInfo *info)
     }
 }
 
+/* Colorkey blits that don't need any per-pixel format conversion reduce to
+   dst = (src & rgbmask) == ckey ? dst : src, which is done several pixels
+   at a time with a vector compare and a bitwise select. The 32-bit case
+   also folds in the alpha fixup done by BlitNtoNKey and friends:
+   the written pixel is (src & and_mask) | or_mask.
+*/
+#if defined(SDL_SSE2_INTRINSICS) || defined(SDL_NEON_INTRINSICS)
+static SDL_bool Can4to4KeySIMD(const SDL_PixelFormat *srcfmt, const SDL_PixelFormat *dstfmt)
+{
+    if (srcfmt->BytesPerPixel != 4 || dstfmt->BytesPerPixel != 4) {
+        return SDL_FALSE;
+    }
+    if (srcfmt->Amask && dstfmt->Amask) {
+        /* Matches the fast path in BlitNtoNKeyCopyAlpha */
+        return (srcfmt->format == dstfmt->format &&
+                (srcfmt->format == SDL_PIXELFORMAT_ARGB8888 ||
+                 srcfmt->format == SDL_PIXELFORMAT_ABGR8888 ||
+                 srcfmt->format == SDL_PIXELFORMAT_BGRA8888 ||
+                 srcfmt->format == SDL_PIXELFORMAT_RGBA8888));
+    }
+    /* Matches the "BPP 4, same rgb" path in BlitNtoNKey */
+    return (srcfmt->Rmask == dstfmt->Rmask &&
+            srcfmt->Gmask == dstfmt->Gmask &&
+            srcfmt->Bmask == dstfmt->Bmask);
+}
+
+static void Get4to4KeyMasks(const SDL_BlitInfo *info, Uint32 *rgbmask, Uint32 *ckey, Uint32 *and_mask, Uint32 *or_mask)
+{
+    const SDL_PixelFormat *srcfmt = info->src_fmt;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+
+    *rgbmask = ~srcfmt->Amask;
+    *ckey = info->colorkey & *rgbmask;
+    if (srcfmt->Amask && dstfmt->Amask) {
+        /* Same format, copy alpha */
+        *and_mask = 0xFFFFFFFF;
+        *or_mask = 0;
+    } else if (dstfmt->Amask) {
+        /* RGB->RGBA, SET_ALPHA */
+        *and_mask = 0xFFFFFFFF;
+        *or_mask = ((Uint32)info->a) << dstfmt->Ashift;
+    } else {
+        /* RGBA->RGB, NO_ALPHA */
+        *and_mask = srcfmt->Rmask | srcfmt->Gmask | srcfmt->Bmask;
+        *or_mask = 0;
+    }
+}
+#endif /* SDL_SSE2_INTRINSICS || SDL_NEON_INTRINSICS */
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") Blit4to4KeySSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src32 = (Uint32 *)info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst32 = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip;
+    Uint32 rgbmask, ckey, and_mask, or_mask;
+    __m128i vrgbmask, vckey, vand, vor;
+
+    Get4to4KeyMasks(info, &rgbmask, &ckey, &and_mask, &or_mask);
+    vrgbmask = _mm_set1_epi32((int)rgbmask);
+    vckey = _mm_set1_epi32((int)ckey);
+    vand = _mm_set1_epi32((int)and_mask);
+    vor = _mm_set1_epi32((int)or_mask);
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *)src32);
+            __m128i key = _mm_cmpeq_epi32(_mm_and_si128(s, vrgbmask), vckey);
+            int keyed = _mm_movemask_epi8(key);
+            /* Fully transparent runs are skipped and fully opaque runs
+               don't need to read the destination at all */
+            if (keyed != 0xFFFF) {
+                __m128i p = _mm_or_si128(_mm_and_si128(s, vand), vor);
+                if (keyed) {
+                    __m128i d = _mm_loadu_si128((const __m128i *)dst32);
+                    p = _mm_or_si128(_mm_and_si128(key, d), _mm_andnot_si128(key, p));
+                }
+                _mm_storeu_si128((__m128i *)dst32, p);
+            }
+            src32 += 4;
+            dst32 += 4;
+            n -= 4;
+        }
+        while (n--) {
+            if ((*src32 & rgbmask) != ckey) {
+                *dst32 = (*src32 & and_mask) | or_mask;
+            }
+            ++src32;
+            ++dst32;
+        }
+        src32 = (Uint32 *)((Uint8 *)src32 + srcskip);
+        dst32 = (Uint32 *)((Uint8 *)dst32 + dstskip);
+    }
+}
+
+static void SDL_TARGETING("sse2") Blit2to2KeySSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip;
+    Uint16 rgbmask = (Uint16)~info->src_fmt->Amask;
+    Uint16 ckey = (Uint16)info->colorkey & rgbmask;
+    __m128i vrgbmask = _mm_set1_epi16((short)rgbmask);
+    __m128i vckey = _mm_set1_epi16((short)ckey);
+
+    srcskip /= 2;
+    dstskip /= 2;
+
+    while (height--) {
+        int n = width;
+        while (n >= 8) {
+            __m128i s = _mm_loadu_si128((const __m128i *)srcp);
+            __m128i key = _mm_cmpeq_epi16(_mm_and_si128(s, vrgbmask), vckey);
+            int keyed = _mm_movemask_epi8(key);
+            if (keyed != 0xFFFF) {
+                if (keyed) {
+                    __m128i d = _mm_loadu_si128((const __m128i *)dstp);
+                    s = _mm_or_si128(_mm_and_si128(key, d), _mm_andnot_si128(key, s));
+                }
+                _mm_storeu_si128((__m128i *)dstp, s);
+            }
+            srcp += 8;
+            dstp += 8;
+            n -= 8;
+        }
+        while (n--) {
+            if ((*srcp & rgbmask) != ckey) {
+                *dstp = *srcp;
+            }
+            dstp++;
+            srcp++;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static void Blit4to4KeyNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src32 = (Uint32 *)info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst32 = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip;
+    Uint32 rgbmask, ckey, and_mask, or_mask;
+    uint32x4_t vrgbmask, vckey, vand, vor;
+
+    Get4to4KeyMasks(info, &rgbmask, &ckey, &and_mask, &or_mask);
+    vrgbmask = vdupq_n_u32(rgbmask);
+    vckey = vdupq_n_u32(ckey);
+    vand = vdupq_n_u32(and_mask);
+    vor = vdupq_n_u32(or_mask);
+
+    while (height--) {
+        int n = width;
+        while (n >= 4) {
+            uint32x4_t s = vld1q_u32(src32);
+            uint32x4_t key = vceqq_u32(vandq_u32(s, vrgbmask), vckey);
+            uint32x4_t p = vorrq_u32(vandq_u32(s, vand), vor);
+            vst1q_u32(dst32, vbslq_u32(key, vld1q_u32(dst32), p));
+            src32 += 4;
+            dst32 += 4;
+            n -= 4;
+        }
+        while (n--) {
+            if ((*src32 & rgbmask) != ckey) {
+                *dst32 = (*src32 & and_mask) | or_mask;
+            }
+            ++src32;
+            ++dst32;
+        }
+        src32 = (Uint32 *)((Uint8 *)src32 + srcskip);
+        dst32 = (Uint32 *)((Uint8 *)dst32 + dstskip);
+    }
+}
+
+static void Blit2to2KeyNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip;
+    Uint16 rgbmask = (Uint16)~info->src_fmt->Amask;
+    Uint16 ckey = (Uint16)info->colorkey & rgbmask;
+    uint16x8_t vrgbmask = vdupq_n_u16(rgbmask);
+    uint16x8_t vckey = vdupq_n_u16(ckey);
+
+    srcskip /= 2;
+    dstskip /= 2;
+
+    while (height--) {
+        int n = width;
+        while (n >= 8) {
+            uint16x8_t s = vld1q_u16(srcp);
+            uint16x8_t key = vceqq_u16(vandq_u16(s, vrgbmask), vckey);
+            vst1q_u16(dstp, vbslq_u16(key, vld1q_u16(dstp), s));
+            srcp += 8;
+            dstp += 8;
+            n -= 8;
+        }
+        while (n--) {
+            if ((*srcp & rgbmask) != ckey) {
+                *dstp = *srcp;
+            }
+            dstp++;
+            srcp++;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif /* SDL_NEON_INTRINSICS */
+
 static void BlitNtoNKey(SDL_BlitInfo *info)
 {
     int width = info->dst_w;
@@ -3425,10 +3650,30 @@ SDL_BlitFunc SDL_CalculateBlitN(SDL_Surface *surface)
            If a particular case turns out to be useful we'll add it. */
 
         if (srcfmt->BytesPerPixel == 2 && surface->map->identity != 0) {
+#ifdef SDL_SSE2_INTRINSICS
+            if (SDL_HasSSE2()) {
+                return Blit2to2KeySSE2;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                return Blit2to2KeyNEON;
+            }
+#endif
             return Blit2to2Key;
         } else if (dstfmt->BytesPerPixel == 1) {
             return BlitNto1Key;
         } else {
+#ifdef SDL_SSE2_INTRINSICS
+            if (SDL_HasSSE2() && Can4to4KeySIMD(srcfmt, dstfmt)) {
+                return Blit4to4KeySSE2;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON() && Can4to4KeySIMD(srcfmt, dstfmt)) {
+                return Blit4to4KeyNEON;
+            }
+#endif
 #ifdef SDL_ALTIVEC_BLITTERS
             if ((srcfmt->BytesPerPixel == 4) && (dstfmt->BytesPerPixel == 4) && SDL_HasAltiVec()) {
                 return Blit32to32KeyAltivec;
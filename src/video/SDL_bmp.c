@@ -812,20 +812,33 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
             goto done;
         }
 
-        /* Write the bitmap image upside down */
+        /* Write the bitmap image upside down, a batch of rows at a time */
         bits = (Uint8 *)intermediate_surface->pixels + (intermediate_surface->h * intermediate_surface->pitch);
         pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
-        while (bits > (Uint8 *)intermediate_surface->pixels) {
-            bits -= intermediate_surface->pitch;
-            if (SDL_RWwrite(dst, bits, bw) != bw) {
-                goto done;
-            }
-            if (pad) {
-                const Uint8 padbyte = 0;
-                for (i = 0; i < pad; ++i) {
-                    if (!SDL_WriteU8(dst, padbyte)) {
+        {
+            Uint8 padbytes[4] = { 0, 0, 0, 0 };
+            SDL_RWvec rows[2 * 64];
+            size_t rowbytes = 0;
+            int count = 0;
+
+            while (bits > (Uint8 *)intermediate_surface->pixels) {
+                bits -= intermediate_surface->pitch;
+                rows[count].data = bits;
+                rows[count].size = bw;
+                rowbytes += bw;
+                ++count;
+                if (pad) {
+                    rows[count].data = padbytes;
+                    rows[count].size = pad;
+                    rowbytes += pad;
+                    ++count;
+                }
+                if (count > (int)SDL_arraysize(rows) - 2 || bits == (Uint8 *)intermediate_surface->pixels) {
+                    if (SDL_RWwritev(dst, rows, count) != rowbytes) {
                         goto done;
                     }
+                    rowbytes = 0;
+                    count = 0;
                 }
             }
         }
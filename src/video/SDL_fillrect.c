@@ -21,6 +21,28 @@
 #include "SDL_internal.h"
 
 #include "SDL_blit.h"
+#include "../SDL_hints_c.h"
+
+/* Fills larger than this are written with non-temporal stores, since they
+ * would push everything else out of the last level cache anyway.
+ */
+#define SDL_FILLRECT_STREAM_THRESHOLD (4 * 1024 * 1024)
+
+#define FILLRECT_STREAM(bpp, w, h) \
+    ((size_t)(w) * (bpp) * (h) >= SDL_FILLRECT_STREAM_THRESHOLD)
+
+/* Set up the 24-bit pattern, three bytes in memory order, repeated */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define FILLRECT3_PATTERN(pattern, size, color) \
+    for (i = 0; i < (size); ++i) { \
+        pattern[i] = (Uint8)((color) >> (8 * (i % 3))); \
+    }
+#else
+#define FILLRECT3_PATTERN(pattern, size, color) \
+    for (i = 0; i < (size); ++i) { \
+        pattern[i] = (Uint8)((color) >> (8 * (2 - (i % 3)))); \
+    }
+#endif
 
 #ifdef SDL_SSE_INTRINSICS
 /* *INDENT-OFF* */ /* clang-format off */
@@ -44,21 +66,35 @@
 #endif
 
 #define SSE_WORK \
-    for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
-        p += 64; \
+    if (stream) { \
+        for (i = n / 64; i--;) { \
+            _mm_stream_ps((float *)(p+0), c128); \
+            _mm_stream_ps((float *)(p+16), c128); \
+            _mm_stream_ps((float *)(p+32), c128); \
+            _mm_stream_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
+    } else { \
+        for (i = n / 64; i--;) { \
+            _mm_store_ps((float *)(p+0), c128); \
+            _mm_store_ps((float *)(p+16), c128); \
+            _mm_store_ps((float *)(p+32), c128); \
+            _mm_store_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
     }
 
-#define SSE_END
+#define SSE_END \
+    if (stream) { \
+        _mm_sfence(); \
+    }
 
 #define DEFINE_SSE_FILLRECT(bpp, type) \
 static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
     int i, n; \
     Uint8 *p = NULL; \
+    const SDL_bool stream = FILLRECT_STREAM(bpp, w, h); \
  \
     SSE_BEGIN; \
  \
@@ -95,6 +131,7 @@ static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, in
 static void SDL_TARGETING("sse") SDL_FillSurfaceRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
     int i, n;
+    const SDL_bool stream = FILLRECT_STREAM(1, w, h);
 
     SSE_BEGIN;
     while (h--) {
@@ -126,6 +163,298 @@ DEFINE_SSE_FILLRECT(4, Uint32)
 /* *INDENT-ON* */ /* clang-format on */
 #endif            /* __SSE__ */
 
+/*
+ * 24-bit fills: the pattern repeats every three vectors, so three registers
+ * are prepared for each of the three possible phases of the first aligned
+ * address in a row, and stored in rotation.
+ */
+#define DEFINE_FILLRECT3_SIMD(suffix, target, vectype, size, loadu, store, stream_store, fence) \
+static void SDL_TARGETING(target) SDL_FillSurfaceRect3##suffix(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    Uint8 pattern[3 * (size) + 2]; \
+    vectype c[3][3]; \
+    const SDL_bool stream = FILLRECT_STREAM(3, w, h); \
+    int i, phase; \
+ \
+    FILLRECT3_PATTERN(pattern, 3 * (size) + 2, color); \
+    for (phase = 0; phase < 3; ++phase) { \
+        c[phase][0] = loadu((const vectype *)(pattern + phase)); \
+        c[phase][1] = loadu((const vectype *)(pattern + phase + (size))); \
+        c[phase][2] = loadu((const vectype *)(pattern + phase + 2 * (size))); \
+    } \
+ \
+    while (h--) { \
+        Uint8 *p = pixels; \
+        int n = w * 3; \
+ \
+        if (n >= 4 * (size)) { \
+            const vectype *v; \
+            int adjust = (int)((size) - ((uintptr_t)p & ((size) - 1))) & ((size) - 1); \
+            SDL_memcpy(p, pattern, adjust); \
+            p += adjust; \
+            n -= adjust; \
+            phase = adjust % 3; \
+            v = c[phase]; \
+            if (stream) { \
+                for (i = n / (3 * (size)); i--;) { \
+                    stream_store((vectype *)(p + 0), v[0]); \
+                    stream_store((vectype *)(p + (size)), v[1]); \
+                    stream_store((vectype *)(p + 2 * (size)), v[2]); \
+                    p += 3 * (size); \
+                } \
+            } else { \
+                for (i = n / (3 * (size)); i--;) { \
+                    store((vectype *)(p + 0), v[0]); \
+                    store((vectype *)(p + (size)), v[1]); \
+                    store((vectype *)(p + 2 * (size)), v[2]); \
+                    p += 3 * (size); \
+                } \
+            } \
+            SDL_memcpy(p, pattern + phase, n % (3 * (size))); \
+        } else { \
+            while (n > 0) { \
+                int len = SDL_min(n, 3 * (size)); \
+                SDL_memcpy(p, pattern, len); \
+                p += len; \
+                n -= len; \
+            } \
+        } \
+        pixels += pitch; \
+    } \
+ \
+    if (stream) { \
+        fence(); \
+    } \
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+DEFINE_FILLRECT3_SIMD(SSE2, "sse2", __m128i, 16, _mm_loadu_si128, _mm_store_si128, _mm_stream_si128, _mm_sfence)
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+/* *INDENT-OFF* */ /* clang-format off */
+
+#define AVX2_WORK \
+    if (stream) { \
+        for (i = n / 128; i--;) { \
+            _mm256_stream_si256((__m256i *)(p+0), c256); \
+            _mm256_stream_si256((__m256i *)(p+32), c256); \
+            _mm256_stream_si256((__m256i *)(p+64), c256); \
+            _mm256_stream_si256((__m256i *)(p+96), c256); \
+            p += 128; \
+        } \
+    } else { \
+        for (i = n / 128; i--;) { \
+            _mm256_store_si256((__m256i *)(p+0), c256); \
+            _mm256_store_si256((__m256i *)(p+32), c256); \
+            _mm256_store_si256((__m256i *)(p+64), c256); \
+            _mm256_store_si256((__m256i *)(p+96), c256); \
+            p += 128; \
+        } \
+    }
+
+#define AVX2_END \
+    if (stream) { \
+        _mm_sfence(); \
+    }
+
+#define DEFINE_AVX2_FILLRECT(bpp, type) \
+static void SDL_TARGETING("avx2") SDL_FillSurfaceRect##bpp##AVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    int i, n; \
+    Uint8 *p = NULL; \
+    const SDL_bool stream = FILLRECT_STREAM(bpp, w, h); \
+    const __m256i c256 = _mm256_set1_epi32((int)color); \
+ \
+    while (h--) { \
+        n = (w) * (bpp); \
+        p = pixels; \
+ \
+        if (n > 127) { \
+            int adjust = 32 - ((uintptr_t)p & 31); \
+            if (adjust < 32) { \
+                n -= adjust; \
+                adjust /= (bpp); \
+                while (adjust--) { \
+                    *((type *)p) = (type)color; \
+                    p += (bpp); \
+                } \
+            } \
+            AVX2_WORK; \
+        } \
+        if (n & 127) { \
+            int remainder = (n & 127); \
+            remainder /= (bpp); \
+            while (remainder--) { \
+                *((type *)p) = (type)color; \
+                p += (bpp); \
+            } \
+        } \
+        pixels += pitch; \
+    } \
+ \
+    AVX2_END; \
+}
+
+static void SDL_TARGETING("avx2") SDL_FillSurfaceRect1AVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    int i, n;
+    const SDL_bool stream = FILLRECT_STREAM(1, w, h);
+    const __m256i c256 = _mm256_set1_epi32((int)color);
+
+    while (h--) {
+        Uint8 *p = pixels;
+        n = w;
+
+        if (n > 127) {
+            int adjust = 32 - ((uintptr_t)p & 31);
+            if (adjust) {
+                n -= adjust;
+                SDL_memset(p, color, adjust);
+                p += adjust;
+            }
+            AVX2_WORK;
+        }
+        if (n & 127) {
+            int remainder = (n & 127);
+            SDL_memset(p, color, remainder);
+        }
+        pixels += pitch;
+    }
+
+    AVX2_END;
+}
+DEFINE_AVX2_FILLRECT(2, Uint16)
+DEFINE_AVX2_FILLRECT(4, Uint32)
+
+static __m256i SDL_TARGETING("avx2") SDL_FillRectLoadAVX2(const __m256i *p)
+{
+    return _mm256_loadu_si256(p);
+}
+
+static void SDL_TARGETING("avx2") SDL_FillRectStoreAVX2(__m256i *p, __m256i v)
+{
+    _mm256_store_si256(p, v);
+}
+
+static void SDL_TARGETING("avx2") SDL_FillRectStreamAVX2(__m256i *p, __m256i v)
+{
+    _mm256_stream_si256(p, v);
+}
+
+DEFINE_FILLRECT3_SIMD(AVX2, "avx2", __m256i, 32, SDL_FillRectLoadAVX2, SDL_FillRectStoreAVX2, SDL_FillRectStreamAVX2, _mm_sfence)
+
+/* *INDENT-ON* */ /* clang-format on */
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+/* NEON has no non-temporal store intrinsics, so these always use plain stores */
+static void SDL_FillSurfaceRect1NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    const uint8x16_t c = vdupq_n_u8((Uint8)color);
+
+    while (h--) {
+        Uint8 *p = pixels;
+        int n = w;
+
+        for (; n >= 64; n -= 64) {
+            vst1q_u8(p + 0, c);
+            vst1q_u8(p + 16, c);
+            vst1q_u8(p + 32, c);
+            vst1q_u8(p + 48, c);
+            p += 64;
+        }
+        for (; n >= 16; n -= 16) {
+            vst1q_u8(p, c);
+            p += 16;
+        }
+        SDL_memset(p, color, n);
+        pixels += pitch;
+    }
+}
+
+static void SDL_FillSurfaceRect2NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    const uint16x8_t c = vdupq_n_u16((Uint16)color);
+
+    while (h--) {
+        Uint16 *p = (Uint16 *)pixels;
+        int n = w;
+
+        for (; n >= 32; n -= 32) {
+            vst1q_u16(p + 0, c);
+            vst1q_u16(p + 8, c);
+            vst1q_u16(p + 16, c);
+            vst1q_u16(p + 24, c);
+            p += 32;
+        }
+        for (; n >= 8; n -= 8) {
+            vst1q_u16(p, c);
+            p += 8;
+        }
+        while (n--) {
+            *p++ = (Uint16)color;
+        }
+        pixels += pitch;
+    }
+}
+
+static void SDL_FillSurfaceRect3NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    uint8x16x3_t c;
+    Uint8 pattern[3];
+    int i;
+
+    /* vst3q_u8() interleaves the three registers, writing 16 whole pixels */
+    FILLRECT3_PATTERN(pattern, 3, color);
+    c.val[0] = vdupq_n_u8(pattern[0]);
+    c.val[1] = vdupq_n_u8(pattern[1]);
+    c.val[2] = vdupq_n_u8(pattern[2]);
+
+    while (h--) {
+        Uint8 *p = pixels;
+        int n = w;
+
+        for (; n >= 16; n -= 16) {
+            vst3q_u8(p, c);
+            p += 48;
+        }
+        while (n--) {
+            *p++ = pattern[0];
+            *p++ = pattern[1];
+            *p++ = pattern[2];
+        }
+        pixels += pitch;
+    }
+}
+
+static void SDL_FillSurfaceRect4NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    const uint32x4_t c = vdupq_n_u32(color);
+
+    while (h--) {
+        Uint32 *p = (Uint32 *)pixels;
+        int n = w;
+
+        for (; n >= 16; n -= 16) {
+            vst1q_u32(p + 0, c);
+            vst1q_u32(p + 4, c);
+            vst1q_u32(p + 8, c);
+            vst1q_u32(p + 12, c);
+            p += 16;
+        }
+        for (; n >= 4; n -= 4) {
+            vst1q_u32(p, c);
+            p += 4;
+        }
+        while (n--) {
+            *p++ = color;
+        }
+        pixels += pitch;
+    }
+}
+#endif /* SDL_NEON_INTRINSICS */
+
 static void SDL_FillSurfaceRect1(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
     int n;
@@ -295,12 +624,125 @@ static void fill_32_simd(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 }
 #endif
 
+static int SDLCALL SDL_CompareRectTop(const void *a, const void *b)
+{
+    return ((const SDL_Rect *)a)->y - ((const SDL_Rect *)b)->y;
+}
+
+static int SDLCALL SDL_CompareInt(const void *a, const void *b)
+{
+    const int x = *(const int *)a;
+    const int y = *(const int *)b;
+    return (x < y) ? -1 : (x > y);
+}
+
+/*
+ * Fill several rectangles, writing each covered pixel exactly once.
+ *
+ * The clipped rectangles are split at every top and bottom edge into
+ * horizontal bands. Within a band the active rectangles are kept sorted by
+ * their left edge, so overlapping and adjacent spans merge into a single
+ * fill.
+ */
+static int SDL_FillSurfaceRectsCoalesced(SDL_Surface *dst, const SDL_Rect *rects, int count, Uint32 color,
+                                         void (*fill_function)(Uint8 *pixels, int pitch, Uint32 color, int w, int h))
+{
+    SDL_Rect *clipped;
+    const SDL_Rect **active;
+    int *edges;
+    int i, j, n, num_edges, num_active, next;
+    SDL_bool isstack;
+
+    clipped = SDL_small_alloc(SDL_Rect, count, &isstack);
+    if (!clipped) {
+        return SDL_OutOfMemory();
+    }
+    active = (const SDL_Rect **)SDL_malloc(count * sizeof(*active));
+    edges = (int *)SDL_malloc(2 * count * sizeof(*edges));
+    if (!active || !edges) {
+        SDL_free(active);
+        SDL_free(edges);
+        SDL_small_free(clipped, isstack);
+        return SDL_OutOfMemory();
+    }
+
+    n = 0;
+    for (i = 0; i < count; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &dst->clip_rect, &clipped[n])) {
+            edges[2 * n] = clipped[n].y;
+            edges[2 * n + 1] = clipped[n].y + clipped[n].h;
+            ++n;
+        }
+    }
+    SDL_qsort(clipped, n, sizeof(*clipped), SDL_CompareRectTop);
+    SDL_qsort(edges, 2 * n, sizeof(*edges), SDL_CompareInt);
+
+    num_edges = 0;
+    for (i = 0; i < 2 * n; ++i) {
+        if (num_edges == 0 || edges[num_edges - 1] != edges[i]) {
+            edges[num_edges++] = edges[i];
+        }
+    }
+
+    num_active = 0;
+    next = 0;
+    for (i = 0; i + 1 < num_edges; ++i) {
+        const int y = edges[i];
+        const int band_h = edges[i + 1] - y;
+        int x0, x1;
+
+        /* Drop the rectangles that ended above this band */
+        for (j = 0; j < num_active;) {
+            if (active[j]->y + active[j]->h <= y) {
+                SDL_memmove(&active[j], &active[j + 1], (num_active - j - 1) * sizeof(*active));
+                --num_active;
+            } else {
+                ++j;
+            }
+        }
+
+        /* Add the rectangles starting at this band, sorted by left edge */
+        while (next < n && clipped[next].y <= y) {
+            const SDL_Rect *rect = &clipped[next++];
+            for (j = num_active; j > 0 && active[j - 1]->x > rect->x; --j) {
+                active[j] = active[j - 1];
+            }
+            active[j] = rect;
+            ++num_active;
+        }
+
+        if (num_active == 0) {
+            continue;
+        }
+
+        x0 = active[0]->x;
+        x1 = x0 + active[0]->w;
+        for (j = 1; j <= num_active; ++j) {
+            if (j < num_active && active[j]->x <= x1) {
+                x1 = SDL_max(x1, active[j]->x + active[j]->w);
+                continue;
+            }
+            fill_function((Uint8 *)dst->pixels + y * dst->pitch + x0 * dst->format->BytesPerPixel,
+                          dst->pitch, color, x1 - x0, band_h);
+            if (j < num_active) {
+                x0 = active[j]->x;
+                x1 = x0 + active[j]->w;
+            }
+        }
+    }
+
+    SDL_free(active);
+    SDL_free(edges);
+    SDL_small_free(clipped, isstack);
+    return 0;
+}
+
 int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
                   Uint32 color)
 {
+    static SDL_HintCache coalescing = SDL_HINT_CACHE_INIT(SDL_HINT_SURFACE_FILL_COALESCING, SDL_GetStringBoolean, SDL_FALSE);
     SDL_Rect clipped;
     Uint8 *pixels;
-    const SDL_Rect *rect;
     void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
     int i;
 
@@ -354,6 +796,24 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         }
     }
 #endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON() && !fill_function) {
+        switch (dst->format->BytesPerPixel) {
+        case 1:
+            fill_function = SDL_FillSurfaceRect1NEON;
+            break;
+        case 2:
+            fill_function = SDL_FillSurfaceRect2NEON;
+            break;
+        case 3:
+            fill_function = SDL_FillSurfaceRect3NEON;
+            break;
+        case 4:
+            fill_function = SDL_FillSurfaceRect4NEON;
+            break;
+        }
+    }
+#endif
 #ifdef SDL_ARM_SIMD_BLITTERS
     if (SDL_HasARMSIMD() && dst->format->BytesPerPixel != 3 && !fill_function) {
         switch (dst->format->BytesPerPixel) {
@@ -376,6 +836,12 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         {
             color |= (color << 8);
             color |= (color << 16);
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                fill_function = SDL_FillSurfaceRect1AVX2;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect1SSE;
@@ -389,6 +855,12 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         case 2:
         {
             color |= (color << 16);
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                fill_function = SDL_FillSurfaceRect2AVX2;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect2SSE;
@@ -400,14 +872,31 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         }
 
         case 3:
-            /* 24-bit RGB is a slow path, at least for now. */
-            {
-                fill_function = SDL_FillSurfaceRect3;
+        {
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                fill_function = SDL_FillSurfaceRect3AVX2;
+                break;
+            }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+            if (SDL_HasSSE2()) {
+                fill_function = SDL_FillSurfaceRect3SSE2;
                 break;
             }
+#endif
+            fill_function = SDL_FillSurfaceRect3;
+            break;
+        }
 
         case 4:
         {
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                fill_function = SDL_FillSurfaceRect4AVX2;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect4SSE;
@@ -423,18 +912,19 @@ int SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count,
         }
     }
 
+    if (count > 1 && SDL_GetCachedHint(&coalescing)) {
+        return SDL_FillSurfaceRectsCoalesced(dst, rects, count, color, fill_function);
+    }
+
     for (i = 0; i < count; ++i) {
-        rect = &rects[i];
         /* Perform clipping */
-        if (!SDL_GetRectIntersection(rect, &dst->clip_rect, &clipped)) {
+        if (!SDL_GetRectIntersection(&rects[i], &dst->clip_rect, &clipped)) {
             continue;
         }
-        rect = &clipped;
-
-        pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
-                 rect->x * dst->format->BytesPerPixel;
+        pixels = (Uint8 *)dst->pixels + clipped.y * dst->pitch +
+                 clipped.x * dst->format->BytesPerPixel;
 
-        fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        fill_function(pixels, dst->pitch, color, clipped.w, clipped.h);
     }
 
     /* We're done! */
@@ -550,7 +550,7 @@ SDL_PixelFormat *SDL_CreatePixelFormat(Uint32 pixel_format)
 {
     SDL_PixelFormat *format;
 
-    SDL_AtomicLock(&formats_lock);
+    SDL_AtomicLockNamed(&formats_lock, SDL_LOCK_NAME);
 
     /* Look it up in our list of previously allocated formats */
     for (format = formats; format; format = format->next) {
@@ -664,7 +664,7 @@ void SDL_DestroyPixelFormat(SDL_PixelFormat *format)
         return;
     }
 
-    SDL_AtomicLock(&formats_lock);
+    SDL_AtomicLockNamed(&formats_lock, SDL_LOCK_NAME);
 
     if (--format->refcount > 0) {
         SDL_AtomicUnlock(&formats_lock);
@@ -20,6 +20,7 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_video_c.h"
 #include "SDL_blit.h"
 
 static int SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
@@ -94,7 +95,7 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
-        if (SDL_LockSurface(dst) < 0) {
+        if (SDL_LockSurfaceRect(dst, dstrect) < 0) {
             return SDL_SetError("Unable to lock destination surface");
         }
         dst_locked = 1;
@@ -102,7 +103,7 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
     /* Lock the source if it's in hardware */
     src_locked = 0;
     if (SDL_MUSTLOCK(src)) {
-        if (SDL_LockSurface(src) < 0) {
+        if (SDL_LockSurfaceReadOnly(src) < 0) {
             if (dst_locked) {
                 SDL_UnlockSurface(dst);
             }
@@ -771,7 +771,10 @@ int SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect,
     /* Switch back to a fast blit if we were previously stretching */
     if (src->map->info.flags & SDL_COPY_NEAREST) {
         src->map->info.flags &= ~SDL_COPY_NEAREST;
-        SDL_InvalidateMap(src->map);
+        /* The RLE colorkey blitter handles both cases, don't re-encode */
+        if (!(src->map->info.flags & SDL_COPY_RLE_COLORKEY)) {
+            SDL_InvalidateMap(src->map);
+        }
     }
 
     if (w > 0 && h > 0) {
@@ -972,7 +975,10 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
 
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
         src->map->info.flags |= SDL_COPY_NEAREST;
-        SDL_InvalidateMap(src->map);
+        /* The RLE colorkey blitter handles both cases, don't re-encode */
+        if (!(src->map->info.flags & SDL_COPY_RLE_COLORKEY)) {
+            SDL_InvalidateMap(src->map);
+        }
     }
 
     if (scaleMode == SDL_SCALEMODE_NEAREST) {
@@ -1067,15 +1073,26 @@ int SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect,
  */
 int SDL_LockSurface(SDL_Surface *surface)
 {
-    if (!surface->locked) {
+    return SDL_LockSurfaceRect(surface, NULL);
+}
+
+/* Lock a surface where only lines [y0, y1) are going to be modified */
+static int SDL_LockSurfaceLines(SDL_Surface *surface, int y0, int y1)
+{
 #if SDL_HAVE_RLE
-        /* Perform the lock */
-        if (surface->flags & SDL_RLEACCEL) {
+    /* Perform the lock */
+    if (surface->flags & SDL_RLEACCEL) {
+        if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
+            /* Keep the encoded data, only the modified lines are re-encoded */
+            if (SDL_LockRLESurface(surface, y0, y1) < 0) {
+                return -1;
+            }
+        } else if (!surface->locked) {
             SDL_UnRLESurface(surface, 1);
             surface->flags |= SDL_RLEACCEL; /* save accel'd state */
         }
-#endif
     }
+#endif
 
     /* Increment the surface lock count, for recursive locks */
     ++surface->locked;
@@ -1084,6 +1101,22 @@ int SDL_LockSurface(SDL_Surface *surface)
     return 0;
 }
 
+int SDL_LockSurfaceRect(SDL_Surface *surface, const SDL_Rect *rect)
+{
+    if (!rect) {
+        return SDL_LockSurfaceLines(surface, 0, surface->h);
+    }
+    if (SDL_RectEmpty(rect)) {
+        return SDL_LockSurfaceLines(surface, 0, 0);
+    }
+    return SDL_LockSurfaceLines(surface, SDL_max(rect->y, 0), SDL_min(rect->y + rect->h, surface->h));
+}
+
+int SDL_LockSurfaceReadOnly(SDL_Surface *surface)
+{
+    return SDL_LockSurfaceLines(surface, 0, 0);
+}
+
 /*
  * Unlock a previously locked surface
  */
@@ -1097,8 +1130,12 @@ void SDL_UnlockSurface(SDL_Surface *surface)
 #if SDL_HAVE_RLE
     /* Update RLE encoded surface with new data */
     if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
-        surface->flags &= ~SDL_RLEACCEL; /* stop lying */
-        SDL_RLESurface(surface);
+        if (surface->map->info.flags & SDL_COPY_RLE_COLORKEY) {
+            SDL_UnlockRLESurface(surface);
+        } else {
+            surface->flags &= ~SDL_RLEACCEL; /* stop lying */
+            SDL_RLESurface(surface);
+        }
     }
 #endif
 }
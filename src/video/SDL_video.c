@@ -31,6 +31,7 @@
 #include "SDL_video_c.h"
 #include "../events/SDL_events_c.h"
 #include "../SDL_hints_c.h"
+#include "../SDL_properties_c.h"
 #include "../timer/SDL_timer_c.h"
 #include "SDL_video_capture_c.h"
 
@@ -197,6 +198,8 @@ static void SDL_SyncIfRequired(SDL_Window *window)
 
 #define SDL_PROPERTY_WINDOW_TEXTUREDATA "SDL.internal.window.texturedata"
 
+static SDL_PropertyKey SDL_window_texturedata_key = SDL_PROPERTY_KEY_INIT(SDL_PROPERTY_WINDOW_TEXTUREDATA);
+
 typedef struct
 {
     SDL_Renderer *renderer;
@@ -239,7 +242,7 @@ static int SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, U
 {
     SDL_RendererInfo info;
     SDL_PropertiesID props = SDL_GetWindowProperties(window);
-    SDL_WindowTextureData *data = (SDL_WindowTextureData *)SDL_GetProperty(props, SDL_PROPERTY_WINDOW_TEXTUREDATA, NULL);
+    SDL_WindowTextureData *data = (SDL_WindowTextureData *)SDL_GetPropertyByKey(props, &SDL_window_texturedata_key, NULL);
     const SDL_bool transparent = (window->flags & SDL_WINDOW_TRANSPARENT) ? SDL_TRUE : SDL_FALSE;
     int i;
     int w, h;
@@ -362,7 +365,7 @@ static int SDL_UpdateWindowTexture(SDL_VideoDevice *unused, SDL_Window *window,
 
     SDL_GetWindowSizeInPixels(window, &w, &h);
 
-    data = SDL_GetProperty(SDL_GetWindowProperties(window), SDL_PROPERTY_WINDOW_TEXTUREDATA, NULL);
+    data = SDL_GetPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_texturedata_key, NULL);
     if (!data || !data->texture) {
         return SDL_SetError("No window texture data");
     }
@@ -394,7 +397,7 @@ int SDL_SetWindowTextureVSync(SDL_Window *window, int vsync)
 {
     SDL_WindowTextureData *data;
 
-    data = SDL_GetProperty(SDL_GetWindowProperties(window), SDL_PROPERTY_WINDOW_TEXTUREDATA, NULL);
+    data = SDL_GetPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_texturedata_key, NULL);
     if (!data) {
         return -1;
     }
@@ -57,6 +57,32 @@ extern void SDL_VideoQuit(void);
 
 extern int SDL_SetWindowTextureVSync(SDL_Window *window, int vsync);
 
+/**
+ * Lock a surface to directly access the pixels, where only the pixels inside
+ * `rect` are going to be modified.
+ *
+ * This behaves like SDL_LockSurface(), but RLE encoded surfaces only need to
+ * re-encode the lines covered by `rect` when they are unlocked.
+ *
+ * \param surface the surface to lock
+ * \param rect the area that will be modified, NULL for the whole surface
+ * \returns 0 on success or a negative error code on failure.
+ *
+ * \sa SDL_LockSurfaceReadOnly
+ */
+extern int SDL_LockSurfaceRect(SDL_Surface *surface, const SDL_Rect *rect);
+
+/**
+ * Lock a surface to directly read the pixels, without modifying them.
+ *
+ * This behaves like SDL_LockSurface(), but RLE encoded surfaces don't need to
+ * be re-encoded when they are unlocked.
+ *
+ * \param surface the surface to lock
+ * \returns 0 on success or a negative error code on failure.
+ */
+extern int SDL_LockSurfaceReadOnly(SDL_Surface *surface);
+
 extern int SDL_ReadSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a);
 
 #endif /* SDL_video_c_h_ */
@@ -529,13 +529,13 @@ SDL_OpenVideoCapture(SDL_VideoCaptureDeviceID instance_id)
     SDL_AtomicSet(&device->shutdown, 0);
     SDL_AtomicSet(&device->enabled, 0);
 
-    device->device_lock = SDL_CreateMutex();
+    device->device_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (device->device_lock == NULL) {
         SDL_SetError("Couldn't create acquiring_lock");
         goto error;
     }
 
-    device->acquiring_lock = SDL_CreateMutex();
+    device->acquiring_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
     if (device->acquiring_lock == NULL) {
         SDL_SetError("Couldn't create acquiring_lock");
         goto error;
@@ -88,7 +88,7 @@ static CVReturn DisplayLinkCallback(CVDisplayLinkRef displayLink, const CVTimeSt
         SDL_AtomicSet(&self->swapIntervalSetting, 0);
         SDL_AtomicSet(&self->swapIntervalsPassed, 0);
         self->swapIntervalCond = SDL_CreateCondition();
-        self->swapIntervalMutex = SDL_CreateMutex();
+        self->swapIntervalMutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         if (!self->swapIntervalCond || !self->swapIntervalMutex) {
             return nil;
         }
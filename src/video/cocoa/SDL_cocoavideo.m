@@ -72,7 +72,7 @@ static SDL_VideoDevice *Cocoa_CreateDevice(void)
             return NULL;
         }
         device->driverdata = (SDL_VideoData *)CFBridgingRetain(data);
-        device->wakeup_lock = SDL_CreateMutex();
+        device->wakeup_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         device->system_theme = Cocoa_GetSystemTheme();
 
         /* Set the function pointers */
@@ -197,7 +197,7 @@ int Cocoa_VideoInit(SDL_VideoDevice *_this)
         data.allow_spaces = SDL_GetHintBoolean(SDL_HINT_VIDEO_MAC_FULLSCREEN_SPACES, SDL_TRUE);
         data.trackpad_is_touch_only = SDL_GetHintBoolean(SDL_HINT_TRACKPAD_IS_TOUCH_ONLY, SDL_FALSE);
 
-        data.swaplock = SDL_CreateMutex();
+        data.swaplock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         if (!data.swaplock) {
             return -1;
         }
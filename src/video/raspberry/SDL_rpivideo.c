@@ -292,7 +292,7 @@ int RPI_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_PropertiesI
     wdata->double_buffer = SDL_FALSE;
     if (SDL_GetHintBoolean(SDL_HINT_VIDEO_DOUBLE_BUFFER, SDL_FALSE)) {
         wdata->vsync_cond = SDL_CreateCondition();
-        wdata->vsync_cond_mutex = SDL_CreateMutex();
+        wdata->vsync_cond_mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         wdata->double_buffer = SDL_TRUE;
         vc_dispmanx_vsync_callback(displaydata->dispman_display, RPI_vsync_callback, (void *)wdata);
     }
@@ -166,7 +166,7 @@ static SDL_VideoDevice *Wayland_CreateDevice(void)
     }
 
     device->driverdata = data;
-    device->wakeup_lock = SDL_CreateMutex();
+    device->wakeup_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
 
     /* Set the function pointers */
     device->VideoInit = Wayland_VideoInit;
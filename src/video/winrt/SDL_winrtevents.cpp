@@ -103,7 +103,7 @@ void WINRT_CycleXAMLThread(void)
     {
         _cond = SDL_CreateCondition();
 
-        _mutex = SDL_CreateMutex();
+        _mutex = SDL_CreateMutexNamed(SDL_LOCK_NAME);
         _threadState = ThreadState_Running;
         _XAMLThread = SDL_CreateThreadInternal(WINRT_XAMLThreadMain, "SDL/XAML App Thread", 0, nullptr);
 
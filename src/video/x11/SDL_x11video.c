@@ -148,7 +148,7 @@ static SDL_VideoDevice *X11_CreateDevice(void)
         return NULL;
     }
 
-    device->wakeup_lock = SDL_CreateMutex();
+    device->wakeup_lock = SDL_CreateMutexNamed(SDL_LOCK_NAME);
 
 #ifdef X11_DEBUG
     X11_XSynchronize(data->display, True);
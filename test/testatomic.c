@@ -695,10 +695,224 @@ static void RunFIFOTest(SDL_bool lock_free)
 /* End FIFO test */
 /**************************************************************************/
 
+/**************************************************************************/
+/* Job pool test */
+
+#define NUM_JOB_ITEMS    100000
+#define NUM_PARENT_JOBS  64
+#define NUM_CHILD_JOBS   64
+
+static int jobItems[NUM_JOB_ITEMS];
+static SDL_AtomicInt jobsRun;
+static SDL_AtomicInt jobsProfiled;
+static SDL_JobPool *jobPool;
+
+static void SDLCALL JobProfile(void *userdata, SDL_JobFunction func, void *jobdata, int worker, Uint64 start, Uint64 end)
+{
+    SDL_assert(end >= start);
+    SDL_AtomicIncRef(&jobsProfiled);
+}
+
+static void SDLCALL ChildJob(void *userdata)
+{
+    SDL_AtomicIncRef(&jobsRun);
+}
+
+static void SDLCALL ParentJob(void *userdata)
+{
+    SDL_AtomicInt children;
+    int i;
+
+    /* Jobs can submit other jobs and wait for them */
+    SDL_AtomicSet(&children, 0);
+    for (i = 0; i < NUM_CHILD_JOBS; ++i) {
+        SDL_SubmitJob(jobPool, ChildJob, NULL, &children);
+    }
+    SDL_WaitJobs(jobPool, &children);
+    SDL_assert(SDL_AtomicGet(&children) == 0);
+
+    SDL_AtomicIncRef(&jobsRun);
+}
+
+static void SDLCALL DoubleRange(void *userdata, int start, int end)
+{
+    int i;
+
+    for (i = start; i < end; ++i) {
+        jobItems[i] = i * 2;
+    }
+}
+
+static void RunJobPoolTest(SDL_JobPool *pool)
+{
+    SDL_AtomicInt parents;
+    Uint64 start;
+    int i, errors = 0;
+
+    jobPool = pool;
+    SDL_AtomicSet(&jobsRun, 0);
+    SDL_AtomicSet(&jobsProfiled, 0);
+    SDL_AtomicSet(&parents, 0);
+
+    SDL_SetJobPoolProfileCallback(pool, JobProfile, NULL);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < NUM_PARENT_JOBS; ++i) {
+        SDL_SubmitJob(pool, ParentJob, NULL, &parents);
+    }
+    SDL_WaitJobs(pool, &parents);
+    SDL_Log("Ran %d nested jobs in %" SDL_PRIu64 " us\n", SDL_AtomicGet(&jobsRun), SDL_NS_TO_US(SDL_GetTicksNS() - start));
+    SDL_assert(SDL_AtomicGet(&jobsRun) == NUM_PARENT_JOBS * (NUM_CHILD_JOBS + 1));
+    SDL_assert(SDL_AtomicGet(&jobsProfiled) == SDL_AtomicGet(&jobsRun));
+
+    SDL_SetJobPoolProfileCallback(pool, NULL, NULL);
+
+    SDL_memset(jobItems, 0, sizeof(jobItems));
+    start = SDL_GetTicksNS();
+    SDL_ParallelFor(pool, NUM_JOB_ITEMS, 0, DoubleRange, NULL);
+    SDL_Log("Ran parallel loop over %d items in %" SDL_PRIu64 " us\n", NUM_JOB_ITEMS, SDL_NS_TO_US(SDL_GetTicksNS() - start));
+    for (i = 0; i < NUM_JOB_ITEMS; ++i) {
+        if (jobItems[i] != i * 2) {
+            ++errors;
+        }
+    }
+    SDL_assert(errors == 0);
+}
+
+static void RunJobPoolTests(void)
+{
+    SDL_JobPool *pool;
+
+    SDL_Log("\njob pool test----------------------------------\n\n");
+
+    pool = SDL_CreateJobPool(4);
+    SDL_assert(pool != NULL);
+    SDL_Log("Testing a pool with 4 worker threads\n");
+    RunJobPoolTest(pool);
+    SDL_DestroyJobPool(pool);
+
+    pool = SDL_CreateJobPool(1);
+    SDL_assert(pool != NULL);
+    SDL_Log("Testing a pool with 1 worker thread\n");
+    RunJobPoolTest(pool);
+    SDL_DestroyJobPool(pool);
+
+    SDL_Log("Testing the shared pool\n");
+    RunJobPoolTest(NULL);
+}
+
+/* End job pool test */
+/**************************************************************************/
+
+/**************************************************************************/
+/* Lock profiling, main() enables SDL_LOCK_PROFILING unless it's already set */
+
+#define NUM_LOCK_ITERATIONS 1000
+
+static int SDLCALL LockStatsThread(void *data)
+{
+    SDL_Mutex *mutex = (SDL_Mutex *)data;
+
+    /* The main thread is holding the mutex, so this has to wait */
+    SDL_LockMutex(mutex);
+    SDL_UnlockMutex(mutex);
+    return 0;
+}
+
+static void RunLockStatsTest(void)
+{
+    SDL_LockStats *stats;
+    SDL_Mutex *mutex;
+    SDL_Thread *thread;
+    SDL_SpinLock spinlocks[2] = { 0, 0 };
+    SDL_bool found = SDL_FALSE;
+    SDL_bool found_spinlock = SDL_FALSE;
+    SDL_bool profiled = SDL_FALSE;
+    int i, count;
+
+    SDL_Log("\nlock profiling test----------------------------\n\n");
+
+    count = SDL_GetLockStats(NULL, 0);
+    SDL_assert(count >= 0);
+    if (count == 0) {
+        SDL_Log("Lock profiling isn't enabled\n");
+        return;
+    }
+
+    /* Contend on a new mutex, with nothing else recorded since the reset */
+    mutex = SDL_CreateMutex();
+    SDL_assert(mutex != NULL);
+    SDL_ResetLockStats();
+    SDL_LockMutex(mutex);
+    thread = SDL_CreateThread(LockStatsThread, "LockStats", mutex);
+    SDL_assert(thread != NULL);
+    SDL_Delay(100);
+    SDL_UnlockMutex(mutex);
+    SDL_WaitThread(thread, NULL);
+    for (i = 0; i < NUM_LOCK_ITERATIONS; ++i) {
+        SDL_LockMutex(mutex);
+        SDL_UnlockMutex(mutex);
+    }
+
+    /* Spinlocks taken at the same place share their statistics */
+    for (i = 0; i < 2 * NUM_LOCK_ITERATIONS; ++i) {
+        SDL_AtomicLock(&spinlocks[i % 2]);
+        SDL_AtomicUnlock(&spinlocks[i % 2]);
+    }
+
+    count = SDL_GetLockStats(NULL, 0);
+    stats = (SDL_LockStats *)SDL_malloc(count * sizeof(*stats));
+    SDL_assert(stats != NULL);
+    count = SDL_GetLockStats(stats, count);
+    for (i = 0; i < count; ++i) {
+        SDL_assert(stats[i].name != NULL);
+        SDL_assert(stats[i].contended <= stats[i].acquisitions);
+        if (stats[i].type == SDL_LOCK_TYPE_MUTEX) {
+            profiled = SDL_TRUE;
+            if (stats[i].acquisitions >= NUM_LOCK_ITERATIONS + 2 && stats[i].contended >= 1 && stats[i].wait_ns > 0) {
+                SDL_Log("Found the test mutex as %s: acquired %" SDL_PRIu64 ", contended %" SDL_PRIu64 "\n",
+                        stats[i].name, stats[i].acquisitions, stats[i].contended);
+                found = SDL_TRUE;
+            }
+        } else if (stats[i].type == SDL_LOCK_TYPE_SPINLOCK && stats[i].acquisitions >= 2 * NUM_LOCK_ITERATIONS) {
+            SDL_Log("Found the test spinlocks as %s: acquired %" SDL_PRIu64 "\n", stats[i].name, stats[i].acquisitions);
+            found_spinlock = SDL_TRUE;
+        }
+    }
+    SDL_free(stats);
+    SDL_DestroyMutex(mutex);
+    SDL_assert(found_spinlock);
+
+    if (profiled) {
+        SDL_assert(found);
+    } else {
+        SDL_Log("Mutexes aren't profiled on this platform\n");
+    }
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_INFO);
+    SDL_LogLockStats();
+
+    SDL_ResetLockStats();
+    count = SDL_GetLockStats(NULL, 0);
+    stats = (SDL_LockStats *)SDL_malloc(count * sizeof(*stats));
+    SDL_assert(stats != NULL);
+    count = SDL_GetLockStats(stats, count);
+    for (i = 0; i < count; ++i) {
+        SDL_assert(stats[i].contended == 0 && stats[i].wait_ns == 0);
+    }
+    SDL_free(stats);
+}
+
+/* End lock profiling test */
+/**************************************************************************/
+
 int main(int argc, char *argv[])
 {
     SDLTest_CommonState *state;
 
+    /* Profile locks, this has to be set before SDL creates any */
+    SDL_setenv(SDL_HINT_LOCK_PROFILING, "1", 0);
+
     /* Initialize test framework */
     state = SDLTest_CommonCreateState(argv, 0);
     if (!state) {
@@ -726,6 +940,9 @@ int main(int argc, char *argv[])
     RunFIFOTest(SDL_FALSE);
 #endif
     RunFIFOTest(SDL_TRUE);
+    RunJobPoolTests();
+    RunLockStatsTest();
+    SDL_Quit();
     SDLTest_CommonDestroyState(state);
     return 0;
 }
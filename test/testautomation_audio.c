@@ -1249,6 +1249,334 @@ cleanup:
 
     return status;
 }
+
+/* Writes a WAVE file with a single fmt and data chunk to dst, returns its size. */
+static size_t audio_buildWaveFile(Uint8 *dst, size_t dstlen, Uint16 formattag, Uint16 channels, Uint16 bitspersample,
+                                  Uint16 blockalign, Uint16 samplesperblock, const Uint8 *data, Uint32 datalen)
+{
+    static const Sint16 ms_adpcm_coeffs[14] = { 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232 };
+    const Uint32 fmtlen = formattag == 0x0002 ? 50 : samplesperblock ? 20 : 16;
+    SDL_RWops *rw = SDL_RWFromMem(dst, (int)dstlen);
+    size_t size;
+    int i;
+
+    if (!rw) {
+        return 0;
+    }
+    SDL_WriteU32LE(rw, 0x46464952); /* RIFF */
+    SDL_WriteU32LE(rw, 4 + 8 + fmtlen + 8 + datalen + (datalen & 1));
+    SDL_WriteU32LE(rw, 0x45564157); /* WAVE */
+    SDL_WriteU32LE(rw, 0x20746D66); /* fmt */
+    SDL_WriteU32LE(rw, fmtlen);
+    SDL_WriteU16LE(rw, formattag);
+    SDL_WriteU16LE(rw, channels);
+    SDL_WriteU32LE(rw, 22050);
+    SDL_WriteU32LE(rw, 22050 * blockalign);
+    SDL_WriteU16LE(rw, blockalign);
+    SDL_WriteU16LE(rw, bitspersample);
+    if (formattag == 0x0002) {
+        SDL_WriteU16LE(rw, 32);
+        SDL_WriteU16LE(rw, samplesperblock);
+        SDL_WriteU16LE(rw, 7);
+        for (i = 0; i < 14; i++) {
+            SDL_WriteS16LE(rw, ms_adpcm_coeffs[i]);
+        }
+    } else if (samplesperblock) {
+        SDL_WriteU16LE(rw, 2);
+        SDL_WriteU16LE(rw, samplesperblock);
+    }
+    SDL_WriteU32LE(rw, 0x61746164); /* data */
+    SDL_WriteU32LE(rw, datalen);
+    SDL_RWwrite(rw, data, datalen);
+    size = (size_t)SDL_RWtell(rw);
+    SDL_RWclose(rw);
+    return size;
+}
+
+/**
+ * Check that decoding a WAVE stream matches loading the whole file.
+ *
+ * \sa SDL_OpenWaveStream
+ * \sa SDL_ReadWaveStream
+ * \sa SDL_SeekWaveStream
+ * \sa SDL_SetAudioStreamWaveSource
+ */
+static int audio_waveStream(void *arg)
+{
+    const struct
+    {
+        const char *name;
+        Uint16 formattag;
+        Uint16 channels;
+        Uint16 bitspersample;
+        Uint16 blockalign;
+        Uint16 samplesperblock;
+        Uint32 datalen;
+    } files[] = {
+        { "16-bit PCM", 0x0001, 2, 16, 4, 0, 40000 },
+        { "24-bit PCM", 0x0001, 1, 24, 3, 0, 15000 },
+        { "mu-law", 0x0007, 1, 8, 1, 0, 9000 },
+        { "IMA ADPCM", 0x0011, 1, 4, 36, 65, 36 * 7 + 20 },
+        { "MS ADPCM", 0x0002, 1, 4, 64, 116, 64 * 7 + 30 },
+    };
+    const size_t filelen = 64 * 1024;
+    Uint8 *file = (Uint8 *)SDL_malloc(filelen);
+    Uint8 *data = (Uint8 *)SDL_malloc(filelen);
+    Uint8 *decoded = (Uint8 *)SDL_malloc(filelen * 2);
+    Uint32 i;
+    int f;
+
+    SDLTest_AssertCheck(file && data && decoded, "Verify buffers were allocated");
+    if (!file || !data || !decoded) {
+        SDL_free(file);
+        SDL_free(data);
+        SDL_free(decoded);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < filelen; i++) {
+        data[i] = (Uint8)(i * 131 + (i >> 3));
+    }
+
+    for (f = 0; f < (int)SDL_arraysize(files); f++) {
+        SDL_AudioSpec spec, wavespec;
+        SDL_AudioStream *stream;
+        SDL_WaveStream *wave;
+        Uint8 *audio_buf = NULL;
+        Uint32 audio_len = 0;
+        int framesize, len, total, ret;
+        size_t size;
+
+        if (files[f].formattag == 0x0002) {
+            for (i = 0; i < files[f].datalen; i += files[f].blockalign) {
+                data[i] %= 7; /* Coefficient index of the block header */
+            }
+        }
+        size = audio_buildWaveFile(file, filelen, files[f].formattag, files[f].channels, files[f].bitspersample,
+                                   files[f].blockalign, files[f].samplesperblock, data, files[f].datalen);
+        SDLTest_AssertCheck(size > 0, "Build %s WAVE file", files[f].name);
+
+        ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(file, (int)size), SDL_TRUE, &spec, &audio_buf, &audio_len);
+        SDLTest_AssertCheck(ret == 0, "Call to SDL_LoadWAV_RW() with %s data, expected 0, got %d", files[f].name, ret);
+        if (ret < 0) {
+            continue;
+        }
+
+        wave = SDL_OpenWaveStream(SDL_RWFromConstMem(file, (int)size), SDL_TRUE, &wavespec);
+        SDLTest_AssertCheck(wave != NULL, "Call to SDL_OpenWaveStream() with %s data", files[f].name);
+        if (!wave) {
+            SDL_free(audio_buf);
+            continue;
+        }
+        SDLTest_AssertCheck(wavespec.format == spec.format && wavespec.channels == spec.channels && wavespec.freq == spec.freq,
+                            "Verify the WAVE stream has the format of the loaded file");
+        framesize = SDL_AUDIO_FRAMESIZE(spec);
+
+        /* Read everything in pieces that don't line up with the decoded blocks. */
+        total = 0;
+        while ((len = SDL_ReadWaveStream(wave, decoded + total, 1000)) > 0) {
+            total += len;
+        }
+        SDLTest_AssertCheck(len == 0, "Verify SDL_ReadWaveStream() reached the end, expected 0, got %d", len);
+        SDLTest_AssertCheck(total == (int)audio_len, "Verify decoded length, expected %d, got %d", (int)audio_len, total);
+        SDLTest_AssertCheck(SDL_memcmp(decoded, audio_buf, SDL_min((Uint32)total, audio_len)) == 0, "Verify decoded data matches SDL_LoadWAV_RW()");
+
+        /* Seek into the middle of a block. */
+        ret = SDL_SeekWaveStream(wave, 100);
+        SDLTest_AssertCheck(ret == 0, "Call to SDL_SeekWaveStream(100), expected 0, got %d", ret);
+        len = SDL_ReadWaveStream(wave, decoded, (int)audio_len);
+        SDLTest_AssertCheck(len == (int)audio_len - 100 * framesize, "Verify length after seeking, expected %d, got %d", (int)audio_len - 100 * framesize, len);
+        SDLTest_AssertCheck(len > 0 && SDL_memcmp(decoded, audio_buf + 100 * framesize, len) == 0, "Verify data after seeking");
+
+        /* Pull everything through an audio stream. */
+        ret = SDL_SeekWaveStream(wave, 0);
+        SDLTest_AssertCheck(ret == 0, "Call to SDL_SeekWaveStream(0), expected 0, got %d", ret);
+        stream = SDL_CreateAudioStream(&spec, &spec);
+        SDLTest_AssertCheck(stream != NULL, "Call to SDL_CreateAudioStream()");
+        if (stream) {
+            ret = SDL_SetAudioStreamWaveSource(stream, wave);
+            SDLTest_AssertCheck(ret == 0, "Call to SDL_SetAudioStreamWaveSource(), expected 0, got %d", ret);
+            total = 0;
+            while ((len = SDL_GetAudioStreamData(stream, decoded + total, 512 * framesize)) > 0) {
+                total += len;
+            }
+            SDLTest_AssertCheck(total == (int)audio_len, "Verify length from the audio stream, expected %d, got %d", (int)audio_len, total);
+            SDLTest_AssertCheck(SDL_memcmp(decoded, audio_buf, SDL_min((Uint32)total, audio_len)) == 0, "Verify data from the audio stream");
+            SDL_DestroyAudioStream(stream);
+        }
+
+        SDL_CloseWaveStream(wave);
+        SDL_free(audio_buf);
+    }
+
+    SDL_free(file);
+    SDL_free(data);
+    SDL_free(decoded);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check A-law and mu-law decoding of every code against the G.711 formulas.
+ *
+ * \sa SDL_LoadWAV_RW
+ */
+static int audio_decodeCompanded(void *arg)
+{
+    /* Not a multiple of the vector size, so the scalar path is checked too. */
+    const Uint32 datalen = 256 * 3 + 5;
+    const size_t filelen = 4096;
+    Uint8 *file = (Uint8 *)SDL_malloc(filelen);
+    Uint8 data[256 * 3 + 5];
+    int law;
+    Uint32 i;
+
+    SDLTest_AssertCheck(file != NULL, "Verify buffer was allocated");
+    if (!file) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < datalen; i++) {
+        data[i] = (Uint8)(i * 7);
+    }
+
+    for (law = 0; law < 2; law++) {
+        const Uint16 formattag = law ? 0x0007 : 0x0006;
+        const char *name = law ? "mu-law" : "A-law";
+        SDL_AudioSpec spec;
+        Uint8 *audio_buf = NULL;
+        Uint32 audio_len = 0;
+        Uint32 mismatches = 0;
+        size_t size;
+        int ret;
+
+        size = audio_buildWaveFile(file, filelen, formattag, 1, 8, 1, 0, data, datalen);
+        ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(file, (int)size), SDL_TRUE, &spec, &audio_buf, &audio_len);
+        SDLTest_AssertCheck(ret == 0, "Call to SDL_LoadWAV_RW() with %s data, expected 0, got %d", name, ret);
+        if (ret < 0) {
+            continue;
+        }
+        SDLTest_AssertCheck(spec.format == SDL_AUDIO_S16 && audio_len == datalen * 2, "Verify %s decodes to 16-bit samples", name);
+
+        for (i = 0; i < datalen && i * 2 < audio_len; i++) {
+            Sint16 expected, actual;
+
+            if (law) {
+                const Uint8 value = (Uint8)~data[i];
+                const int exponent = (value >> 4) & 0x7;
+                const int magnitude = ((((value & 0xf) << 3) + 0x84) << exponent) - 0x84;
+                expected = (Sint16)(value & 0x80 ? -magnitude : magnitude);
+            } else {
+                const Uint8 value = (data[i] & 0x7f) ^ 0x55;
+                const int exponent = value >> 4;
+                int magnitude = ((value & 0xf) | (exponent > 0 ? 0x10 : 0)) << 4 | 0x8;
+                if (exponent > 1) {
+                    magnitude <<= exponent - 1;
+                }
+                expected = (Sint16)(data[i] & 0x80 ? magnitude : -magnitude);
+            }
+            SDL_memcpy(&actual, audio_buf + i * 2, sizeof(actual));
+            if (actual != expected) {
+                if (mismatches++ == 0) {
+                    SDLTest_LogError("%s code 0x%02x decoded to %d, expected %d", name, data[i], actual, expected);
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify all %s samples, %d mismatches", name, (int)mismatches);
+        SDL_free(audio_buf);
+    }
+
+    SDL_free(file);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that decoding big ADPCM files on several threads gives the same data.
+ *
+ * \sa SDL_LoadWAV_RW
+ */
+static int audio_decodeADPCMThreaded(void *arg)
+{
+    const struct
+    {
+        const char *name;
+        Uint16 formattag;
+        Uint16 channels;
+        Uint16 blockalign;
+        Uint16 samplesperblock;
+    } files[] = {
+        { "MS ADPCM", 0x0002, 1, 64, 116 },
+        { "IMA ADPCM", 0x0011, 2, 72, 65 },
+    };
+    const Uint32 numblocks = 1100;
+    const size_t filelen = 128 * 1024;
+    Uint8 *file = (Uint8 *)SDL_malloc(filelen);
+    Uint8 *data = (Uint8 *)SDL_malloc(filelen);
+    int f;
+
+    SDLTest_AssertCheck(file && data, "Verify buffers were allocated");
+    if (!file || !data) {
+        SDL_free(file);
+        SDL_free(data);
+        return TEST_ABORTED;
+    }
+
+    for (f = 0; f < (int)SDL_arraysize(files); f++) {
+        /* A truncated block at the end goes through the single threaded path. */
+        const Uint32 datalen = files[f].blockalign * numblocks + files[f].blockalign / 2;
+        SDL_AudioSpec spec;
+        Uint8 *single_buf = NULL, *threaded_buf = NULL;
+        Uint32 single_len = 0, threaded_len = 0;
+        Uint32 i;
+        size_t size;
+        int ret;
+
+        for (i = 0; i < datalen; i++) {
+            data[i] = (Uint8)(i * 131 + (i >> 5));
+            if (files[f].formattag == 0x0002 && i % files[f].blockalign == 0) {
+                data[i] %= 7; /* Coefficient index of the block header */
+            }
+        }
+        size = audio_buildWaveFile(file, filelen, files[f].formattag, files[f].channels, 4,
+                                   files[f].blockalign, files[f].samplesperblock, data, datalen);
+
+        SDL_SetHint(SDL_HINT_WAVE_DECODE_THREADS, "1");
+        ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(file, (int)size), SDL_TRUE, &spec, &single_buf, &single_len);
+        SDLTest_AssertCheck(ret == 0, "Call to SDL_LoadWAV_RW() with %s data on one thread, expected 0, got %d", files[f].name, ret);
+
+        SDL_SetHint(SDL_HINT_WAVE_DECODE_THREADS, "4");
+        ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(file, (int)size), SDL_TRUE, &spec, &threaded_buf, &threaded_len);
+        SDLTest_AssertCheck(ret == 0, "Call to SDL_LoadWAV_RW() with %s data on four threads, expected 0, got %d", files[f].name, ret);
+
+        SDLTest_AssertCheck(single_len == (Uint32)files[f].samplesperblock * numblocks * files[f].channels * 2,
+                            "Verify decoded length, expected %d, got %d", (int)files[f].samplesperblock * (int)numblocks * files[f].channels * 2, (int)single_len);
+        SDLTest_AssertCheck(single_len == threaded_len, "Verify threaded decoded length, expected %d, got %d", (int)single_len, (int)threaded_len);
+        SDLTest_AssertCheck(single_buf && threaded_buf && SDL_memcmp(single_buf, threaded_buf, SDL_min(single_len, threaded_len)) == 0,
+                            "Verify threaded decoding gives the same %s data", files[f].name);
+        SDL_free(single_buf);
+        SDL_free(threaded_buf);
+
+        if (files[f].formattag == 0x0002) {
+            /* A bad block in the middle fails with the decoder's error, wherever it ran. */
+            Uint8 *bad_buf = NULL;
+            Uint32 bad_len = 0;
+            const char *error;
+
+            data[(numblocks / 2) * files[f].blockalign] = 0xff;
+            size = audio_buildWaveFile(file, filelen, files[f].formattag, files[f].channels, 4,
+                                       files[f].blockalign, files[f].samplesperblock, data, datalen);
+            SDL_ClearError();
+            ret = SDL_LoadWAV_RW(SDL_RWFromConstMem(file, (int)size), SDL_TRUE, &spec, &bad_buf, &bad_len);
+            error = SDL_GetError();
+            SDLTest_AssertCheck(ret == -1, "Call to SDL_LoadWAV_RW() with a bad %s block on four threads, expected -1, got %d", files[f].name, ret);
+            SDLTest_AssertCheck(SDL_strstr(error, "coefficient index") != NULL, "Verify the decoder error is reported, got: %s", error);
+            SDL_free(bad_buf);
+        }
+    }
+    SDL_ResetHint(SDL_HINT_WAVE_DECODE_THREADS);
+
+    SDL_free(file);
+    SDL_free(data);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1326,12 +1654,25 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_waveStream, "audio_waveStream", "Check decoding WAVE files on demand.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_decodeCompanded, "audio_decodeCompanded", "Check decoding of A-law and mu-law WAVE data.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_decodeADPCMThreaded, "audio_decodeADPCMThreaded", "Check decoding of big ADPCM WAVE files on several threads.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19,
+    &audioTest20, &audioTest21, NULL
 };
 
 /* Audio test suite (global) */
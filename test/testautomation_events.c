@@ -175,6 +175,280 @@ static int events_addDelEventWatchWithUserdata(void *arg)
     return TEST_COMPLETED;
 }
 
+#define EVENTS_THREAD_COUNT 4
+#define EVENTS_PER_THREAD   3000
+
+static int SDLCALL events_pushThread(void *data)
+{
+    int i;
+
+    for (i = 0; i < EVENTS_PER_THREAD; ++i) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = i;
+        event.user.data1 = data;
+        while (SDL_PushEvent(&event) < 0) {
+            /* The queue is full, wait for the main thread to catch up */
+            SDL_Delay(1);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Pushes events from several threads at once and checks that they all arrive in order.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PollEvent
+ * \sa SDL_PeepEvents
+ */
+static int events_pushFromThreads(void *arg)
+{
+    SDL_Thread *threads[EVENTS_THREAD_COUNT];
+    int next[EVENTS_THREAD_COUNT];
+    int i, received = 0, out_of_order = 0;
+    Uint64 timeout;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < EVENTS_THREAD_COUNT; ++i) {
+        next[i] = 0;
+        threads[i] = SDL_CreateThread(events_pushThread, "events_pushThread", &next[i]);
+        SDLTest_AssertCheck(threads[i] != NULL, "Check that thread %d was created", i);
+    }
+
+    timeout = SDL_GetTicks() + 10000;
+    while (received < EVENTS_THREAD_COUNT * EVENTS_PER_THREAD && SDL_GetTicks() < timeout) {
+        SDL_Event event;
+
+        /* Mix in some filtered calls, which see the whole queue */
+        if ((received % 100) == 0) {
+            SDL_HasEvents(SDL_EVENT_USER, SDL_EVENT_USER);
+        }
+
+        if (!SDL_PollEvent(&event)) {
+            SDL_Delay(1);
+            continue;
+        }
+        if (event.type != SDL_EVENT_USER) {
+            continue;
+        }
+        for (i = 0; i < EVENTS_THREAD_COUNT; ++i) {
+            if (event.user.data1 == &next[i]) {
+                if (event.user.code != next[i]) {
+                    ++out_of_order;
+                }
+                next[i] = event.user.code + 1;
+                ++received;
+                break;
+            }
+        }
+    }
+
+    for (i = 0; i < EVENTS_THREAD_COUNT; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    /* Don't leave the end of a poll cycle behind for the next test */
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(received == EVENTS_THREAD_COUNT * EVENTS_PER_THREAD, "Check number of events received, expected: %d, got: %d", EVENTS_THREAD_COUNT * EVENTS_PER_THREAD, received);
+    SDLTest_AssertCheck(out_of_order == 0, "Check events arrived in order, expected: 0 out of order, got: %d", out_of_order);
+
+    return TEST_COMPLETED;
+}
+
+/* Count the user events in a batch, checking that their codes are sequential */
+static int events_countUserEvents(const SDL_Event *events, int count, int *next)
+{
+    int i, found = 0;
+
+    for (i = 0; i < count; ++i) {
+        if (events[i].type == SDL_EVENT_USER) {
+            SDLTest_AssertCheck(events[i].user.code == *next, "Check user event code, expected: %d, got: %d", *next, events[i].user.code);
+            *next = events[i].user.code + 1;
+            ++found;
+        }
+        SDLTest_AssertCheck(events[i].type != SDL_EVENT_POLL_SENTINEL, "Check that the poll sentinel isn't returned");
+    }
+    return found;
+}
+
+/**
+ * Polls several events at once and checks that polling stops at the end of a poll cycle.
+ *
+ * \sa SDL_PollEvents
+ * \sa SDL_PushEvent
+ */
+static int events_pollEvents(void *arg)
+{
+    SDL_Event events[16];
+    SDL_Event event;
+    int i, result, found, next = 0;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    result = SDL_PollEvents(NULL, 1);
+    SDLTest_AssertCheck(result < 0, "Check result from SDL_PollEvents(NULL), expected: < 0, got: %d", result);
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    for (i = 0; i < 6; ++i) {
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertPass("Call to SDL_PushEvent()");
+
+    /* Only take part of the queued events */
+    result = SDL_PollEvents(events, 4);
+    SDLTest_AssertPass("Call to SDL_PollEvents()");
+    SDLTest_AssertCheck(result == 4, "Check result from SDL_PollEvents, expected: 4, got: %d", result);
+    found = events_countUserEvents(events, result, &next);
+    SDLTest_AssertCheck(found == 4, "Check number of user events, expected: 4, got: %d", found);
+
+    /* This event is after the end of the current poll cycle */
+    event.user.code = 6;
+    SDL_PushEvent(&event);
+
+    found = 0;
+    while ((result = SDL_PollEvents(events, SDL_arraysize(events))) > 0) {
+        found += events_countUserEvents(events, result, &next);
+    }
+    SDLTest_AssertCheck(result == 0, "Check result from SDL_PollEvents at the end of the poll cycle, expected: 0, got: %d", result);
+    SDLTest_AssertCheck(found == 2, "Check number of user events in the first poll cycle, expected: 2, got: %d", found);
+
+    found = 0;
+    while ((result = SDL_PollEvents(events, SDL_arraysize(events))) > 0) {
+        found += events_countUserEvents(events, result, &next);
+    }
+    SDLTest_AssertCheck(found == 1, "Check number of user events in the next poll cycle, expected: 1, got: %d", found);
+    SDLTest_AssertCheck(next == 7, "Check that all user events were received, expected: 7, got: %d", next);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks that motion and axis events are merged when event coalescing is enabled.
+ *
+ * \sa SDL_HINT_EVENT_COALESCING
+ * \sa SDL_GetNumCoalescedEvents
+ */
+static int events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    int i, coalesced, motion = 0, axis = 0;
+    float xrel = 0.0f, x = 0.0f;
+    Sint16 axis0 = 0, axis1 = 0;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHint(SDL_HINT_EVENT_COALESCING, "1");
+    coalesced = SDL_GetNumCoalescedEvents();
+
+    /* Three motion events, then axis events for two axes interleaved */
+    for (i = 0; i < 3; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.which = 1;
+        event.motion.x = 10.0f + i;
+        event.motion.xrel = 1.0f;
+        SDL_PushEvent(&event);
+    }
+    for (i = 0; i < 4; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_JOYSTICK_AXIS_MOTION;
+        event.jaxis.which = 1;
+        event.jaxis.axis = (Uint8)(i % 2);
+        event.jaxis.value = (Sint16)(100 * (i + 1));
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertPass("Call to SDL_PushEvent()");
+
+    coalesced = SDL_GetNumCoalescedEvents() - coalesced;
+    SDLTest_AssertCheck(coalesced == 4, "Check number of coalesced events, expected: 4, got: %d", coalesced);
+
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_EVENT_MOUSE_MOTION) {
+            ++motion;
+            x = event.motion.x;
+            xrel = event.motion.xrel;
+        } else if (event.type == SDL_EVENT_JOYSTICK_AXIS_MOTION) {
+            ++axis;
+            if (event.jaxis.axis == 0) {
+                axis0 = event.jaxis.value;
+            } else {
+                axis1 = event.jaxis.value;
+            }
+        }
+    }
+    SDLTest_AssertCheck(motion == 1, "Check number of motion events, expected: 1, got: %d", motion);
+    SDLTest_AssertCheck(x == 12.0f, "Check motion position, expected: 12, got: %g", x);
+    SDLTest_AssertCheck(xrel == 3.0f, "Check relative motion, expected: 3, got: %g", xrel);
+    SDLTest_AssertCheck(axis == 2, "Check number of axis events, expected: 2, got: %d", axis);
+    SDLTest_AssertCheck(axis0 == 300 && axis1 == 400, "Check axis values, expected: 300 and 400, got: %d and %d", axis0, axis1);
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCING);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Allocates event memory of various sizes and checks that it stays intact until the events are handled.
+ *
+ * \sa SDL_AllocateEventMemory
+ */
+static int events_allocateEventMemory(void *arg)
+{
+    SDL_Event event;
+    int i, count = 0, corrupted = 0, misaligned = 0;
+    const int num_allocations = 300;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < num_allocations; ++i) {
+        /* Mix small allocations with a few larger than any internal block */
+        const size_t size = (i % 50 == 49) ? 10000 : (size_t)(1 + (i * 7) % 300);
+        Uint8 *memory = (Uint8 *)SDL_AllocateEventMemory(size);
+
+        if (!memory) {
+            SDLTest_LogError("SDL_AllocateEventMemory(%d) failed: %s", (int)size, SDL_GetError());
+            break;
+        }
+        if (((uintptr_t)memory % sizeof(void *)) != 0) {
+            ++misaligned;
+        }
+        SDL_memset(memory, (Uint8)i, size);
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = i;
+        event.user.data1 = memory;
+        event.user.data2 = (void *)size;
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertCheck(misaligned == 0, "Check alignment of event memory, expected: 0 misaligned, got: %d", misaligned);
+
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_EVENT_USER) {
+            const Uint8 *memory = (const Uint8 *)event.user.data1;
+            const size_t size = (size_t)event.user.data2;
+            size_t j;
+
+            for (j = 0; j < size; ++j) {
+                if (memory[j] != (Uint8)event.user.code) {
+                    ++corrupted;
+                    break;
+                }
+            }
+            ++count;
+        }
+    }
+    SDLTest_AssertCheck(count == num_allocations, "Check number of events, expected: %d, got: %d", num_allocations, count);
+    SDLTest_AssertCheck(corrupted == 0, "Check event memory contents, expected: 0 corrupted, got: %d", corrupted);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -190,9 +464,25 @@ static const SDLTest_TestCaseReference eventsTest3 = {
     (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest4 = {
+    (SDLTest_TestCaseFp)events_pushFromThreads, "events_pushFromThreads", "Pushes events from several threads and polls them in order", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest5 = {
+    (SDLTest_TestCaseFp)events_pollEvents, "events_pollEvents", "Polls several events at once, stopping at the end of a poll cycle", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest6 = {
+    (SDLTest_TestCaseFp)events_coalesceMotion, "events_coalesceMotion", "Merges motion and axis events when event coalescing is enabled", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest7 = {
+    (SDLTest_TestCaseFp)events_allocateEventMemory, "events_allocateEventMemory", "Allocates event memory and checks it stays intact until the events are handled", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, &eventsTest7, NULL
 };
 
 /* Events test suite (global) */
@@ -235,6 +235,74 @@ static int hints_setHint(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Call to SDL_GetHint after the environment changes, and with many hints set
+ */
+static int hints_environmentAndMany(void *arg)
+{
+    const char *envHint = "SDL_AUTOMATED_TEST_ENVIRONMENT_HINT";
+    const char *testValue;
+    char name[64], value[16];
+    int i, wrong = 0;
+    SDL_bool result;
+
+    /* A hint that isn't set is cached too, make sure a new environment variable is seen */
+    testValue = SDL_GetHint(envHint);
+    SDLTest_AssertCheck(testValue == NULL, "testValue = %s, expected NULL", testValue);
+
+    SDL_setenv(envHint, "first", 1);
+    testValue = SDL_GetHint(envHint);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "first") == 0,
+        "testValue = %s, expected \"first\"",
+        testValue);
+
+    /* The environment is cached, make sure changes are seen */
+    SDL_setenv(envHint, "second", 1);
+    testValue = SDL_GetHint(envHint);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "second") == 0,
+        "testValue = %s, expected \"second\"",
+        testValue);
+
+    result = SDL_SetHint(envHint, "temp");
+    SDLTest_AssertCheck(result == SDL_FALSE, "Verify the environment takes precedence over SDL_SetHint()");
+    testValue = SDL_GetHint(envHint);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "second") == 0,
+        "testValue = %s, expected \"second\"",
+        testValue);
+
+    /* Values returned before the environment changed stay valid */
+    SDL_setenv(envHint, "third", 1);
+    SDLTest_AssertCheck(
+        SDL_strcmp(testValue, "second") == 0,
+        "Previous value = %s, expected \"second\"",
+        testValue);
+    testValue = SDL_GetHint(envHint);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "third") == 0,
+        "testValue = %s, expected \"third\"",
+        testValue);
+
+    for (i = 0; i < 500; ++i) {
+        SDL_snprintf(name, sizeof(name), "SDL_AUTOMATED_TEST_HINT_%d", i);
+        SDL_snprintf(value, sizeof(value), "%d", i);
+        SDL_SetHint(name, value);
+    }
+    for (i = 0; i < 500; ++i) {
+        SDL_snprintf(name, sizeof(name), "SDL_AUTOMATED_TEST_HINT_%d", i);
+        testValue = SDL_GetHint(name);
+        if (!testValue || SDL_atoi(testValue) != i) {
+            ++wrong;
+        }
+        SDL_ResetHint(name);
+    }
+    SDLTest_AssertCheck(wrong == 0, "Verify 500 hints, expected 0 wrong, got: %d", wrong);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Hints test cases */
@@ -246,9 +314,13 @@ static const SDLTest_TestCaseReference hintsTest2 = {
     (SDLTest_TestCaseFp)hints_setHint, "hints_setHint", "Call to SDL_SetHint", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference hintsTest3 = {
+    (SDLTest_TestCaseFp)hints_environmentAndMany, "hints_environmentAndMany", "Call to SDL_GetHint after environment changes and with many hints", TEST_ENABLED
+};
+
 /* Sequence of Hints test cases */
 static const SDLTest_TestCaseReference *hintsTests[] = {
-    &hintsTest1, &hintsTest2, NULL
+    &hintsTest1, &hintsTest2, &hintsTest3, NULL
 };
 
 /* Hints test suite (global) */
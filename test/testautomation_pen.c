@@ -70,6 +70,10 @@
 #define SDL_MousePositionInWindow SDL_Mock_MousePositionInWindow
 #define SDL_SetMouseFocus         SDL_Mock_SetMouseFocus
 
+/* Internal locks aren't named outside of SDL */
+#define SDL_CreateMutexNamed(name) SDL_CreateMutex()
+#define SDL_LOCK_NAME              NULL
+
 /* Mock mouse API */
 static int SDL_SendMouseMotion(Uint64 timestamp, SDL_Window *window, SDL_MouseID mouseID, int relative, float x, float y);
 static int SDL_SendMouseButton(Uint64 timestamp, SDL_Window *window, SDL_MouseID mouseID, Uint8 state, Uint8 button);
@@ -520,6 +520,70 @@ static int platform_testGetPowerInfo(void *arg)
     return TEST_COMPLETED;
 }
 
+static SDL_TLSID platform_tls;
+
+static int SDLCALL platform_TLSThread(void *data)
+{
+    int *result = (int *)data;
+
+    /* A new thread starts with no TLS value and no error */
+    if (SDL_GetTLS(platform_tls) != NULL || *SDL_GetError() != '\0') {
+        *result = -1;
+        return 0;
+    }
+    if (SDL_SetTLS(platform_tls, "thread", NULL) != 0) {
+        *result = -1;
+        return 0;
+    }
+    SDL_SetError("thread error");
+    if (SDL_strcmp((const char *)SDL_GetTLS(platform_tls), "thread") != 0 ||
+        SDL_strcmp(SDL_GetError(), "thread error") != 0) {
+        *result = -1;
+        return 0;
+    }
+    *result = 1;
+    return 0;
+}
+
+/**
+ * Tests that thread-local storage and the error message are per-thread
+ * \sa SDL_GetTLS
+ * \sa SDL_SetTLS
+ * \sa SDL_GetError
+ */
+static int platform_testThreadLocalStorage(void *arg)
+{
+    SDL_Thread *thread;
+    int result = 0;
+    int rc;
+
+    platform_tls = SDL_CreateTLS();
+    SDLTest_AssertCheck(platform_tls != 0, "SDL_CreateTLS() returned a valid ID");
+    SDLTest_AssertCheck(SDL_GetTLS(platform_tls) == NULL, "SDL_GetTLS() is NULL before SDL_SetTLS()");
+
+    rc = SDL_SetTLS(platform_tls, "main", NULL);
+    SDLTest_AssertCheck(rc == 0, "SDL_SetTLS(): expected 0, got: %i", rc);
+    SDL_SetError("main error");
+
+    thread = SDL_CreateThread(platform_TLSThread, "TLSThread", &result);
+    SDLTest_AssertCheck(thread != NULL, "SDL_CreateThread()");
+    if (thread) {
+        SDL_WaitThread(thread, NULL);
+        SDLTest_AssertCheck(result == 1, "Thread saw its own TLS value and error message");
+    }
+
+    SDLTest_AssertCheck(SDL_strcmp((const char *)SDL_GetTLS(platform_tls), "main") == 0,
+                        "SDL_GetTLS(): expected main, got: %s", (const char *)SDL_GetTLS(platform_tls));
+    SDLTest_AssertCheck(SDL_strcmp(SDL_GetError(), "main error") == 0,
+                        "SDL_GetError(): expected main error, got: %s", SDL_GetError());
+
+    /* Clean up */
+    SDL_SetTLS(platform_tls, NULL, NULL);
+    SDL_ClearError();
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Platform test cases */
@@ -567,6 +631,10 @@ static const SDLTest_TestCaseReference platformTest11 = {
     (SDLTest_TestCaseFp)platform_testGetPowerInfo, "platform_testGetPowerInfo", "Tests SDL_GetPowerInfo function", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference platformTest12 = {
+    (SDLTest_TestCaseFp)platform_testThreadLocalStorage, "platform_testThreadLocalStorage", "Tests per-thread TLS values and error messages", TEST_ENABLED
+};
+
 /* Sequence of Platform test cases */
 static const SDLTest_TestCaseReference *platformTests[] = {
     &platformTest1,
@@ -580,6 +648,7 @@ static const SDLTest_TestCaseReference *platformTests[] = {
     &platformTest9,
     &platformTest10,
     &platformTest11,
+    &platformTest12,
     NULL
 };
 
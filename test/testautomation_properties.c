@@ -321,6 +321,168 @@ static int properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test large numbers of properties and property groups
+ */
+static int properties_testMany(void *arg)
+{
+    const int num_properties = 2000;
+    const int num_groups = 500;
+    SDL_PropertiesID props, *groups;
+    char key[32];
+    int i, count, wrong = 0;
+
+    props = SDL_CreateProperties();
+    SDLTest_AssertCheck(props != 0,
+        "Verify props were created, got: %" SDL_PRIu32 "", props);
+
+    for (i = 0; i < num_properties; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "property%d", i);
+        SDL_SetNumberProperty(props, key, i);
+    }
+    SDLTest_AssertPass("Call to SDL_SetNumberProperty() %d times", num_properties);
+
+    /* Remove every other property, the rest should still be found */
+    for (i = 1; i < num_properties; i += 2) {
+        SDL_snprintf(key, SDL_arraysize(key), "property%d", i);
+        SDL_ClearProperty(props, key);
+    }
+    SDLTest_AssertPass("Call to SDL_ClearProperty() %d times", num_properties / 2);
+
+    for (i = 0; i < num_properties; ++i) {
+        const Sint64 expected = (i % 2) ? -1 : i;
+        SDL_snprintf(key, SDL_arraysize(key), "property%d", i);
+        if (SDL_GetNumberProperty(props, key, -1) != expected) {
+            ++wrong;
+        }
+    }
+    SDLTest_AssertCheck(wrong == 0,
+        "Verify property values, expected 0 wrong, got: %d", wrong);
+
+    count = 0;
+    SDL_EnumerateProperties(props, count_properties, &count);
+    SDLTest_AssertCheck(count == num_properties / 2,
+        "Verify property count, expected %d, got: %d", num_properties / 2, count);
+
+    SDL_DestroyProperties(props);
+
+    groups = (SDL_PropertiesID *)SDL_malloc(num_groups * sizeof(*groups));
+    SDLTest_AssertCheck(groups != NULL, "Verify allocation of property group IDs");
+    if (groups) {
+        wrong = 0;
+        for (i = 0; i < num_groups; ++i) {
+            groups[i] = SDL_CreateProperties();
+            SDL_SetNumberProperty(groups[i], "index", i);
+        }
+        for (i = 0; i < num_groups; ++i) {
+            if (SDL_GetNumberProperty(groups[i], "index", -1) != i) {
+                ++wrong;
+            }
+        }
+        SDLTest_AssertCheck(wrong == 0,
+            "Verify properties in %d groups, expected 0 wrong, got: %d", num_groups, wrong);
+        for (i = 0; i < num_groups; ++i) {
+            SDL_DestroyProperties(groups[i]);
+        }
+        SDL_free(groups);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test looking up properties that aren't set
+ */
+static int properties_testMissing(void *arg)
+{
+    SDL_PropertiesID props1, props2;
+    Sint64 value;
+    const char *error;
+
+    props1 = SDL_CreateProperties();
+    props2 = SDL_CreateProperties();
+    SDL_SetNumberProperty(props1, "shared_name", 1);
+
+    SDL_ClearError();
+    value = SDL_GetNumberProperty(props1, "never_set", -1);
+    SDLTest_AssertCheck(value == -1,
+        "Verify property that was never set, expected -1, got: %" SDL_PRIs64, value);
+    error = SDL_GetError();
+    SDLTest_AssertCheck(error && SDL_strcmp(error, "Couldn't find property named never_set") == 0,
+        "Verify error for a property that was never set, got: '%s'", error ? error : "NULL");
+
+    SDL_ClearError();
+    value = SDL_GetNumberProperty(props2, "shared_name", -1);
+    SDLTest_AssertCheck(value == -1,
+        "Verify property set in another group, expected -1, got: %" SDL_PRIs64, value);
+    error = SDL_GetError();
+    SDLTest_AssertCheck(error && SDL_strcmp(error, "Couldn't find property named shared_name") == 0,
+        "Verify error for a property set in another group, got: '%s'", error ? error : "NULL");
+
+    SDL_ClearError();
+    value = SDL_GetNumberProperty(props1, "shared_name", -1);
+    SDLTest_AssertCheck(value == 1,
+        "Verify property that was set, expected 1, got: %" SDL_PRIs64, value);
+    error = SDL_GetError();
+    SDLTest_AssertCheck(error && !*error,
+        "Verify properties that are set don't set an error, got: '%s'", error ? error : "NULL");
+
+    SDLTest_AssertCheck(SDL_ClearProperty(props2, "never_set_either") == 0,
+        "Verify clearing a property that was never set succeeds");
+    SDLTest_AssertCheck(SDL_GetPropertyType(props2, "never_set_either") == SDL_PROPERTY_TYPE_INVALID,
+        "Verify type of a property that was never set");
+
+    SDL_DestroyProperties(props1);
+    SDL_DestroyProperties(props2);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test contended locking of a property group
+ */
+#define CONTENDED_THREADS    4
+#define CONTENDED_INCREMENTS 10000
+
+static int SDLCALL properties_incrementThread(void *arg)
+{
+    SDL_PropertiesID props = *(SDL_PropertiesID *)arg;
+    int i;
+
+    for (i = 0; i < CONTENDED_INCREMENTS; ++i) {
+        /* The property lock is recursive, so this nests inside the setter */
+        SDL_LockProperties(props);
+        SDL_SetNumberProperty(props, "count", SDL_GetNumberProperty(props, "count", 0) + 1);
+        SDL_UnlockProperties(props);
+    }
+    return 0;
+}
+
+static int properties_testContention(void *arg)
+{
+    SDL_Thread *threads[CONTENDED_THREADS];
+    SDL_PropertiesID props;
+    Sint64 count;
+    int i;
+
+    props = SDL_CreateProperties();
+    for (i = 0; i < CONTENDED_THREADS; ++i) {
+        threads[i] = SDL_CreateThread(properties_incrementThread, "PropertiesIncrement", &props);
+        SDLTest_AssertCheck(threads[i] != NULL, "Verify thread %d was created", i);
+    }
+    for (i = 0; i < CONTENDED_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    count = SDL_GetNumberProperty(props, "count", 0);
+    SDLTest_AssertCheck(count == CONTENDED_THREADS * CONTENDED_INCREMENTS,
+        "Verify property count, expected %d, got: %" SDL_PRIs64, CONTENDED_THREADS * CONTENDED_INCREMENTS, count);
+
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -336,9 +498,21 @@ static const SDLTest_TestCaseReference propertiesTest3 = {
     (SDLTest_TestCaseFp)properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTest4 = {
+    (SDLTest_TestCaseFp)properties_testMany, "properties_testMany", "Test large numbers of properties and property groups", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTest5 = {
+    (SDLTest_TestCaseFp)properties_testMissing, "properties_testMissing", "Test looking up properties that aren't set", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTest6 = {
+    (SDLTest_TestCaseFp)properties_testContention, "properties_testContention", "Test contended locking of a property group", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
-    &propertiesTest1, &propertiesTest2, &propertiesTest3, NULL
+    &propertiesTest1, &propertiesTest2, &propertiesTest3, &propertiesTest4, &propertiesTest5, &propertiesTest6, NULL
 };
 
 /* Properties test suite (global) */
@@ -635,6 +635,456 @@ static int rwops_testFileWriteReadEndian(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading through a read-ahead buffer.
+ *
+ * \sa SDL_SetRWBufferSize
+ * \sa SDL_RWread
+ * \sa SDL_RWseek
+ */
+static int rwops_testBufferedRead(void *arg)
+{
+    char mem[sizeof(RWopsHelloWorldTestString)];
+    char buf[sizeof(RWopsAlphabetString)];
+    SDL_RWops *rw;
+    Uint8 u8;
+    Uint16 u16;
+    Uint32 u32;
+    Sint64 pos;
+    size_t s;
+    int result;
+
+    /* Run generic tests on a buffered memory stream */
+    SDL_zeroa(mem);
+    rw = SDL_RWFromMem(mem, sizeof(RWopsHelloWorldTestString) - 1);
+    SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_RWFromMem does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    result = SDL_SetRWBufferSize(rw, 5);
+    SDLTest_AssertCheck(result == 0, "Verify result of SDL_SetRWBufferSize(5), expected 0, got %d", result);
+    testGenericRWopsValidations(rw, SDL_TRUE);
+    SDL_RWclose(rw);
+
+    rw = SDL_RWFromConstMem(RWopsAlphabetString, sizeof(RWopsAlphabetString) - 1);
+    SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_RWFromConstMem does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    result = SDL_SetRWBufferSize(rw, 8);
+    SDLTest_AssertCheck(result == 0, "Verify result of SDL_SetRWBufferSize(8), expected 0, got %d", result);
+
+    /* Small reads, crossing the end of the buffer */
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &u8) && u8 == 'A', "Verify SDL_ReadU8(), expected 'A', got '%c'", u8);
+    SDLTest_AssertCheck(SDL_ReadU32BE(rw, &u32) && u32 == 0x42434445, "Verify SDL_ReadU32BE(), expected 0x42434445, got 0x%" SDL_PRIx32, u32);
+    SDLTest_AssertCheck(SDL_ReadU32BE(rw, &u32) && u32 == 0x46474849, "Verify SDL_ReadU32BE(), expected 0x46474849, got 0x%" SDL_PRIx32, u32);
+    pos = SDL_RWtell(rw);
+    SDLTest_AssertCheck(pos == 9, "Verify SDL_RWtell(), expected 9, got %" SDL_PRIs64, pos);
+
+    /* Seeks within and outside of the buffered data */
+    pos = SDL_RWseek(rw, -2, SDL_RW_SEEK_CUR);
+    SDLTest_AssertCheck(pos == 7, "Verify SDL_RWseek(-2, SDL_RW_SEEK_CUR), expected 7, got %" SDL_PRIs64, pos);
+    SDLTest_AssertCheck(SDL_ReadU16BE(rw, &u16) && u16 == 0x4849, "Verify SDL_ReadU16BE(), expected 0x4849, got 0x%x", u16);
+    pos = SDL_RWseek(rw, 20, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(pos == 20, "Verify SDL_RWseek(20, SDL_RW_SEEK_SET), expected 20, got %" SDL_PRIs64, pos);
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &u8) && u8 == 'U', "Verify SDL_ReadU8(), expected 'U', got '%c'", u8);
+    pos = SDL_RWseek(rw, 2, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(pos == 2, "Verify SDL_RWseek(2, SDL_RW_SEEK_SET), expected 2, got %" SDL_PRIs64, pos);
+
+    /* Reads bigger than the buffer */
+    SDL_zeroa(buf);
+    s = SDL_RWread(rw, buf, 20);
+    SDLTest_AssertCheck(s == 20, "Verify result of SDL_RWread(), expected 20, got %i", (int)s);
+    SDLTest_AssertCheck(SDL_memcmp(buf, &RWopsAlphabetString[2], 20) == 0, "Verify read bytes match expected string");
+
+    /* Removing the buffer keeps the read position */
+    SDLTest_AssertCheck(SDL_ReadU8(rw, &u8) && u8 == 'W', "Verify SDL_ReadU8(), expected 'W', got '%c'", u8);
+    result = SDL_SetRWBufferSize(rw, 0);
+    SDLTest_AssertCheck(result == 0, "Verify result of SDL_SetRWBufferSize(0), expected 0, got %d", result);
+    pos = SDL_RWtell(rw);
+    SDLTest_AssertCheck(pos == 23, "Verify SDL_RWtell(), expected 23, got %" SDL_PRIs64, pos);
+    s = SDL_RWread(rw, buf, sizeof(buf));
+    SDLTest_AssertCheck(s == 3, "Verify result of SDL_RWread(), expected 3, got %i", (int)s);
+    SDLTest_AssertCheck(rw->status == SDL_RWOPS_STATUS_READY, "Verify status is SDL_RWOPS_STATUS_READY, got %" SDL_PRIu32, rw->status);
+    s = SDL_RWread(rw, buf, sizeof(buf));
+    SDLTest_AssertCheck(s == 0 && rw->status == SDL_RWOPS_STATUS_EOF, "Verify SDL_RWread() at end of stream returns 0 with SDL_RWOPS_STATUS_EOF");
+
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reading from a memory-mapped file.
+ *
+ * \sa SDL_RWFromFile
+ * \sa SDL_GetRWRange
+ */
+static int rwops_testFileMapped(void *arg)
+{
+    char buf[sizeof(RWopsAlphabetString)];
+    const char *range;
+    SDL_RWops *rw;
+    Sint64 pos;
+    size_t s;
+    int result;
+
+    rw = SDL_RWFromFile(RWopsAlphabetFilename, "rbm");
+    SDLTest_AssertPass("Call to SDL_RWFromFile(..,\"rbm\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFile in mapped read mode does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* Reads and seeks work whether or not the file could be mapped */
+    SDL_zeroa(buf);
+    s = SDL_RWread(rw, buf, 4);
+    SDLTest_AssertCheck(s == 4 && SDL_memcmp(buf, "ABCD", 4) == 0, "Verify SDL_RWread() of the first 4 bytes");
+    pos = SDL_RWseek(rw, -3, SDL_RW_SEEK_END);
+    SDLTest_AssertCheck(pos == 23, "Verify SDL_RWseek(-3, SDL_RW_SEEK_END), expected 23, got %" SDL_PRIs64, pos);
+    s = SDL_RWread(rw, buf, sizeof(buf));
+    SDLTest_AssertCheck(s == 3 && SDL_memcmp(buf, "XYZ", 3) == 0, "Verify SDL_RWread() of the last 3 bytes");
+
+    if (rw->type == SDL_RWOPS_MAPPED) {
+        range = (const char *)SDL_GetRWRange(rw, 10, 5);
+        SDLTest_AssertCheck(range != NULL && SDL_memcmp(range, "KLMNO", 5) == 0, "Verify SDL_GetRWRange(10, 5) points at KLMNO");
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == 26, "Verify SDL_GetRWRange() doesn't move the stream, expected 26, got %" SDL_PRIs64, pos);
+        range = (const char *)SDL_GetRWRange(rw, 24, 3);
+        SDLTest_AssertCheck(range == NULL, "Verify SDL_GetRWRange() past the end of the file returns NULL");
+    } else {
+        SDLTest_Log("Memory-mapped files aren't supported on this platform");
+        range = (const char *)SDL_GetRWRange(rw, 0, 1);
+        SDLTest_AssertCheck(range == NULL, "Verify SDL_GetRWRange() on a file stream returns NULL");
+    }
+
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
+/* Local helper to make a memory stream that doesn't know its size */
+static SDL_RWops *RWFromUnsizedMem(const void *mem, size_t size)
+{
+    SDL_RWops *rw = SDL_RWFromConstMem(mem, size);
+    if (rw) {
+        rw->size = NULL;
+        rw->seek = NULL;
+    }
+    return rw;
+}
+
+/**
+ * Tests loading whole streams, with and without a known size.
+ *
+ * \sa SDL_LoadFile_RW
+ * \sa SDL_LoadFileInto_RW
+ */
+static int rwops_testLoadFile(void *arg)
+{
+    const size_t size = 100000;
+    Uint8 *mem, *data;
+    size_t i, datasize;
+    int result;
+
+    mem = (Uint8 *)SDL_malloc(size);
+    SDLTest_AssertCheck(mem != NULL, "Verify allocation of test data");
+    if (mem == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < size; ++i) {
+        mem[i] = (Uint8)(i * 7);
+    }
+
+    /* A stream of unknown size is loaded in growing blocks */
+    datasize = 0;
+    data = (Uint8 *)SDL_LoadFile_RW(RWFromUnsizedMem(mem, size), &datasize, SDL_TRUE);
+    SDLTest_AssertCheck(data != NULL, "Verify SDL_LoadFile_RW() of an unsized stream does not return NULL");
+    SDLTest_AssertCheck(datasize == size, "Verify loaded size, expected %i, got %i", (int)size, (int)datasize);
+    if (data) {
+        SDLTest_AssertCheck(SDL_memcmp(data, mem, size) == 0, "Verify loaded data matches");
+        SDLTest_AssertCheck(data[datasize] == 0, "Verify loaded data is null terminated");
+        SDL_free(data);
+    }
+
+    /* Loading into caller memory */
+    data = (Uint8 *)SDL_malloc(size);
+    SDLTest_AssertCheck(data != NULL, "Verify allocation of load buffer");
+    if (data) {
+        SDL_memset(data, 0, size);
+        result = SDL_LoadFileInto_RW(SDL_RWFromConstMem(mem, size), data, size, &datasize, SDL_TRUE);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_LoadFileInto_RW() with a sized stream, expected 0, got %d", result);
+        SDLTest_AssertCheck(datasize == size && SDL_memcmp(data, mem, size) == 0, "Verify loaded data matches");
+
+        SDL_memset(data, 0, size);
+        result = SDL_LoadFileInto_RW(RWFromUnsizedMem(mem, size), data, size, &datasize, SDL_TRUE);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_LoadFileInto_RW() with an unsized stream, expected 0, got %d", result);
+        SDLTest_AssertCheck(datasize == size && SDL_memcmp(data, mem, size) == 0, "Verify loaded data matches");
+
+        /* Buffers that are too small */
+        datasize = 0;
+        result = SDL_LoadFileInto_RW(SDL_RWFromConstMem(mem, size), data, size - 1, &datasize, SDL_TRUE);
+        SDLTest_AssertCheck(result < 0, "Verify SDL_LoadFileInto_RW() with a small buffer fails, got %d", result);
+        SDLTest_AssertCheck(datasize == size, "Verify needed size is reported, expected %i, got %i", (int)size, (int)datasize);
+        result = SDL_LoadFileInto_RW(RWFromUnsizedMem(mem, size), data, size - 1, NULL, SDL_TRUE);
+        SDLTest_AssertCheck(result < 0, "Verify SDL_LoadFileInto_RW() with a small buffer and an unsized stream fails, got %d", result);
+
+        SDL_free(data);
+    }
+
+    SDL_free(mem);
+
+    return TEST_COMPLETED;
+}
+
+static SDL_AtomicInt asyncCallbacks;
+
+static void SDLCALL AsyncReadCallback(const SDL_AsyncIOResult *result)
+{
+    if (result->status == SDL_ASYNCIO_COMPLETE && result->bytes == 4 &&
+        SDL_memcmp(result->buffer, "WXYZ", 4) == 0) {
+        SDL_AtomicIncRef(&asyncCallbacks);
+    }
+}
+
+/**
+ * Tests asynchronous reads from files, memory and generic streams.
+ *
+ * \sa SDL_CreateAsyncIOQueue
+ * \sa SDL_ReadAsync
+ * \sa SDL_WaitAsyncIOResult
+ */
+static int rwops_testAsyncRead(void *arg)
+{
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOResult result;
+    SDL_RWops *file, *mem, *stream;
+    char buffers[4][8];
+    int i, found, result_code;
+
+    queue = SDL_CreateAsyncIOQueue(2);
+    SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateAsyncIOQueue() does not return NULL");
+    if (queue == NULL) {
+        return TEST_ABORTED;
+    }
+
+    file = SDL_RWFromFile(RWopsAlphabetFilename, "rb");
+    mem = SDL_RWFromConstMem(RWopsAlphabetString, sizeof(RWopsAlphabetString) - 1);
+    stream = SDL_RWFromConstMem(RWopsAlphabetString, sizeof(RWopsAlphabetString) - 1);
+    SDLTest_AssertCheck(file && mem && stream, "Verify streams were opened");
+    if (!file || !mem || !stream) {
+        return TEST_ABORTED;
+    }
+    stream->type = SDL_RWOPS_UNKNOWN; /* Read through SDL_RWseek() and SDL_RWread() */
+
+    SDL_zeroa(buffers);
+    SDL_AtomicSet(&asyncCallbacks, 0);
+    result_code = SDL_ReadAsync(queue, file, 2, buffers[0], 4, NULL, (void *)(intptr_t)0);
+    SDLTest_AssertCheck(result_code == 0, "Verify SDL_ReadAsync() from a file, expected 0, got %d", result_code);
+    result_code = SDL_ReadAsync(queue, mem, 10, buffers[1], 4, NULL, (void *)(intptr_t)1);
+    SDLTest_AssertCheck(result_code == 0, "Verify SDL_ReadAsync() from memory, expected 0, got %d", result_code);
+    result_code = SDL_ReadAsync(queue, stream, 24, buffers[2], 4, NULL, (void *)(intptr_t)2);
+    SDLTest_AssertCheck(result_code == 0, "Verify SDL_ReadAsync() from a stream, expected 0, got %d", result_code);
+    result_code = SDL_ReadAsync(queue, file, 22, buffers[3], 4, AsyncReadCallback, NULL);
+    SDLTest_AssertCheck(result_code == 0, "Verify SDL_ReadAsync() with a callback, expected 0, got %d", result_code);
+
+    found = 0;
+    while (SDL_WaitAsyncIOResult(queue, &result, -1)) {
+        i = (int)(intptr_t)result.userdata;
+        SDLTest_AssertCheck(result.status == SDL_ASYNCIO_COMPLETE, "Verify request %d completed", i);
+        SDLTest_AssertCheck(result.buffer == buffers[i], "Verify request %d result buffer", i);
+        found |= (1 << i);
+    }
+    SDLTest_AssertCheck(found == 0x7, "Verify all polled requests returned results, got 0x%x", found);
+    SDLTest_AssertCheck(SDL_strcmp(buffers[0], "CDEF") == 0, "Verify file read, expected CDEF, got %s", buffers[0]);
+    SDLTest_AssertCheck(SDL_strcmp(buffers[1], "KLMN") == 0, "Verify memory read, expected KLMN, got %s", buffers[1]);
+    SDLTest_AssertCheck(SDL_strcmp(buffers[2], "YZ") == 0, "Verify short stream read at the end, expected YZ, got %s", buffers[2]);
+    SDLTest_AssertCheck(SDL_AtomicGet(&asyncCallbacks) == 1, "Verify callback was called for the last request");
+#ifndef __WIN32__ /* Positional reads move the file pointer on Windows */
+    SDLTest_AssertCheck(SDL_RWtell(file) == 0, "Verify file position wasn't changed by asynchronous reads");
+#endif
+    SDLTest_AssertCheck(!SDL_GetAsyncIOResult(queue, &result), "Verify no results are left");
+
+    SDL_DestroyAsyncIOQueue(queue);
+    SDL_RWclose(stream);
+    SDL_RWclose(mem);
+    SDL_RWclose(file);
+
+    return TEST_COMPLETED;
+}
+
+static SDL_RWops *asyncStreams[2];
+static SDL_Semaphore *asyncStreamReads[2];
+static SDL_AtomicInt asyncStreamOverlaps;
+static size_t (SDLCALL *asyncStreamRead)(SDL_RWops *context, void *ptr, size_t size);
+
+/* Each stream's read waits for a read from the other stream to start */
+static size_t SDLCALL AsyncBlockingRead(SDL_RWops *context, void *ptr, size_t size)
+{
+    const int i = (context == asyncStreams[0]) ? 0 : 1;
+
+    SDL_PostSemaphore(asyncStreamReads[i]);
+    if (SDL_WaitSemaphoreTimeout(asyncStreamReads[!i], 5000) == 0) {
+        SDL_AtomicIncRef(&asyncStreamOverlaps);
+    }
+    return asyncStreamRead(context, ptr, size);
+}
+
+/**
+ * Tests that asynchronous reads from different generic streams run at the same time.
+ *
+ * \sa SDL_ReadAsync
+ * \sa SDL_WaitAsyncIOResult
+ */
+static int rwops_testAsyncReadStreams(void *arg)
+{
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOResult result;
+    char buffers[2][8];
+    int i, found;
+
+    queue = SDL_CreateAsyncIOQueue(2);
+    SDLTest_AssertCheck(queue != NULL, "Verify SDL_CreateAsyncIOQueue() does not return NULL");
+    if (queue == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < 2; ++i) {
+        asyncStreams[i] = SDL_RWFromConstMem(RWopsAlphabetString, sizeof(RWopsAlphabetString) - 1);
+        asyncStreamReads[i] = SDL_CreateSemaphore(0);
+        SDLTest_AssertCheck(asyncStreams[i] && asyncStreamReads[i], "Verify stream %d was created", i);
+        if (!asyncStreams[i] || !asyncStreamReads[i]) {
+            return TEST_ABORTED;
+        }
+        asyncStreamRead = asyncStreams[i]->read;
+        asyncStreams[i]->read = AsyncBlockingRead;
+        asyncStreams[i]->type = SDL_RWOPS_UNKNOWN; /* Read through SDL_RWseek() and SDL_RWread() */
+    }
+
+    SDL_zeroa(buffers);
+    SDL_AtomicSet(&asyncStreamOverlaps, 0);
+    for (i = 0; i < 2; ++i) {
+        int result_code = SDL_ReadAsync(queue, asyncStreams[i], 4 * i, buffers[i], 4, NULL, (void *)(intptr_t)i);
+        SDLTest_AssertCheck(result_code == 0, "Verify SDL_ReadAsync() from stream %d, expected 0, got %d", i, result_code);
+    }
+
+    found = 0;
+    while (SDL_WaitAsyncIOResult(queue, &result, -1)) {
+        i = (int)(intptr_t)result.userdata;
+        SDLTest_AssertCheck(result.status == SDL_ASYNCIO_COMPLETE, "Verify request %d completed", i);
+        found |= (1 << i);
+    }
+    SDLTest_AssertCheck(found == 0x3, "Verify both requests returned results, got 0x%x", found);
+    SDLTest_AssertCheck(SDL_AtomicGet(&asyncStreamOverlaps) == 2, "Verify both reads ran while the other was blocked, got %d", SDL_AtomicGet(&asyncStreamOverlaps));
+    SDLTest_AssertCheck(SDL_strcmp(buffers[0], "ABCD") == 0, "Verify first stream read, expected ABCD, got %s", buffers[0]);
+    SDLTest_AssertCheck(SDL_strcmp(buffers[1], "EFGH") == 0, "Verify second stream read, expected EFGH, got %s", buffers[1]);
+
+    SDL_DestroyAsyncIOQueue(queue);
+    for (i = 0; i < 2; ++i) {
+        SDL_RWclose(asyncStreams[i]);
+        SDL_DestroySemaphore(asyncStreamReads[i]);
+        asyncStreams[i] = NULL;
+        asyncStreamReads[i] = NULL;
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests vectored reads and writes on files and memory streams.
+ *
+ * \sa SDL_RWreadv
+ * \sa SDL_RWwritev
+ */
+static int rwops_testVectoredIO(void *arg)
+{
+    const size_t payload_size = 100 * 1024; /* Large enough for the native path */
+    char header[] = "SDLVECIO";
+    char header_in[sizeof(header)];
+    Uint8 *payload, *payload_in;
+    SDL_RWvec vec[2];
+    SDL_RWops *rw;
+    char mem[16];
+    size_t i, s;
+    Sint64 pos;
+
+    payload = (Uint8 *)SDL_malloc(payload_size);
+    payload_in = (Uint8 *)SDL_malloc(payload_size);
+    SDLTest_AssertCheck(payload && payload_in, "Verify buffers were allocated");
+    if (!payload || !payload_in) {
+        SDL_free(payload);
+        SDL_free(payload_in);
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < payload_size; ++i) {
+        payload[i] = (Uint8)(i * 7);
+    }
+
+    rw = SDL_RWFromFile(RWopsWriteTestFilename, "w+b");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFile in write mode does not return NULL");
+    if (rw != NULL) {
+        vec[0].data = header;
+        vec[0].size = sizeof(header);
+        vec[1].data = payload;
+        vec[1].size = payload_size;
+        s = SDL_RWwritev(rw, vec, SDL_arraysize(vec));
+        SDLTest_AssertCheck(s == sizeof(header) + payload_size, "Verify SDL_RWwritev() wrote everything, expected %d, got %d", (int)(sizeof(header) + payload_size), (int)s);
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == (Sint64)s, "Verify position after SDL_RWwritev(), expected %d, got %d", (int)s, (int)pos);
+
+        pos = SDL_RWseek(rw, 0, SDL_RW_SEEK_SET);
+        SDLTest_AssertCheck(pos == 0, "Verify seek to start, expected 0, got %d", (int)pos);
+        SDL_memset(payload_in, 0, payload_size);
+        vec[0].data = header_in;
+        vec[1].data = payload_in;
+        s = SDL_RWreadv(rw, vec, SDL_arraysize(vec));
+        SDLTest_AssertCheck(s == sizeof(header) + payload_size, "Verify SDL_RWreadv() read everything, expected %d, got %d", (int)(sizeof(header) + payload_size), (int)s);
+        SDLTest_AssertCheck(SDL_memcmp(header, header_in, sizeof(header)) == 0, "Verify header was read back");
+        SDLTest_AssertCheck(SDL_memcmp(payload, payload_in, payload_size) == 0, "Verify payload was read back");
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == (Sint64)s, "Verify position after SDL_RWreadv(), expected %d, got %d", (int)s, (int)pos);
+
+        s = SDL_RWreadv(rw, vec, SDL_arraysize(vec));
+        SDLTest_AssertCheck(s == 0, "Verify SDL_RWreadv() at end of file, expected 0, got %d", (int)s);
+        SDLTest_AssertCheck(rw->status == SDL_RWOPS_STATUS_EOF, "Verify end of file status");
+        SDL_DestroyRW(rw);
+    }
+
+    /* Memory streams have no vectored methods and use plain reads and writes */
+    rw = SDL_RWFromMem(mem, sizeof(mem));
+    SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_RWFromMem does not return NULL");
+    if (rw != NULL) {
+        vec[0].data = header;
+        vec[0].size = 4;
+        vec[1].data = payload;
+        vec[1].size = 4;
+        s = SDL_RWwritev(rw, vec, SDL_arraysize(vec));
+        SDLTest_AssertCheck(s == 8, "Verify SDL_RWwritev() on memory, expected 8, got %d", (int)s);
+        SDLTest_AssertCheck(SDL_memcmp(mem, header, 4) == 0 && SDL_memcmp(mem + 4, payload, 4) == 0, "Verify memory contents");
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == 8, "Verify position after SDL_RWwritev(), expected 8, got %d", (int)pos);
+
+        SDL_RWseek(rw, 2, SDL_RW_SEEK_SET);
+        vec[0].data = header_in;
+        vec[0].size = 2;
+        vec[1].data = payload_in;
+        vec[1].size = 4;
+        s = SDL_RWreadv(rw, vec, SDL_arraysize(vec));
+        SDLTest_AssertCheck(s == 6, "Verify SDL_RWreadv() on memory, expected 6, got %d", (int)s);
+        SDLTest_AssertCheck(SDL_memcmp(header_in, header + 2, 2) == 0 && SDL_memcmp(payload_in, payload, 4) == 0, "Verify data read back");
+
+        s = SDL_RWreadv(rw, NULL, 1);
+        SDLTest_AssertCheck(s == 0, "Verify SDL_RWreadv() with NULL buffers, expected 0, got %d", (int)s);
+        SDL_DestroyRW(rw);
+    }
+
+    SDL_free(payload);
+    SDL_free(payload_in);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* RWops test cases */
@@ -670,10 +1120,35 @@ static const SDLTest_TestCaseReference rwopsTest8 = {
     (SDLTest_TestCaseFp)rwops_testCompareRWFromMemWithRWFromFile, "rwops_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile RWops for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference rwopsTest9 = {
+    (SDLTest_TestCaseFp)rwops_testBufferedRead, "rwops_testBufferedRead", "Tests reading through a read-ahead buffer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest10 = {
+    (SDLTest_TestCaseFp)rwops_testFileMapped, "rwops_testFileMapped", "Tests reading from a memory-mapped file", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest11 = {
+    (SDLTest_TestCaseFp)rwops_testLoadFile, "rwops_testLoadFile", "Tests loading whole streams", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest12 = {
+    (SDLTest_TestCaseFp)rwops_testAsyncRead, "rwops_testAsyncRead", "Tests asynchronous reads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest13 = {
+    (SDLTest_TestCaseFp)rwops_testVectoredIO, "rwops_testVectoredIO", "Tests vectored reads and writes", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest14 = {
+    (SDLTest_TestCaseFp)rwops_testAsyncReadStreams, "rwops_testAsyncReadStreams", "Tests asynchronous reads from different streams at the same time", TEST_ENABLED
+};
+
 /* Sequence of RWops test cases */
 static const SDLTest_TestCaseReference *rwopsTests[] = {
     &rwopsTest1, &rwopsTest2, &rwopsTest3, &rwopsTest4, &rwopsTest5, &rwopsTest6,
-    &rwopsTest7, &rwopsTest8, NULL
+    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, &rwopsTest11,
+    &rwopsTest12, &rwopsTest13, &rwopsTest14, NULL
 };
 
 /* RWops test suite (global) */
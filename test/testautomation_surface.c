@@ -781,6 +781,363 @@ static int surface_testOverflow(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests that RLE encoded colorkey surfaces blit like unencoded ones,
+ * after partial modification and when scaled.
+ */
+static int surface_testBlitRLE(void *arg)
+{
+    const int w = 64, h = 48;
+    SDL_Surface *plain, *rle, *dst, *ref;
+    SDL_Rect rect, srcrect, dstrect;
+    Uint32 colorkey;
+    int x, y, ret;
+
+    plain = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+    rle = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+    dst = SDL_CreateSurface(w * 2, h * 2, SDL_PIXELFORMAT_XRGB8888);
+    ref = SDL_CreateSurface(w * 2, h * 2, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(plain && rle && dst && ref, "Verify surfaces are not NULL");
+    if (!plain || !rle || !dst || !ref) {
+        goto done;
+    }
+
+    /* Checkerboard of transparent and opaque runs, with some blank lines */
+    colorkey = SDL_MapRGB(plain->format, 255, 0, 255);
+    for (y = 0; y < h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)plain->pixels + y * plain->pitch);
+        for (x = 0; x < w; ++x) {
+            if ((y % 7) == 3 || ((x / 5) + (y / 4)) % 2) {
+                row[x] = colorkey;
+            } else {
+                row[x] = SDL_MapRGB(plain->format, (Uint8)(x * 4), (Uint8)(y * 5), 128);
+            }
+        }
+    }
+    SDL_BlitSurface(plain, NULL, rle, NULL);
+    SDL_SetSurfaceColorKey(plain, SDL_TRUE, colorkey);
+    SDL_SetSurfaceColorKey(rle, SDL_TRUE, colorkey);
+    ret = SDL_SetSurfaceRLE(rle, 1);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SetSurfaceRLE, expected: 0, got: %i", ret);
+
+    /* Clipped blit */
+    srcrect.x = 3;
+    srcrect.y = 5;
+    srcrect.w = w - 10;
+    srcrect.h = h - 9;
+    SDL_FillSurfaceRect(dst, NULL, 0);
+    SDL_FillSurfaceRect(ref, NULL, 0);
+    dstrect.x = dstrect.y = 7;
+    ret = SDL_BlitSurface(rle, &srcrect, dst, &dstrect);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(SDL_SurfaceHasRLE(rle), "Verify surface is RLE encoded");
+    dstrect.x = dstrect.y = 7;
+    SDL_BlitSurface(plain, &srcrect, ref, &dstrect);
+    ret = SDLTest_CompareSurfaces(dst, ref, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate clipped RLE blit, expected: 0, got: %i", ret);
+
+    /* Modify a few lines of both surfaces */
+    rect.x = 10;
+    rect.y = 12;
+    rect.w = 20;
+    rect.h = 6;
+    SDL_FillSurfaceRect(plain, &rect, SDL_MapRGB(plain->format, 0, 255, 0));
+    SDL_LockSurface(rle);
+    SDL_FillSurfaceRect(rle, &rect, SDL_MapRGB(rle->format, 0, 255, 0));
+    SDL_UnlockSurface(rle);
+    SDL_FillSurfaceRect(dst, NULL, 0);
+    SDL_FillSurfaceRect(ref, NULL, 0);
+    SDL_BlitSurface(rle, NULL, dst, NULL);
+    SDL_BlitSurface(plain, NULL, ref, NULL);
+    ret = SDLTest_CompareSurfaces(dst, ref, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate RLE blit after partial update, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(rle->pixels == NULL, "Verify decoded pixels are released after unlocking");
+
+    /* Lock again, which decodes the updated surface */
+    rect.x = 40;
+    rect.y = 30;
+    SDL_FillSurfaceRect(plain, &rect, SDL_MapRGB(plain->format, 0, 0, 255));
+    SDL_LockSurface(rle);
+    SDL_FillSurfaceRect(rle, &rect, SDL_MapRGB(rle->format, 0, 0, 255));
+    SDL_UnlockSurface(rle);
+    SDL_FillSurfaceRect(dst, NULL, 0);
+    SDL_FillSurfaceRect(ref, NULL, 0);
+    SDL_BlitSurface(rle, NULL, dst, NULL);
+    SDL_BlitSurface(plain, NULL, ref, NULL);
+    ret = SDLTest_CompareSurfaces(dst, ref, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate RLE blit after a second update, expected: 0, got: %i", ret);
+
+    /* Scaled blit */
+    SDL_FillSurfaceRect(dst, NULL, 0);
+    SDL_FillSurfaceRect(ref, NULL, 0);
+    ret = SDL_BlitSurfaceScaled(rle, NULL, dst, NULL, SDL_SCALEMODE_NEAREST);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurfaceScaled, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck(SDL_SurfaceHasRLE(rle), "Verify surface is still RLE encoded");
+    SDL_BlitSurfaceScaled(plain, NULL, ref, NULL, SDL_SCALEMODE_NEAREST);
+    ret = SDLTest_CompareSurfaces(dst, ref, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate scaled RLE blit, expected: 0, got: %i", ret);
+
+done:
+    SDL_DestroySurface(plain);
+    SDL_DestroySurface(rle);
+    SDL_DestroySurface(dst);
+    SDL_DestroySurface(ref);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests filling overlapping rectangles in all pixel sizes, with and without
+ * merging them, against a reference filled one pixel at a time.
+ */
+static int surface_testFillRects(void *arg)
+{
+    static const Uint32 formats[] = {
+        SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XRGB8888
+    };
+    SDL_Rect rects[5];
+    int coalesce, f, i, x, y, ret;
+
+    rects[0].x = 1; rects[0].y = 2; rects[0].w = 250; rects[0].h = 10;
+    rects[1].x = 100; rects[1].y = 5; rects[1].w = 180; rects[1].h = 20;
+    rects[2].x = 251; rects[2].y = 2; rects[2].w = 7; rects[2].h = 3;
+    rects[3].x = 3; rects[3].y = 30; rects[3].w = 1; rects[3].h = 1;
+    rects[4].x = -10; rects[4].y = 35; rects[4].w = 400; rects[4].h = 10;
+
+    for (coalesce = 0; coalesce < 2; ++coalesce) {
+        SDL_SetHint(SDL_HINT_SURFACE_FILL_COALESCING, coalesce ? "1" : "0");
+        for (f = 0; f < SDL_arraysize(formats); ++f) {
+            SDL_Surface *surface = SDL_CreateSurface(300, 40, formats[f]);
+            SDL_Surface *reference = SDL_CreateSurface(300, 40, formats[f]);
+            Uint32 color;
+            int differences = 0;
+
+            SDLTest_AssertCheck(surface && reference, "Verify surfaces are not NULL");
+            if (!surface || !reference) {
+                SDL_DestroySurface(surface);
+                SDL_DestroySurface(reference);
+                continue;
+            }
+
+            color = SDL_MapRGB(surface->format, 0xa5, 0xc3, 0xe1);
+            SDL_FillSurfaceRect(surface, NULL, 0);
+            SDL_FillSurfaceRect(reference, NULL, 0);
+            ret = SDL_FillSurfaceRects(surface, rects, SDL_arraysize(rects), color);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_FillSurfaceRects, expected: 0, got: %i", ret);
+
+            for (y = 0; y < reference->h; ++y) {
+                for (x = 0; x < reference->w; ++x) {
+                    SDL_Point point;
+                    point.x = x;
+                    point.y = y;
+                    for (i = 0; i < SDL_arraysize(rects); ++i) {
+                        if (SDL_PointInRect(&point, &rects[i])) {
+                            SDL_Rect pixel;
+                            pixel.x = x;
+                            pixel.y = y;
+                            pixel.w = pixel.h = 1;
+                            SDL_FillSurfaceRect(reference, &pixel, color);
+                            break;
+                        }
+                    }
+                }
+            }
+            for (y = 0; y < reference->h; ++y) {
+                if (SDL_memcmp((Uint8 *)surface->pixels + y * surface->pitch,
+                               (Uint8 *)reference->pixels + y * reference->pitch,
+                               (size_t)reference->w * reference->format->BytesPerPixel) != 0) {
+                    ++differences;
+                }
+            }
+            SDLTest_AssertCheck(differences == 0, "Validate filled rows for %s (coalescing %s), expected: 0 differences, got: %i",
+                                SDL_GetPixelFormatName(formats[f]), coalesce ? "on" : "off", differences);
+
+            SDL_DestroySurface(surface);
+            SDL_DestroySurface(reference);
+        }
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_FILL_COALESCING);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests colorkey blits on the formats that have vectorized implementations
+ */
+static int surface_testBlitColorKey(void *arg)
+{
+    static const struct
+    {
+        Uint32 src_format;
+        Uint32 dst_format;
+    } cases[] = {
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_XRGB8888 }
+    };
+    const int w = 37, h = 5;
+    const Uint32 background = 0x5a5a5a5a;
+    int i, x, y;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        SDL_Surface *src = SDL_CreateSurface(w, h, cases[i].src_format);
+        SDL_Surface *dst = SDL_CreateSurface(w, h, cases[i].dst_format);
+        int srcbpp, dstbpp, ret, differences = 0;
+        Uint32 key;
+
+        SDLTest_AssertCheck(src && dst, "Verify surfaces are not NULL");
+        if (!src || !dst) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            continue;
+        }
+        srcbpp = src->format->BytesPerPixel;
+        dstbpp = dst->format->BytesPerPixel;
+
+        if (src->format->palette) {
+            SDL_Color colors[256];
+            for (x = 0; x < SDL_arraysize(colors); ++x) {
+                colors[x].r = (Uint8)x;
+                colors[x].g = (Uint8)(255 - x);
+                colors[x].b = (Uint8)(x * 3);
+                colors[x].a = SDL_ALPHA_OPAQUE;
+            }
+            SDL_SetPaletteColors(src->format->palette, colors, 0, SDL_arraysize(colors));
+            key = 7;
+        } else {
+            key = SDL_MapRGB(src->format, 0xff, 0x00, 0xff);
+        }
+
+        /* Every fifth pixel is transparent, with runs of both keyed and
+           unkeyed pixels and a ragged tail to exercise the scalar path */
+        for (y = 0; y < h; ++y) {
+            for (x = 0; x < w; ++x) {
+                Uint8 *p = (Uint8 *)src->pixels + y * src->pitch + x * srcbpp;
+                Uint32 pixel;
+                if (((x * 7 + y * 3) % 5) == 0 || (y == 2 && x < 16)) {
+                    /* Alpha is not part of the key comparison */
+                    pixel = (key & ~src->format->Amask) | (src->format->Amask & ((Uint32)x << 24));
+                } else {
+                    pixel = (Uint32)(x * 0x01030507 + y * 0x00112233);
+                    if (srcbpp == 1) {
+                        pixel &= 0xff;
+                    } else if (srcbpp == 2) {
+                        pixel &= 0xffff;
+                    }
+                    if ((pixel & ~src->format->Amask) == (key & ~src->format->Amask)) {
+                        pixel ^= 1;
+                    }
+                }
+                SDL_memcpy(p, &pixel, srcbpp);
+            }
+        }
+        SDL_memset(dst->pixels, background & 0xff, (size_t)dst->h * dst->pitch);
+
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetSurfaceColorKey(src, SDL_TRUE, key);
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+        for (y = 0; y < h; ++y) {
+            for (x = 0; x < w; ++x) {
+                Uint8 *s = (Uint8 *)src->pixels + y * src->pitch + x * srcbpp;
+                Uint8 *d = (Uint8 *)dst->pixels + y * dst->pitch + x * dstbpp;
+                Uint32 pixel = 0, expected = 0, actual = 0;
+
+                SDL_memcpy(&pixel, s, srcbpp);
+                SDL_memcpy(&actual, d, dstbpp);
+                if ((pixel & ~src->format->Amask) == (key & ~src->format->Amask)) {
+                    SDL_memcpy(&expected, &background, dstbpp);
+                } else if (src->format->palette) {
+                    const SDL_Color *c = &src->format->palette->colors[pixel];
+                    expected = SDL_MapRGB(dst->format, c->r, c->g, c->b);
+                } else if (dstbpp == 4 && !dst->format->Amask) {
+                    expected = pixel & (dst->format->Rmask | dst->format->Gmask | dst->format->Bmask);
+                } else if (!src->format->Amask && dst->format->Amask) {
+                    expected = pixel | dst->format->Amask;
+                } else {
+                    expected = pixel;
+                }
+                if (actual != expected) {
+                    ++differences;
+                }
+            }
+        }
+        SDLTest_AssertCheck(differences == 0, "Validate %s -> %s colorkey blit, expected: 0 differences, got: %i",
+                            SDL_GetPixelFormatName(cases[i].src_format), SDL_GetPixelFormatName(cases[i].dst_format), differences);
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that blits split across threads match blits done on a single thread
+ */
+static int surface_testBlitThreads(void *arg)
+{
+    static const SDL_BlendMode modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND };
+    const int w = 1000, h = 700;
+    SDL_Surface *src = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Surface *serial = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XBGR8888);
+    SDL_Surface *parallel = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XBGR8888);
+    SDL_Rect dstrect;
+    int i, x, y, ret;
+
+    SDLTest_AssertCheck(src && serial && parallel, "Verify surfaces are not NULL");
+    if (!src || !serial || !parallel) {
+        goto out;
+    }
+
+    for (y = 0; y < h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+        for (x = 0; x < w; ++x) {
+            row[x] = (Uint32)(x * 0x01030507 + y * 0x00112233);
+        }
+    }
+    dstrect.x = 3;
+    dstrect.y = 5;
+    dstrect.w = w;
+    dstrect.h = h;
+
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        int differences = 0;
+
+        SDL_SetSurfaceBlendMode(src, modes[i]);
+        SDL_FillSurfaceRect(serial, NULL, SDL_MapRGB(serial->format, 0x10, 0x80, 0xf0));
+        SDL_FillSurfaceRect(parallel, NULL, SDL_MapRGB(parallel->format, 0x10, 0x80, 0xf0));
+
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "1");
+        ret = SDL_BlitSurface(src, NULL, serial, &dstrect);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "4");
+        ret = SDL_BlitSurface(src, NULL, parallel, &dstrect);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+        for (y = 0; y < h; ++y) {
+            if (SDL_memcmp((Uint8 *)serial->pixels + y * serial->pitch,
+                           (Uint8 *)parallel->pixels + y * parallel->pitch,
+                           (size_t)w * 4) != 0) {
+                ++differences;
+            }
+        }
+        SDLTest_AssertCheck(differences == 0, "Validate threaded blit with blend mode %d, expected: 0 differences, got: %i", modes[i], differences);
+    }
+
+out:
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(serial);
+    SDL_DestroySurface(parallel);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -835,6 +1192,22 @@ static const SDLTest_TestCaseReference surfaceTest12 = {
     (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestBlitRLE = {
+    surface_testBlitRLE, "surface_testBlitRLE", "Tests blitting RLE encoded colorkey surfaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestFillRects = {
+    surface_testFillRects, "surface_testFillRects", "Tests filling overlapping rectangles.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitColorKey = {
+    surface_testBlitColorKey, "surface_testBlitColorKey", "Tests colorkey blitting.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitThreads = {
+    surface_testBlitThreads, "surface_testBlitThreads", "Tests blitting on multiple threads.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestOverflow = {
     surface_testOverflow, "surface_testOverflow", "Test overflow detection.", TEST_ENABLED
 };
@@ -843,7 +1216,7 @@ static const SDLTest_TestCaseReference surfaceTestOverflow = {
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTestBlitRLE, &surfaceTestFillRects, &surfaceTestBlitColorKey, &surfaceTestBlitThreads, &surfaceTestOverflow, NULL
 };
 
 /* Surface test suite (global) */
@@ -168,6 +168,191 @@ static int timer_addRemoveTimer(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Test callback recording the order in which timers fire */
+static SDL_AtomicInt g_timerOrderCount;
+
+static Uint32 SDLCALL timerOrderCallback(Uint32 interval, void *param)
+{
+    int *order = (int *)param;
+
+    *order = SDL_AtomicAdd(&g_timerOrderCount, 1);
+    return 0;
+}
+
+/**
+ * Call to SDL_AddTimer and SDL_RemoveTimer with many timers
+ */
+static int timer_addRemoveManyTimers(void *arg)
+{
+    SDL_TimerID ids[1000];
+    int order[5];
+    SDL_bool result;
+    int i, removed = 0;
+
+    SDL_AtomicSet(&g_timerOrderCount, 0);
+
+    /* Set lots of timers with long delays */
+    for (i = 0; i < SDL_arraysize(ids); ++i) {
+        ids[i] = SDL_AddTimer(10000 + SDLTest_RandomIntegerInRange(0, 10000), timerTestCallback, NULL);
+        if (!ids[i]) {
+            SDLTest_LogError("SDL_AddTimer() failed: %s", SDL_GetError());
+        }
+    }
+    SDLTest_AssertPass("Call to SDL_AddTimer() %d times", (int)SDL_arraysize(ids));
+
+    /* Set a few short timers in reverse order of expiration */
+    for (i = SDL_arraysize(order) - 1; i >= 0; --i) {
+        order[i] = -1;
+        SDLTest_AssertCheck(SDL_AddTimer(10 + i * 20, timerOrderCallback, &order[i]) > 0, "Check result of SDL_AddTimer(%d, ...)", 10 + i * 20);
+    }
+
+    /* Remove every other long timer while the short ones are pending */
+    for (i = 0; i < SDL_arraysize(ids); i += 2) {
+        if (SDL_RemoveTimer(ids[i])) {
+            ++removed;
+        }
+    }
+
+    /* Wait to let the short timers trigger */
+    SDL_Delay(300);
+    SDLTest_AssertPass("Call to SDL_Delay(300)");
+
+    for (i = 0; i < SDL_arraysize(order); ++i) {
+        SDLTest_AssertCheck(order[i] == i, "Check timer %d fired in order, expected: %d, got: %d", i, i, order[i]);
+    }
+
+    /* Remove the remaining long timers */
+    for (i = 1; i < SDL_arraysize(ids); i += 2) {
+        if (SDL_RemoveTimer(ids[i])) {
+            ++removed;
+        }
+    }
+    SDLTest_AssertCheck(removed == SDL_arraysize(ids), "Check all timers were removed, expected: %d, got: %d", (int)SDL_arraysize(ids), removed);
+
+    /* Removing them again should be a NOOP */
+    result = SDL_RemoveTimer(ids[0]);
+    SDLTest_AssertCheck(result == SDL_FALSE, "Check result value, expected: %i, got: %i", SDL_FALSE, result);
+
+    return TEST_COMPLETED;
+}
+
+/* Test callback counting fixed rate nanosecond timer iterations */
+static SDL_TimerID g_timerNSID;
+static SDL_AtomicInt g_timerNSCount;
+static SDL_AtomicInt g_timerNSBadID;
+
+static Uint64 SDLCALL timerTestCallbackNS(void *userdata, SDL_TimerID timerID, Uint64 interval)
+{
+    if (timerID != g_timerNSID || *(int *)userdata != g_paramValue) {
+        SDL_AtomicSet(&g_timerNSBadID, 1);
+    }
+    SDL_AtomicAdd(&g_timerNSCount, 1);
+    return interval;
+}
+
+/**
+ * Call to SDL_AddTimerNS and SDL_RemoveTimer
+ */
+static int timer_addRemoveTimerNS(void *arg)
+{
+    const Uint64 interval = SDL_US_TO_NS(2500);
+    Uint64 start, elapsed;
+    SDL_bool result;
+    int count, maximum;
+    int param = SDLTest_RandomIntegerInRange(-1024, 1024);
+
+    g_paramValue = param;
+    SDL_AtomicSet(&g_timerNSCount, 0);
+    SDL_AtomicSet(&g_timerNSBadID, 0);
+
+    /* Invalid callback */
+    g_timerNSID = SDL_AddTimerNS(interval, NULL, NULL);
+    SDLTest_AssertPass("Call to SDL_AddTimerNS(interval, NULL, NULL)");
+    SDLTest_AssertCheck(g_timerNSID == 0, "Check result value, expected: 0, got: %d", g_timerNSID);
+
+    /* Run a 400 Hz timer for a while */
+    start = SDL_GetTicksNS();
+    g_timerNSID = SDL_AddTimerNS(interval, timerTestCallbackNS, &param);
+    SDLTest_AssertPass("Call to SDL_AddTimerNS(%" SDL_PRIu64 ", ...)", interval);
+    SDLTest_AssertCheck(g_timerNSID > 0, "Check result value, expected: >0, got: %d", g_timerNSID);
+
+    SDL_Delay(250);
+    result = SDL_RemoveTimer(g_timerNSID);
+    elapsed = SDL_GetTicksNS() - start;
+    SDLTest_AssertPass("Call to SDL_RemoveTimer()");
+    SDLTest_AssertCheck(result == SDL_TRUE, "Check result value, expected: %i, got: %i", SDL_TRUE, result);
+
+    /* Rescheduling is relative to the due time, so the timer can't run more often than requested */
+    count = SDL_AtomicGet(&g_timerNSCount);
+    maximum = (int)(elapsed / interval);
+    SDLTest_AssertCheck(count > 0 && count <= maximum, "Check callback count, expected: 1-%d, got: %d", maximum, count);
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_timerNSBadID) == 0, "Check callback parameters were correct");
+
+    return TEST_COMPLETED;
+}
+
+static SDL_AtomicInt g_timerSlackCount;
+static SDL_AtomicInt g_timerSlackBurst;
+static int g_timerSlackRun;
+static Uint64 g_timerSlackLast;
+
+static Uint64 SDLCALL timerTestCallbackSlack(void *userdata, SDL_TimerID timerID, Uint64 interval)
+{
+    const Uint64 now = SDL_GetTicksNS();
+
+    /* A timer that wakes up late catches up once, but a run of calls right
+       after each other means it fired several times in one wakeup */
+    if (g_timerSlackLast && (now - g_timerSlackLast) < (interval / 4)) {
+        ++g_timerSlackRun;
+        if (g_timerSlackRun > SDL_AtomicGet(&g_timerSlackBurst)) {
+            SDL_AtomicSet(&g_timerSlackBurst, g_timerSlackRun);
+        }
+    } else {
+        g_timerSlackRun = 0;
+    }
+    g_timerSlackLast = now;
+    SDL_AtomicAdd(&g_timerSlackCount, 1);
+    return interval;
+}
+
+/**
+ * Call to SDL_AddTimerNS with timer slack larger than the interval
+ */
+static int timer_slackLargerThanInterval(void *arg)
+{
+    const Uint64 interval = SDL_MS_TO_NS(2);
+    const char *old_slack = SDL_GetHint(SDL_HINT_TIMER_SLACK);
+    char *saved_slack = old_slack ? SDL_strdup(old_slack) : NULL;
+    SDL_TimerID id;
+    int count;
+
+    g_timerSlackLast = 0;
+    g_timerSlackRun = 0;
+    SDL_AtomicSet(&g_timerSlackCount, 0);
+    SDL_AtomicSet(&g_timerSlackBurst, 0);
+
+    /* Timers may fire up to 20 ms early, ten times their interval */
+    SDL_SetHint(SDL_HINT_TIMER_SLACK, "20000");
+    SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_TIMER_SLACK, \"20000\")");
+
+    id = SDL_AddTimerNS(interval, timerTestCallbackSlack, NULL);
+    SDLTest_AssertPass("Call to SDL_AddTimerNS(%" SDL_PRIu64 ", ...)", interval);
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %d", id);
+
+    SDL_Delay(200);
+    SDL_RemoveTimer(id);
+    SDLTest_AssertPass("Call to SDL_RemoveTimer()");
+
+    SDL_SetHint(SDL_HINT_TIMER_SLACK, saved_slack);
+    SDL_free(saved_slack);
+
+    count = SDL_AtomicGet(&g_timerSlackCount);
+    SDLTest_AssertCheck(count > 0, "Check callback count, expected: >0, got: %d", count);
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_timerSlackBurst) <= 1, "Check timer didn't fire repeatedly in one wakeup, expected: <=1 extra calls in a row, got: %d", SDL_AtomicGet(&g_timerSlackBurst));
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -187,9 +372,21 @@ static const SDLTest_TestCaseReference timerTest4 = {
     (SDLTest_TestCaseFp)timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference timerTest5 = {
+    (SDLTest_TestCaseFp)timer_addRemoveManyTimers, "timer_addRemoveManyTimers", "Call to SDL_AddTimer and SDL_RemoveTimer with many timers", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest6 = {
+    (SDLTest_TestCaseFp)timer_addRemoveTimerNS, "timer_addRemoveTimerNS", "Call to SDL_AddTimerNS and SDL_RemoveTimer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest7 = {
+    (SDLTest_TestCaseFp)timer_slackLargerThanInterval, "timer_slackLargerThanInterval", "Call to SDL_AddTimerNS with timer slack larger than the interval", TEST_ENABLED
+};
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] = {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, &timerTest7, NULL
 };
 
 /* Timer test suite (global) */